@@ -23,32 +23,118 @@
     OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
     SOFTWARE.
 
-    Single-header macro helpers for creating and freeing strongly typed 2D
-    arrays backed by one contiguous allocation plus row pointers.
+    Single-header macro helpers for creating and freeing strongly typed 2D,
+    3D and N-dimensional arrays, each backed by a single allocation, and 2D
+    arrays stored in tiled or Morton (Z-order) layouts.
 
     USAGE
     Include this header wherever the declarations are needed. In exactly one
     translation unit, use shlDeclareCreateArray(prefix, itemType) and
     shlDefineCreateArray(prefix, itemType) to generate the creator, and pair
     shlDeclareFreeArray(prefix, itemType) with shlDefineFreeArray(prefix,
-    itemType) if you also want the matching free helper.
+    itemType) if you also want the matching free helper. The 3D and ND
+    variants follow the same pattern with the CreateArray3D/FreeArray3D and
+    CreateArrayND/FreeArrayND macros. The tiled and Morton arrays are
+    generated with shlDeclareTiledArray/shlDefineTiledArray and
+    shlDeclareMortonArray/shlDefineMortonArray, and their elements are reached
+    with the shlTiledArrayAt and shlMortonArrayAt accessor macros. Bulk
+    operations over CreateArray grids (fill, copy, blit, map and reduce) are
+    generated with shlDeclareArrayOps/shlDefineArrayOps, and the parallel row
+    iteration with shlDeclareParallelForRows/shlDefineParallelForRows.
 
     CUSTOMISATION
-    Choose a unique prefix and the element type you want stored. The generated
-    array uses one contiguous allocation for values plus a separate row-pointer
-    table, so row access stays simple while the data remains cache-friendly.
+    Choose a unique prefix and the element type you want stored. Define
+    SHL_ARRAY_ALIGNMENT (a power of two) before including this header to
+    change the alignment of the data, SHL_ARRAY_MAX_RANK to change the
+    maximum number of dimensions of the ND arrays and
+    SHL_ARRAY_DEFAULT_TILE_SIZE to change the tile size used when none is
+    given. Define SHL_ARRAY_NO_SIMD to turn off the SSE2/AVX2 paths of the
+    bulk operations, and SHL_ARRAY_NO_THREADS to build the thread pool without
+    pthreads (it always is on Windows); the pool then runs every band on the
+    calling thread.
 
     NOTES
-    CreateArray allocates both the backing values block and the row table.
-    FreeArray expects the pointer returned by CreateArray and releases both
-    allocations.
+    CreateArray and CreateArray3D place the pointer tables at the start of
+    the block and the zeroed values after them, aligned to
+    SHL_ARRAY_ALIGNMENT bytes, so rows stay contiguous and the data can be
+    walked linearly from arr[0] (or arr[0][0]). The ND arrays don't have
+    pointer tables; they keep their dimensions and strides instead, and pad
+    every row to a multiple of the alignment when the element size allows
+    it. Sizes are computed in size_t and the creators return NULL (or false)
+    when they would overflow. FreeArray expects the pointer returned by
+    CreateArray and releases the whole block.
+
+    The tiled arrays store square tiles (a power of two on each side) one
+    after the other and the Morton arrays interleave the bits of the row and
+    column, so the cells around a cell are close in memory in both
+    directions. Their accessors compute the offset on every call; loops that
+    walk a tile, or step between Morton neighbours with the Next/Prev macros,
+    avoid most of that work. Use the FromRowMajor/ToRowMajor functions to
+    convert from and to the row-major layout of CreateArray.
+
+    The bulk operations work on the contiguous values of the grid, or on
+    contiguous row segments for regions, instead of going through the row
+    pointers cell by cell. Fill and Blit use AVX2 when the compiler targets
+    it, SSE2 otherwise, and plain copies when SIMD is turned off. Blit
+    compares items byte by byte, so padding bytes of struct items take part
+    in the comparison with the key.
+
+    ParallelForRows splits the rows of a grid into one contiguous band per
+    thread of a shlArrayPool, and the calling thread runs the first band.
+    With a back buffer the callback reads the current grid and writes the
+    back one, then the two are swapped, so a band can read the halo rows of
+    its neighbours while they are being updated. Without a back buffer the
+    callback updates its rows in place and must not read any other row.
 */
 
 #ifndef SHL_ARRAY_H
 #define SHL_ARRAY_H
 
-#include <stdint.h>
-#include <stdlib.h>
+#include "shl_internal.h"
+
+#ifndef SHL_ARRAY_ALIGNMENT
+#define SHL_ARRAY_ALIGNMENT 64
+#endif
+
+#ifndef SHL_ARRAY_MAX_RANK
+#define SHL_ARRAY_MAX_RANK 8
+#endif
+
+#if !defined(SHL_ARRAY_NO_SIMD) && defined(__AVX2__)
+#define SHL__ARRAY_AVX2
+#include <immintrin.h>
+#elif !defined(SHL_ARRAY_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define SHL__ARRAY_SSE2
+#include <emmintrin.h>
+#endif
+
+#if !defined(SHL_ARRAY_NO_THREADS) && !defined(_WIN32)
+#define SHL__ARRAY_THREADS
+#include <pthread.h>
+#endif
+
+static inline bool shl__arrayMultiply(size_t a, size_t b, size_t* result)
+{
+    if (b != 0 && a > SIZE_MAX / b)
+        return false;
+
+    *result = a * b;
+    return true;
+}
+
+static inline void* shl__arrayAllocate(size_t tableSize, size_t dataSize, void** data)
+{
+    if (tableSize > SIZE_MAX - SHL_ARRAY_ALIGNMENT || dataSize > SIZE_MAX - SHL_ARRAY_ALIGNMENT - tableSize)
+        return NULL;
+
+    char* block = (char*)SHL_CALLOC(1, tableSize + dataSize + SHL_ARRAY_ALIGNMENT - 1);
+    if (!block)
+        return NULL;
+
+    uintptr_t padding = (uintptr_t)0 - (uintptr_t)(block + tableSize);
+    *data = block + tableSize + (padding & (SHL_ARRAY_ALIGNMENT - 1));
+    return block;
+}
 
 #define shlDeclareCreateArray(prefix, itemType) \
     itemType** prefix ## CreateArray(int32_t n, int32_t m);
@@ -56,11 +142,23 @@
 #define shlDefineCreateArray(prefix, itemType) \
     itemType** prefix ## CreateArray(int32_t n, int32_t m) \
     { \
-        itemType* values = (itemType*)calloc(m * n, sizeof(itemType)); \
-        itemType** rows = (itemType**)malloc(n * sizeof(itemType*)); \
-        for (int i = 0; i < n; ++i) \
+        size_t count, tableSize, dataSize; \
+        void* data; \
+        \
+        if (n < 0 || m < 0 || \
+            !shl__arrayMultiply((size_t)n, (size_t)m, &count) || \
+            !shl__arrayMultiply((size_t)n, sizeof(itemType*), &tableSize) || \
+            !shl__arrayMultiply(count, sizeof(itemType), &dataSize)) \
+            return NULL; \
+        \
+        itemType** rows = (itemType**)shl__arrayAllocate(tableSize, dataSize, &data); \
+        if (!rows) \
+            return NULL; \
+        \
+        itemType* values = (itemType*)data; \
+        for (int32_t i = 0; i < n; ++i) \
         { \
-            rows[i] = values + i * m; \
+            rows[i] = values + (size_t)i * (size_t)m; \
         } \
         return rows; \
     }
@@ -71,8 +169,840 @@
 #define shlDefineFreeArray(prefix, itemType) \
     void prefix ## FreeArray(itemType** arr) \
     { \
-        free(*arr); \
-        free(arr); \
+        SHL_FREE(arr); \
+    }
+
+#define shlDeclareCreateArray3D(prefix, itemType) \
+    itemType*** prefix ## CreateArray3D(int32_t n, int32_t m, int32_t p);
+
+#define shlDefineCreateArray3D(prefix, itemType) \
+    itemType*** prefix ## CreateArray3D(int32_t n, int32_t m, int32_t p) \
+    { \
+        size_t rowCount, count, tableSize, dataSize; \
+        void* data; \
+        \
+        if (n < 0 || m < 0 || p < 0 || \
+            !shl__arrayMultiply((size_t)n, (size_t)m, &rowCount) || \
+            !shl__arrayMultiply(rowCount, (size_t)p, &count) || \
+            !shl__arrayMultiply((size_t)n, (size_t)m + 1, &tableSize) || \
+            !shl__arrayMultiply(tableSize, sizeof(itemType*), &tableSize) || \
+            !shl__arrayMultiply(count, sizeof(itemType), &dataSize)) \
+            return NULL; \
+        \
+        itemType*** planes = (itemType***)shl__arrayAllocate(tableSize, dataSize, &data); \
+        if (!planes) \
+            return NULL; \
+        \
+        itemType** rows = (itemType**)(planes + n); \
+        itemType* values = (itemType*)data; \
+        for (size_t i = 0; i < rowCount; ++i) \
+        { \
+            rows[i] = values + i * (size_t)p; \
+        } \
+        for (int32_t i = 0; i < n; ++i) \
+        { \
+            planes[i] = rows + (size_t)i * (size_t)m; \
+        } \
+        return planes; \
+    }
+
+#define shlDeclareFreeArray3D(prefix, itemType) \
+    void prefix ## FreeArray3D(itemType*** arr);
+
+#define shlDefineFreeArray3D(prefix, itemType) \
+    void prefix ## FreeArray3D(itemType*** arr) \
+    { \
+        SHL_FREE(arr); \
+    }
+
+#define shlDeclareCreateArrayND(prefix, itemType) \
+    typedef struct \
+    { \
+        int32_t rank; \
+        int32_t dims[SHL_ARRAY_MAX_RANK]; \
+        size_t strides[SHL_ARRAY_MAX_RANK]; \
+        size_t count; \
+        itemType* values; \
+    } prefix ## ArrayND; \
+    \
+    bool prefix ## CreateArrayND(prefix ## ArrayND* arr, int32_t rank, const int32_t dims[]); \
+    size_t prefix ## ArrayNDOffset(const prefix ## ArrayND* arr, const int32_t indices[]); \
+    itemType* prefix ## ArrayNDAt(const prefix ## ArrayND* arr, const int32_t indices[]);
+
+#define shlDefineCreateArrayND(prefix, itemType) \
+    bool prefix ## CreateArrayND(prefix ## ArrayND* arr, int32_t rank, const int32_t dims[]) \
+    { \
+        void* data; \
+        size_t dataSize; \
+        \
+        arr->rank = 0; \
+        arr->count = 0; \
+        arr->values = NULL; \
+        \
+        if (rank < 1 || rank > SHL_ARRAY_MAX_RANK) \
+            return false; \
+        \
+        for (int32_t i = 0; i < rank; i++) \
+        { \
+            if (dims[i] < 0) \
+                return false; \
+        } \
+        \
+        size_t pitch = (size_t)dims[rank - 1]; \
+        if (rank > 1 && sizeof(itemType) <= SHL_ARRAY_ALIGNMENT && SHL_ARRAY_ALIGNMENT % sizeof(itemType) == 0) \
+        { \
+            size_t rowAlignment = SHL_ARRAY_ALIGNMENT / sizeof(itemType); \
+            pitch = (pitch + rowAlignment - 1) & ~(rowAlignment - 1); \
+        } \
+        \
+        arr->strides[rank - 1] = 1; \
+        if (rank > 1) \
+            arr->strides[rank - 2] = pitch; \
+        \
+        for (int32_t i = rank - 3; i >= 0; i--) \
+        { \
+            if (!shl__arrayMultiply(arr->strides[i + 1], (size_t)dims[i + 1], &arr->strides[i])) \
+                return false; \
+        } \
+        \
+        if (!shl__arrayMultiply(arr->strides[0], (size_t)dims[0], &arr->count) || \
+            !shl__arrayMultiply(arr->count, sizeof(itemType), &dataSize)) \
+        { \
+            arr->count = 0; \
+            return false; \
+        } \
+        \
+        void* block = shl__arrayAllocate(sizeof(void*), dataSize, &data); \
+        if (!block) \
+        { \
+            arr->count = 0; \
+            return false; \
+        } \
+        \
+        ((void**)data)[-1] = block; \
+        arr->rank = rank; \
+        arr->values = (itemType*)data; \
+        memcpy(arr->dims, dims, (size_t)rank * sizeof(int32_t)); \
+        return true; \
+    } \
+    \
+    size_t prefix ## ArrayNDOffset(const prefix ## ArrayND* arr, const int32_t indices[]) \
+    { \
+        size_t offset = 0; \
+        for (int32_t i = 0; i < arr->rank; i++) \
+        { \
+            offset += (size_t)indices[i] * arr->strides[i]; \
+        } \
+        return offset; \
+    } \
+    \
+    itemType* prefix ## ArrayNDAt(const prefix ## ArrayND* arr, const int32_t indices[]) \
+    { \
+        return arr->values + prefix ## ArrayNDOffset(arr, indices); \
+    }
+
+#define shlDeclareFreeArrayND(prefix, itemType) \
+    void prefix ## FreeArrayND(prefix ## ArrayND* arr);
+
+#define shlDefineFreeArrayND(prefix, itemType) \
+    void prefix ## FreeArrayND(prefix ## ArrayND* arr) \
+    { \
+        if (!arr->values) \
+            return; \
+        \
+        SHL_FREE(((void**)arr->values)[-1]); \
+        arr->values = NULL; \
+        arr->count = 0; \
+        arr->rank = 0; \
+    }
+
+#ifndef SHL_ARRAY_DEFAULT_TILE_SIZE
+#define SHL_ARRAY_DEFAULT_TILE_SIZE 8
+#endif
+
+static inline size_t shl__tiledOffset(int32_t tileShift, int32_t tilesPerRow, int32_t i, int32_t j)
+{
+    int32_t tileMask = (1 << tileShift) - 1;
+    size_t tile = (size_t)(i >> tileShift) * (size_t)tilesPerRow + (size_t)(j >> tileShift);
+    return (tile << (2 * tileShift)) + ((size_t)(i & tileMask) << tileShift) + (size_t)(j & tileMask);
+}
+
+static inline uint64_t shl__mortonSpread(uint32_t x)
+{
+    uint64_t v = x;
+    v = (v | (v << 16)) & 0x0000FFFF0000FFFFull;
+    v = (v | (v << 8)) & 0x00FF00FF00FF00FFull;
+    v = (v | (v << 4)) & 0x0F0F0F0F0F0F0F0Full;
+    v = (v | (v << 2)) & 0x3333333333333333ull;
+    v = (v | (v << 1)) & 0x5555555555555555ull;
+    return v;
+}
+
+static inline size_t shl__mortonOffset(int32_t lowBits, int32_t i, int32_t j)
+{
+    uint32_t lowMask = (1u << lowBits) - 1;
+    uint64_t high = (uint64_t)(((uint32_t)i >> lowBits) | ((uint32_t)j >> lowBits)) << (2 * lowBits);
+    return (size_t)(high | (shl__mortonSpread((uint32_t)i & lowMask) << 1) | shl__mortonSpread((uint32_t)j & lowMask));
+}
+
+static inline int32_t shl__arrayCeilLog2(int32_t value)
+{
+    int32_t bits = 0;
+    while (bits < 31 && (1 << bits) < value)
+        bits++;
+    return bits;
+}
+
+#define shlTiledArrayOffset(arr, i, j) shl__tiledOffset((arr)->tileShift, (arr)->tilesPerRow, (i), (j))
+#define shlTiledArrayAt(arr, i, j) ((arr)->values[shlTiledArrayOffset(arr, i, j)])
+
+#define shlMortonArrayOffset(arr, i, j) shl__mortonOffset((arr)->lowBits, (i), (j))
+#define shlMortonArrayAt(arr, i, j) ((arr)->values[shlMortonArrayOffset(arr, i, j)])
+
+static inline size_t shl__mortonNext(size_t offset, size_t mask)
+{
+    return (((offset | ~mask) + 1) & mask) | (offset & ~mask);
+}
+
+static inline size_t shl__mortonPrev(size_t offset, size_t mask)
+{
+    return (((offset & mask) - 1) & mask) | (offset & ~mask);
+}
+
+#define shlMortonArrayNextCol(arr, offset) shl__mortonNext((offset), (arr)->colMask)
+#define shlMortonArrayPrevCol(arr, offset) shl__mortonPrev((offset), (arr)->colMask)
+#define shlMortonArrayNextRow(arr, offset) shl__mortonNext((offset), (arr)->rowMask)
+#define shlMortonArrayPrevRow(arr, offset) shl__mortonPrev((offset), (arr)->rowMask)
+
+#define shlDeclareTiledArray(prefix, itemType) \
+    typedef struct \
+    { \
+        int32_t rows; \
+        int32_t cols; \
+        int32_t tileShift; \
+        int32_t tilesPerRow; \
+        size_t count; \
+        itemType* values; \
+    } prefix ## TiledArray; \
+    \
+    bool prefix ## CreateTiledArray(prefix ## TiledArray* arr, int32_t n, int32_t m, int32_t tileSize); \
+    void prefix ## FreeTiledArray(prefix ## TiledArray* arr); \
+    void prefix ## TiledArrayFromRowMajor(prefix ## TiledArray* arr, const itemType* values, size_t stride); \
+    void prefix ## TiledArrayToRowMajor(const prefix ## TiledArray* arr, itemType* values, size_t stride);
+
+#define shlDefineTiledArray(prefix, itemType) \
+    bool prefix ## CreateTiledArray(prefix ## TiledArray* arr, int32_t n, int32_t m, int32_t tileSize) \
+    { \
+        void* data; \
+        size_t dataSize; \
+        \
+        arr->count = 0; \
+        arr->values = NULL; \
+        \
+        if (tileSize == 0) \
+            tileSize = SHL_ARRAY_DEFAULT_TILE_SIZE; \
+        \
+        if (n < 0 || m < 0 || tileSize < 1 || tileSize > (1 << 15) || (tileSize & (tileSize - 1)) != 0) \
+            return false; \
+        \
+        arr->rows = n; \
+        arr->cols = m; \
+        arr->tileShift = shl__arrayCeilLog2(tileSize); \
+        arr->tilesPerRow = (int32_t)(((int64_t)m + tileSize - 1) >> arr->tileShift); \
+        \
+        size_t tileRows = (size_t)(((int64_t)n + tileSize - 1) >> arr->tileShift); \
+        if (!shl__arrayMultiply(tileRows, (size_t)arr->tilesPerRow, &arr->count) || \
+            !shl__arrayMultiply(arr->count, (size_t)tileSize * (size_t)tileSize, &arr->count) || \
+            !shl__arrayMultiply(arr->count, sizeof(itemType), &dataSize)) \
+        { \
+            arr->count = 0; \
+            return false; \
+        } \
+        \
+        void* block = shl__arrayAllocate(sizeof(void*), dataSize, &data); \
+        if (!block) \
+        { \
+            arr->count = 0; \
+            return false; \
+        } \
+        \
+        ((void**)data)[-1] = block; \
+        arr->values = (itemType*)data; \
+        return true; \
+    } \
+    \
+    void prefix ## FreeTiledArray(prefix ## TiledArray* arr) \
+    { \
+        if (!arr->values) \
+            return; \
+        \
+        SHL_FREE(((void**)arr->values)[-1]); \
+        arr->values = NULL; \
+        arr->count = 0; \
+    } \
+    \
+    void prefix ## TiledArrayFromRowMajor(prefix ## TiledArray* arr, const itemType* values, size_t stride) \
+    { \
+        int32_t tileSize = 1 << arr->tileShift; \
+        for (int32_t i = 0; i < arr->rows; i++) \
+        { \
+            for (int32_t j = 0; j < arr->cols; j += tileSize) \
+            { \
+                int32_t count = arr->cols - j < tileSize ? arr->cols - j : tileSize; \
+                memcpy(&shlTiledArrayAt(arr, i, j), values + (size_t)i * stride + (size_t)j, (size_t)count * sizeof(itemType)); \
+            } \
+        } \
+    } \
+    \
+    void prefix ## TiledArrayToRowMajor(const prefix ## TiledArray* arr, itemType* values, size_t stride) \
+    { \
+        int32_t tileSize = 1 << arr->tileShift; \
+        for (int32_t i = 0; i < arr->rows; i++) \
+        { \
+            for (int32_t j = 0; j < arr->cols; j += tileSize) \
+            { \
+                int32_t count = arr->cols - j < tileSize ? arr->cols - j : tileSize; \
+                memcpy(values + (size_t)i * stride + (size_t)j, &shlTiledArrayAt(arr, i, j), (size_t)count * sizeof(itemType)); \
+            } \
+        } \
+    }
+
+#define shlDeclareMortonArray(prefix, itemType) \
+    typedef struct \
+    { \
+        int32_t rows; \
+        int32_t cols; \
+        int32_t lowBits; \
+        size_t rowMask; \
+        size_t colMask; \
+        size_t count; \
+        itemType* values; \
+    } prefix ## MortonArray; \
+    \
+    bool prefix ## CreateMortonArray(prefix ## MortonArray* arr, int32_t n, int32_t m); \
+    void prefix ## FreeMortonArray(prefix ## MortonArray* arr); \
+    void prefix ## MortonArrayFromRowMajor(prefix ## MortonArray* arr, const itemType* values, size_t stride); \
+    void prefix ## MortonArrayToRowMajor(const prefix ## MortonArray* arr, itemType* values, size_t stride);
+
+#define shlDefineMortonArray(prefix, itemType) \
+    bool prefix ## CreateMortonArray(prefix ## MortonArray* arr, int32_t n, int32_t m) \
+    { \
+        void* data; \
+        size_t dataSize; \
+        \
+        arr->count = 0; \
+        arr->values = NULL; \
+        \
+        if (n < 0 || m < 0) \
+            return false; \
+        \
+        int32_t rowBits = shl__arrayCeilLog2(n); \
+        int32_t colBits = shl__arrayCeilLog2(m); \
+        \
+        arr->rows = n; \
+        arr->cols = m; \
+        arr->lowBits = rowBits < colBits ? rowBits : colBits; \
+        arr->rowMask = shlMortonArrayOffset(arr, (int32_t)((1u << rowBits) - 1), 0); \
+        arr->colMask = shlMortonArrayOffset(arr, 0, (int32_t)((1u << colBits) - 1)); \
+        \
+        if (rowBits + colBits >= (int32_t)(sizeof(size_t) * 8) || \
+            !shl__arrayMultiply((size_t)1 << (rowBits + colBits), sizeof(itemType), &dataSize)) \
+            return false; \
+        \
+        void* block = shl__arrayAllocate(sizeof(void*), dataSize, &data); \
+        if (!block) \
+            return false; \
+        \
+        ((void**)data)[-1] = block; \
+        arr->count = (size_t)1 << (rowBits + colBits); \
+        arr->values = (itemType*)data; \
+        return true; \
+    } \
+    \
+    void prefix ## FreeMortonArray(prefix ## MortonArray* arr) \
+    { \
+        if (!arr->values) \
+            return; \
+        \
+        SHL_FREE(((void**)arr->values)[-1]); \
+        arr->values = NULL; \
+        arr->count = 0; \
+    } \
+    \
+    void prefix ## MortonArrayFromRowMajor(prefix ## MortonArray* arr, const itemType* values, size_t stride) \
+    { \
+        for (int32_t i = 0; i < arr->rows; i++) \
+        { \
+            size_t rowOffset = shlMortonArrayOffset(arr, i, 0); \
+            size_t colOffset = 0; \
+            const itemType* row = values + (size_t)i * stride; \
+            for (int32_t j = 0; j < arr->cols; j++) \
+            { \
+                arr->values[rowOffset | colOffset] = row[j]; \
+                colOffset = ((colOffset | ~arr->colMask) + 1) & arr->colMask; \
+            } \
+        } \
+    } \
+    \
+    void prefix ## MortonArrayToRowMajor(const prefix ## MortonArray* arr, itemType* values, size_t stride) \
+    { \
+        for (int32_t i = 0; i < arr->rows; i++) \
+        { \
+            size_t rowOffset = shlMortonArrayOffset(arr, i, 0); \
+            size_t colOffset = 0; \
+            itemType* row = values + (size_t)i * stride; \
+            for (int32_t j = 0; j < arr->cols; j++) \
+            { \
+                row[j] = arr->values[rowOffset | colOffset]; \
+                colOffset = ((colOffset | ~arr->colMask) + 1) & arr->colMask; \
+            } \
+        } \
+    }
+
+#define SHL__ARRAY_VECTOR_SIZE 32
+
+static inline bool shl__arrayPattern(unsigned char pattern[SHL__ARRAY_VECTOR_SIZE], const void* value, size_t itemSize)
+{
+    if (itemSize > SHL__ARRAY_VECTOR_SIZE || SHL__ARRAY_VECTOR_SIZE % itemSize != 0)
+        return false;
+
+    for (size_t i = 0; i < SHL__ARRAY_VECTOR_SIZE; i += itemSize)
+        memcpy(pattern + i, value, itemSize);
+
+    return true;
+}
+
+static inline void shl__arrayFill(void* values, size_t count, const void* value, size_t itemSize)
+{
+    unsigned char* bytes = (unsigned char*)values;
+    unsigned char pattern[SHL__ARRAY_VECTOR_SIZE];
+    size_t size = count * itemSize;
+    size_t i = 0;
+
+    if (count == 0)
+        return;
+
+    if (!shl__arrayPattern(pattern, value, itemSize))
+    {
+        memcpy(bytes, value, itemSize);
+        for (size_t filled = itemSize; filled < size; filled *= 2)
+            memcpy(bytes + filled, bytes, filled < size - filled ? filled : size - filled);
+        return;
+    }
+
+#if defined(SHL__ARRAY_AVX2)
+    __m256i vector = _mm256_loadu_si256((const __m256i*)pattern);
+    for (; i + 32 <= size; i += 32)
+        _mm256_storeu_si256((__m256i*)(bytes + i), vector);
+#elif defined(SHL__ARRAY_SSE2)
+    __m128i low = _mm_loadu_si128((const __m128i*)pattern);
+    __m128i high = _mm_loadu_si128((const __m128i*)(pattern + 16));
+    for (; i + 32 <= size; i += 32)
+    {
+        _mm_storeu_si128((__m128i*)(bytes + i), low);
+        _mm_storeu_si128((__m128i*)(bytes + i + 16), high);
+    }
+#else
+    for (; i + SHL__ARRAY_VECTOR_SIZE <= size; i += SHL__ARRAY_VECTOR_SIZE)
+        memcpy(bytes + i, pattern, SHL__ARRAY_VECTOR_SIZE);
+#endif
+
+    memcpy(bytes + i, pattern, size - i);
+}
+
+static inline void shl__arrayBlit(void* dst, const void* src, size_t count, const void* key, size_t itemSize)
+{
+    unsigned char* target = (unsigned char*)dst;
+    const unsigned char* source = (const unsigned char*)src;
+    size_t size = count * itemSize;
+    size_t i = 0;
+
+#if defined(SHL__ARRAY_AVX2) || defined(SHL__ARRAY_SSE2)
+    unsigned char pattern[SHL__ARRAY_VECTOR_SIZE];
+    if ((itemSize == 1 || itemSize == 2 || itemSize == 4 || itemSize == 8) && shl__arrayPattern(pattern, key, itemSize))
+    {
+#if defined(SHL__ARRAY_AVX2)
+        __m256i keys = _mm256_loadu_si256((const __m256i*)pattern);
+        for (; i + 32 <= size; i += 32)
+        {
+            __m256i values = _mm256_loadu_si256((const __m256i*)(source + i));
+            __m256i equal = itemSize == 1 ? _mm256_cmpeq_epi8(values, keys) :
+                            itemSize == 2 ? _mm256_cmpeq_epi16(values, keys) :
+                            itemSize == 4 ? _mm256_cmpeq_epi32(values, keys) :
+                                            _mm256_cmpeq_epi64(values, keys);
+            __m256i previous = _mm256_loadu_si256((const __m256i*)(target + i));
+            _mm256_storeu_si256((__m256i*)(target + i), _mm256_blendv_epi8(values, previous, equal));
+        }
+#else
+        __m128i keys = _mm_loadu_si128((const __m128i*)pattern);
+        for (; i + 16 <= size; i += 16)
+        {
+            __m128i values = _mm_loadu_si128((const __m128i*)(source + i));
+            __m128i equal;
+            if (itemSize == 1)
+                equal = _mm_cmpeq_epi8(values, keys);
+            else if (itemSize == 2)
+                equal = _mm_cmpeq_epi16(values, keys);
+            else
+            {
+                equal = _mm_cmpeq_epi32(values, keys);
+                if (itemSize == 8)
+                    equal = _mm_and_si128(equal, _mm_shuffle_epi32(equal, _MM_SHUFFLE(2, 3, 0, 1)));
+            }
+            __m128i previous = _mm_loadu_si128((const __m128i*)(target + i));
+            _mm_storeu_si128((__m128i*)(target + i), _mm_or_si128(_mm_and_si128(equal, previous), _mm_andnot_si128(equal, values)));
+        }
+#endif
+    }
+#endif
+
+    for (; i < size; i += itemSize)
+    {
+        if (memcmp(source + i, key, itemSize) != 0)
+            memcpy(target + i, source + i, itemSize);
+    }
+}
+
+#define shlArrayMapExpr(itemType, arr, n, m, x, expr) \
+    do \
+    { \
+        if ((n) > 0 && (m) > 0) \
+        { \
+            itemType* shl__values = (arr)[0]; \
+            size_t shl__count = (size_t)(n) * (size_t)(m); \
+            for (size_t shl__i = 0; shl__i < shl__count; shl__i++) \
+            { \
+                itemType x = shl__values[shl__i]; \
+                shl__values[shl__i] = (expr); \
+            } \
+        } \
+    } while (0)
+
+#define shlArrayReduceExpr(itemType, arr, n, m, acc, x, expr) \
+    do \
+    { \
+        if ((n) > 0 && (m) > 0) \
+        { \
+            const itemType* shl__values = (arr)[0]; \
+            size_t shl__count = (size_t)(n) * (size_t)(m); \
+            for (size_t shl__i = 0; shl__i < shl__count; shl__i++) \
+            { \
+                itemType x = shl__values[shl__i]; \
+                (acc) = (expr); \
+            } \
+        } \
+    } while (0)
+
+#define shlDeclareArrayOps(prefix, itemType) \
+    void prefix ## FillArray(itemType** arr, int32_t n, int32_t m, itemType value); \
+    void prefix ## FillArrayRegion(itemType** arr, int32_t row, int32_t col, int32_t rows, int32_t cols, itemType value); \
+    void prefix ## CopyArrayRegion(itemType** dst, int32_t dstRow, int32_t dstCol, itemType** src, int32_t srcRow, int32_t srcCol, int32_t rows, int32_t cols); \
+    void prefix ## BlitArray(itemType** dst, int32_t dstRow, int32_t dstCol, itemType** src, int32_t srcRow, int32_t srcCol, int32_t rows, int32_t cols, itemType key); \
+    void prefix ## MapArray(itemType** dst, itemType** src, int32_t n, int32_t m, itemType (*mapFn)(itemType value, void* userData), void* userData); \
+    itemType prefix ## ReduceArray(itemType** arr, int32_t n, int32_t m, itemType initial, itemType (*reduceFn)(itemType acc, itemType value, void* userData), void* userData);
+
+#define shlDefineArrayOps(prefix, itemType) \
+    void prefix ## FillArray(itemType** arr, int32_t n, int32_t m, itemType value) \
+    { \
+        if (n <= 0 || m <= 0) \
+            return; \
+        \
+        shl__arrayFill(arr[0], (size_t)n * (size_t)m, &value, sizeof(itemType)); \
+    } \
+    \
+    void prefix ## FillArrayRegion(itemType** arr, int32_t row, int32_t col, int32_t rows, int32_t cols, itemType value) \
+    { \
+        for (int32_t i = 0; i < rows && cols > 0; i++) \
+        { \
+            shl__arrayFill(arr[row + i] + col, (size_t)cols, &value, sizeof(itemType)); \
+        } \
+    } \
+    \
+    void prefix ## CopyArrayRegion(itemType** dst, int32_t dstRow, int32_t dstCol, itemType** src, int32_t srcRow, int32_t srcCol, int32_t rows, int32_t cols) \
+    { \
+        if (rows <= 0 || cols <= 0) \
+            return; \
+        \
+        bool backwards = dst == src && dstRow > srcRow; \
+        for (int32_t k = 0; k < rows; k++) \
+        { \
+            int32_t i = backwards ? rows - 1 - k : k; \
+            memmove(dst[dstRow + i] + dstCol, src[srcRow + i] + srcCol, (size_t)cols * sizeof(itemType)); \
+        } \
+    } \
+    \
+    void prefix ## BlitArray(itemType** dst, int32_t dstRow, int32_t dstCol, itemType** src, int32_t srcRow, int32_t srcCol, int32_t rows, int32_t cols, itemType key) \
+    { \
+        for (int32_t i = 0; i < rows && cols > 0; i++) \
+        { \
+            shl__arrayBlit(dst[dstRow + i] + dstCol, src[srcRow + i] + srcCol, (size_t)cols, &key, sizeof(itemType)); \
+        } \
+    } \
+    \
+    void prefix ## MapArray(itemType** dst, itemType** src, int32_t n, int32_t m, itemType (*mapFn)(itemType value, void* userData), void* userData) \
+    { \
+        if (n <= 0 || m <= 0) \
+            return; \
+        \
+        itemType* target = dst[0]; \
+        const itemType* source = src[0]; \
+        size_t count = (size_t)n * (size_t)m; \
+        for (size_t i = 0; i < count; i++) \
+        { \
+            target[i] = mapFn(source[i], userData); \
+        } \
+    } \
+    \
+    itemType prefix ## ReduceArray(itemType** arr, int32_t n, int32_t m, itemType initial, itemType (*reduceFn)(itemType acc, itemType value, void* userData), void* userData) \
+    { \
+        if (n <= 0 || m <= 0) \
+            return initial; \
+        \
+        const itemType* values = arr[0]; \
+        size_t count = (size_t)n * (size_t)m; \
+        for (size_t i = 0; i < count; i++) \
+        { \
+            initial = reduceFn(initial, values[i], userData); \
+        } \
+        return initial; \
+    }
+
+typedef struct
+{
+    int32_t begin;
+    int32_t end;
+    int32_t readBegin;
+    int32_t readEnd;
+    int32_t cols;
+    int32_t band;
+} shlArrayRows;
+
+typedef struct shlArrayPool shlArrayPool;
+
+typedef struct
+{
+    shlArrayPool* pool;
+    int32_t index;
+} shl__ArrayWorker;
+
+struct shlArrayPool
+{
+    int32_t threadCount;
+#if defined(SHL__ARRAY_THREADS)
+    pthread_t* threads;
+    shl__ArrayWorker* workers;
+    pthread_mutex_t mutex;
+    pthread_cond_t start;
+    pthread_cond_t done;
+    uint32_t generation;
+    int32_t pending;
+    bool stop;
+    void (*taskFn)(void* context, int32_t task);
+    void* context;
+    int32_t taskCount;
+#endif
+};
+
+#if defined(SHL__ARRAY_THREADS)
+static inline void* shl__arrayPoolWorker(void* arg)
+{
+    shl__ArrayWorker* worker = (shl__ArrayWorker*)arg;
+    shlArrayPool* pool = worker->pool;
+    uint32_t generation = 0;
+
+    pthread_mutex_lock(&pool->mutex);
+    for (;;)
+    {
+        while (!pool->stop && pool->generation == generation)
+            pthread_cond_wait(&pool->start, &pool->mutex);
+
+        if (pool->stop)
+            break;
+
+        generation = pool->generation;
+        void (*taskFn)(void* context, int32_t task) = pool->taskFn;
+        void* context = pool->context;
+        int32_t taskCount = pool->taskCount;
+        pthread_mutex_unlock(&pool->mutex);
+
+        for (int32_t task = worker->index; task < taskCount; task += pool->threadCount)
+            taskFn(context, task);
+
+        pthread_mutex_lock(&pool->mutex);
+        if (--pool->pending == 0)
+            pthread_cond_signal(&pool->done);
+    }
+    pthread_mutex_unlock(&pool->mutex);
+
+    return NULL;
+}
+#endif
+
+static inline void shlArrayPoolFree(shlArrayPool* pool);
+
+static inline bool shlArrayPoolInit(shlArrayPool* pool, int32_t threadCount)
+{
+    pool->threadCount = 1;
+
+#if defined(SHL__ARRAY_THREADS)
+    pool->threads = NULL;
+    pool->workers = NULL;
+    pool->generation = 0;
+    pool->pending = 0;
+    pool->stop = false;
+    pool->taskFn = NULL;
+    pool->context = NULL;
+    pool->taskCount = 0;
+    pthread_mutex_init(&pool->mutex, NULL);
+    pthread_cond_init(&pool->start, NULL);
+    pthread_cond_init(&pool->done, NULL);
+
+    if (threadCount <= 1)
+        return true;
+
+    pool->threads = (pthread_t*)SHL_MALLOC((size_t)(threadCount - 1) * sizeof(pthread_t));
+    pool->workers = (shl__ArrayWorker*)SHL_MALLOC((size_t)(threadCount - 1) * sizeof(shl__ArrayWorker));
+    if (!pool->threads || !pool->workers)
+    {
+        shlArrayPoolFree(pool);
+        return false;
+    }
+
+    pool->threadCount = threadCount;
+    for (int32_t i = 0; i < threadCount - 1; i++)
+    {
+        pool->workers[i].pool = pool;
+        pool->workers[i].index = i + 1;
+
+        if (pthread_create(&pool->threads[i], NULL, shl__arrayPoolWorker, &pool->workers[i]) != 0)
+        {
+            pool->threadCount = i + 1;
+            shlArrayPoolFree(pool);
+            return false;
+        }
+    }
+#else
+    pool->threadCount = threadCount > 1 ? threadCount : 1;
+#endif
+
+    return true;
+}
+
+static inline void shlArrayPoolFree(shlArrayPool* pool)
+{
+#if defined(SHL__ARRAY_THREADS)
+    pthread_mutex_lock(&pool->mutex);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->start);
+    pthread_mutex_unlock(&pool->mutex);
+
+    for (int32_t i = 0; i < pool->threadCount - 1; i++)
+        pthread_join(pool->threads[i], NULL);
+
+    SHL_FREE(pool->threads);
+    SHL_FREE(pool->workers);
+    pool->threads = NULL;
+    pool->workers = NULL;
+    pthread_mutex_destroy(&pool->mutex);
+    pthread_cond_destroy(&pool->start);
+    pthread_cond_destroy(&pool->done);
+#endif
+
+    pool->threadCount = 1;
+}
+
+static inline void shl__arrayPoolRun(shlArrayPool* pool, void (*taskFn)(void* context, int32_t task), void* context, int32_t taskCount)
+{
+    int32_t step = 1;
+    (void)pool;
+
+#if defined(SHL__ARRAY_THREADS)
+    int32_t threadCount = pool ? pool->threadCount : 1;
+    if (threadCount > 1)
+    {
+        step = threadCount;
+        pthread_mutex_lock(&pool->mutex);
+        pool->taskFn = taskFn;
+        pool->context = context;
+        pool->taskCount = taskCount;
+        pool->pending = threadCount - 1;
+        pool->generation++;
+        pthread_cond_broadcast(&pool->start);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+#endif
+
+    for (int32_t task = 0; task < taskCount; task += step)
+        taskFn(context, task);
+
+#if defined(SHL__ARRAY_THREADS)
+    if (threadCount > 1)
+    {
+        pthread_mutex_lock(&pool->mutex);
+        while (pool->pending > 0)
+            pthread_cond_wait(&pool->done, &pool->mutex);
+        pthread_mutex_unlock(&pool->mutex);
+    }
+#endif
+}
+
+#define shlDeclareParallelForRows(prefix, itemType) \
+    typedef void (*prefix ## RowsFn)(itemType** dst, itemType** src, shlArrayRows rows, void* userData); \
+    \
+    void prefix ## ParallelForRows(itemType*** arr, itemType*** back, int32_t n, int32_t m, prefix ## RowsFn rowsFn, void* userData, shlArrayPool* pool, int32_t halo);
+
+#define shlDefineParallelForRows(prefix, itemType) \
+    typedef struct \
+    { \
+        itemType** dst; \
+        itemType** src; \
+        int32_t n; \
+        int32_t m; \
+        int32_t halo; \
+        int32_t bandCount; \
+        prefix ## RowsFn rowsFn; \
+        void* userData; \
+    } prefix ## __RowsJob; \
+    \
+    void prefix ## __rowsTask(void* context, int32_t band) \
+    { \
+        prefix ## __RowsJob* job = (prefix ## __RowsJob*)context; \
+        shlArrayRows rows; \
+        rows.begin = (int32_t)((int64_t)job->n * band / job->bandCount); \
+        rows.end = (int32_t)((int64_t)job->n * (band + 1) / job->bandCount); \
+        rows.readBegin = rows.begin - job->halo > 0 ? rows.begin - job->halo : 0; \
+        rows.readEnd = (int64_t)rows.end + job->halo < job->n ? rows.end + job->halo : job->n; \
+        rows.cols = job->m; \
+        rows.band = band; \
+        \
+        if (rows.begin < rows.end) \
+            job->rowsFn(job->dst, job->src, rows, job->userData); \
+    } \
+    \
+    void prefix ## ParallelForRows(itemType*** arr, itemType*** back, int32_t n, int32_t m, prefix ## RowsFn rowsFn, void* userData, shlArrayPool* pool, int32_t halo) \
+    { \
+        if (n <= 0 || m <= 0) \
+            return; \
+        \
+        int32_t threadCount = pool ? pool->threadCount : 1; \
+        prefix ## __RowsJob job; \
+        job.src = *arr; \
+        job.dst = back ? *back : *arr; \
+        job.n = n; \
+        job.m = m; \
+        job.halo = back && halo > 0 ? halo : 0; \
+        job.bandCount = threadCount < n ? threadCount : n; \
+        job.rowsFn = rowsFn; \
+        job.userData = userData; \
+        \
+        shl__arrayPoolRun(pool, prefix ## __rowsTask, &job, job.bandCount); \
+        \
+        if (back) \
+        { \
+            itemType** swap = *arr; \
+            *arr = *back; \
+            *back = swap; \
+        } \
     }
 
 #endif // SHL_ARRAY_H
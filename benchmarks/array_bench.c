@@ -0,0 +1,331 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+
+#include "../array.h"
+#include "bench_common.h"
+
+shlDeclareCreateArray(float, float)
+shlDefineCreateArray(float, float)
+shlDeclareFreeArray(float, float)
+shlDefineFreeArray(float, float)
+shlDeclareCreateArray(u8, uint8_t)
+shlDefineCreateArray(u8, uint8_t)
+shlDeclareFreeArray(u8, uint8_t)
+shlDefineFreeArray(u8, uint8_t)
+shlDeclareArrayOps(u8, uint8_t)
+shlDefineArrayOps(u8, uint8_t)
+shlDeclareParallelForRows(u8, uint8_t)
+shlDefineParallelForRows(u8, uint8_t)
+shlDeclareTiledArray(float, float)
+shlDefineTiledArray(float, float)
+shlDeclareMortonArray(float, float)
+shlDefineMortonArray(float, float)
+
+#define GRID_SIZE 4096
+#define BLOCK_SIZE 16
+
+#define ROW_MAJOR_AT(grid, i, j) ((grid)->rows[i][j])
+#define TILED_AT(grid, i, j) shlTiledArrayAt(&(grid)->tiled, i, j)
+#define MORTON_AT(grid, i, j) shlMortonArrayAt(&(grid)->morton, i, j)
+
+typedef struct
+{
+    float** rows;
+    floatTiledArray tiled;
+    floatMortonArray morton;
+} Grids;
+
+typedef enum
+{
+    OrderRows,
+    OrderColumns,
+    OrderBlocks
+} Order;
+
+/* block order visits the grid in BLOCK_SIZE x BLOCK_SIZE blocks, the way a flood fill or a tiled pass touches it,
+   and column order makes every vertical step a new cache line in the row-major layout */
+#define DEFINE_STENCIL(name, at) \
+    static double name(const Grids* grids, Order order) \
+    { \
+        double sum = 0; \
+        int32_t step = order == OrderBlocks ? BLOCK_SIZE : GRID_SIZE; \
+        for (int32_t ba = 0; ba < GRID_SIZE; ba += step) \
+        { \
+            for (int32_t bb = 0; bb < GRID_SIZE; bb += step) \
+            { \
+                for (int32_t a = ba > 0 ? ba : 1; a < ba + step && a < GRID_SIZE - 1; a++) \
+                { \
+                    for (int32_t b = bb > 0 ? bb : 1; b < bb + step && b < GRID_SIZE - 1; b++) \
+                    { \
+                        int32_t i = order == OrderColumns ? b : a; \
+                        int32_t j = order == OrderColumns ? a : b; \
+                        sum += at(grids, i, j) + at(grids, i - 1, j) + at(grids, i + 1, j) + at(grids, i, j - 1) + at(grids, i, j + 1); \
+                    } \
+                } \
+            } \
+        } \
+        return sum; \
+    }
+
+DEFINE_STENCIL(stencilRowMajor, ROW_MAJOR_AT)
+DEFINE_STENCIL(stencilTiled, TILED_AT)
+DEFINE_STENCIL(stencilMorton, MORTON_AT)
+
+/* inside a tile the neighbours are at +-1 and +-BLOCK_SIZE, only the cells on the border of a tile use the accessor */
+static double stencilTiledLocal(const Grids* grids, Order order)
+{
+    const floatTiledArray* tiled = &grids->tiled;
+    double sum = 0;
+    (void)order;
+
+    for (int32_t bi = 0; bi < GRID_SIZE; bi += BLOCK_SIZE)
+    {
+        for (int32_t bj = 0; bj < GRID_SIZE; bj += BLOCK_SIZE)
+        {
+            const float* tile = &shlTiledArrayAt(tiled, bi, bj);
+
+            for (int32_t ti = 0; ti < BLOCK_SIZE; ti++)
+            {
+                int32_t i = bi + ti;
+                if (i == 0 || i == GRID_SIZE - 1)
+                    continue;
+
+                for (int32_t tj = 0; tj < BLOCK_SIZE; tj++)
+                {
+                    int32_t j = bj + tj;
+                    if (j == 0 || j == GRID_SIZE - 1)
+                        continue;
+
+                    if (ti > 0 && ti < BLOCK_SIZE - 1 && tj > 0 && tj < BLOCK_SIZE - 1)
+                    {
+                        const float* cell = tile + ti * BLOCK_SIZE + tj;
+                        sum += cell[0] + cell[-BLOCK_SIZE] + cell[BLOCK_SIZE] + cell[-1] + cell[1];
+                    }
+                    else
+                    {
+                        sum += TILED_AT(grids, i, j) + TILED_AT(grids, i - 1, j) + TILED_AT(grids, i + 1, j) + TILED_AT(grids, i, j - 1) + TILED_AT(grids, i, j + 1);
+                    }
+                }
+            }
+        }
+    }
+
+    return sum;
+}
+
+/* walks the rows with the Morton offset of the current cell, stepping to the neighbours with masked increments */
+static double stencilMortonSteps(const Grids* grids, Order order)
+{
+    const floatMortonArray* morton = &grids->morton;
+    const float* values = morton->values;
+    double sum = 0;
+    (void)order;
+
+    for (int32_t i = 1; i < GRID_SIZE - 1; i++)
+    {
+        size_t offset = shlMortonArrayOffset(morton, i, 1);
+
+        for (int32_t j = 1; j < GRID_SIZE - 1; j++)
+        {
+            size_t right = shlMortonArrayNextCol(morton, offset);
+            sum += values[offset] + values[shlMortonArrayPrevRow(morton, offset)] + values[shlMortonArrayNextRow(morton, offset)] +
+                   values[shlMortonArrayPrevCol(morton, offset)] + values[right];
+            offset = right;
+        }
+    }
+
+    return sum;
+}
+
+static void benchStencil(const char* name, double (*stencilFn)(const Grids*, Order), const Grids* grids, Order order)
+{
+    uint64_t start = bench_nowNs();
+    double sum = stencilFn(grids, order);
+    bench_report(name, bench_nowNs() - start, (uint64_t)(GRID_SIZE - 2) * (GRID_SIZE - 2));
+
+    if (sum == 0)
+        printf("  unexpected sum\n");
+}
+
+/* fog of war: a byte per cell, the visible cells of a minimap layer are blitted over it with 0 as the transparent key */
+static void benchBulkOperations(void)
+{
+    uint8_t** fog = u8CreateArray(GRID_SIZE, GRID_SIZE);
+    uint8_t** layer = u8CreateArray(GRID_SIZE, GRID_SIZE);
+    const uint64_t cells = (uint64_t)GRID_SIZE * GRID_SIZE;
+    uint64_t visible = 0;
+
+    for (int32_t i = 0; i < GRID_SIZE; i++)
+    {
+        for (int32_t j = 0; j < GRID_SIZE; j++)
+            layer[i][j] = ((i >> 5) + (j >> 5)) % 3 == 0 ? 0 : (uint8_t)(1 + (i ^ j) % 200);
+    }
+
+    memset(fog[0], 0, (size_t)cells);
+
+    printf("Bulk operations on a %dx%d byte grid (one op is one cell)\n", GRID_SIZE, GRID_SIZE);
+
+    uint64_t start = bench_nowNs();
+    for (int32_t i = 0; i < GRID_SIZE; i++)
+    {
+        for (int32_t j = 0; j < GRID_SIZE; j++)
+            fog[i][j] = 255;
+    }
+    bench_report("fill, double loop", bench_nowNs() - start, cells);
+
+    start = bench_nowNs();
+    u8FillArray(fog, GRID_SIZE, GRID_SIZE, 255);
+    bench_report("fill, FillArray", bench_nowNs() - start, cells);
+
+    start = bench_nowNs();
+    for (int32_t i = 0; i < GRID_SIZE; i++)
+    {
+        for (int32_t j = 0; j < GRID_SIZE; j++)
+        {
+            if (layer[i][j] != 0)
+                fog[i][j] = layer[i][j];
+        }
+    }
+    bench_report("blit with key, double loop", bench_nowNs() - start, cells);
+
+    u8FillArray(fog, GRID_SIZE, GRID_SIZE, 255);
+    start = bench_nowNs();
+    u8BlitArray(fog, 0, 0, layer, 0, 0, GRID_SIZE, GRID_SIZE, 0);
+    bench_report("blit with key, BlitArray", bench_nowNs() - start, cells);
+
+    start = bench_nowNs();
+    for (int32_t i = 0; i < GRID_SIZE; i++)
+    {
+        for (int32_t j = 0; j < GRID_SIZE; j++)
+            fog[i][j] = fog[i][j] > 8 ? fog[i][j] - 8 : 0;
+    }
+    bench_report("decay map, double loop", bench_nowNs() - start, cells);
+
+    start = bench_nowNs();
+    shlArrayMapExpr(uint8_t, fog, GRID_SIZE, GRID_SIZE, x, (uint8_t)(x > 8 ? x - 8 : 0));
+    bench_report("decay map, shlArrayMapExpr", bench_nowNs() - start, cells);
+
+    start = bench_nowNs();
+    shlArrayReduceExpr(uint8_t, fog, GRID_SIZE, GRID_SIZE, visible, x, visible + (x != 0));
+    bench_report("count visible, shlArrayReduceExpr", bench_nowNs() - start, cells);
+
+    if (visible == 0)
+        printf("  unexpected count\n");
+
+    u8FreeArray(fog);
+    u8FreeArray(layer);
+}
+
+#define LIFE_STEPS 8
+
+/* interior cells only, so every row reads the row above and below it: a halo of one row */
+static void lifeRows(uint8_t** dst, uint8_t** src, shlArrayRows rows, void* userData)
+{
+    (void)userData;
+
+    for (int32_t i = rows.begin > 0 ? rows.begin : 1; i < rows.end && i < GRID_SIZE - 1; i++)
+    {
+        const uint8_t* above = src[i - 1];
+        const uint8_t* row = src[i];
+        const uint8_t* below = src[i + 1];
+        uint8_t* out = dst[i];
+
+        for (int32_t j = 1; j < rows.cols - 1; j++)
+        {
+            uint8_t alive = (uint8_t)(above[j - 1] + above[j] + above[j + 1] + row[j - 1] + row[j + 1] + below[j - 1] + below[j] + below[j + 1]);
+            out[j] = (uint8_t)((alive == 3) | ((alive == 2) & row[j]));
+        }
+    }
+}
+
+static void benchParallelForRows(void)
+{
+    static const int32_t threadCounts[] = { 1, 2, 4, 8 };
+    uint8_t** grid = u8CreateArray(GRID_SIZE, GRID_SIZE);
+    uint8_t** back = u8CreateArray(GRID_SIZE, GRID_SIZE);
+    uint8_t** initial = u8CreateArray(GRID_SIZE, GRID_SIZE);
+    const uint64_t cells = (uint64_t)GRID_SIZE * GRID_SIZE * LIFE_STEPS;
+    char label[64];
+
+    uint32_t seed = 12345u;
+    for (int32_t i = 0; i < GRID_SIZE; i++)
+    {
+        for (int32_t j = 0; j < GRID_SIZE; j++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            initial[i][j] = (uint8_t)((seed >> 16) % 4 == 0);
+        }
+    }
+
+    printf("Game of life on a %dx%d byte grid, %d steps (one op is one cell update)\n", GRID_SIZE, GRID_SIZE, LIFE_STEPS);
+
+    u8CopyArrayRegion(grid, 0, 0, initial, 0, 0, GRID_SIZE, GRID_SIZE);
+    uint64_t start = bench_nowNs();
+    for (int32_t step = 0; step < LIFE_STEPS; step++)
+        u8ParallelForRows(&grid, &back, GRID_SIZE, GRID_SIZE, lifeRows, NULL, NULL, 1);
+    bench_report("ParallelForRows, no pool", bench_nowNs() - start, cells);
+
+    for (size_t t = 0; t < sizeof(threadCounts) / sizeof(threadCounts[0]); t++)
+    {
+        shlArrayPool pool;
+        shlArrayPoolInit(&pool, threadCounts[t]);
+        u8CopyArrayRegion(grid, 0, 0, initial, 0, 0, GRID_SIZE, GRID_SIZE);
+
+        start = bench_nowNs();
+        for (int32_t step = 0; step < LIFE_STEPS; step++)
+            u8ParallelForRows(&grid, &back, GRID_SIZE, GRID_SIZE, lifeRows, NULL, &pool, 1);
+
+        snprintf(label, sizeof(label), "ParallelForRows, %d threads", threadCounts[t]);
+        bench_report(label, bench_nowNs() - start, cells);
+        shlArrayPoolFree(&pool);
+    }
+
+    u8FreeArray(grid);
+    u8FreeArray(back);
+    u8FreeArray(initial);
+}
+
+int main(void)
+{
+    Grids grids = { floatCreateArray(GRID_SIZE, GRID_SIZE), { 0 }, { 0 } };
+
+    for (int32_t i = 0; i < GRID_SIZE; i++)
+    {
+        for (int32_t j = 0; j < GRID_SIZE; j++)
+            grids.rows[i][j] = (float)((i * 31 + j * 17) % 101);
+    }
+
+    floatCreateTiledArray(&grids.tiled, GRID_SIZE, GRID_SIZE, BLOCK_SIZE);
+    floatCreateMortonArray(&grids.morton, GRID_SIZE, GRID_SIZE);
+
+    printf("5-point stencil on a %dx%d float grid (one op is one cell)\n", GRID_SIZE, GRID_SIZE);
+
+    uint64_t start = bench_nowNs();
+    floatTiledArrayFromRowMajor(&grids.tiled, grids.rows[0], GRID_SIZE);
+    bench_report("tiled 16x16, convert from row-major", bench_nowNs() - start, (uint64_t)GRID_SIZE * GRID_SIZE);
+
+    start = bench_nowNs();
+    floatMortonArrayFromRowMajor(&grids.morton, grids.rows[0], GRID_SIZE);
+    bench_report("morton, convert from row-major", bench_nowNs() - start, (uint64_t)GRID_SIZE * GRID_SIZE);
+
+    benchStencil("row-major, row order", stencilRowMajor, &grids, OrderRows);
+    benchStencil("row-major, column order", stencilRowMajor, &grids, OrderColumns);
+    benchStencil("row-major, 16x16 block order", stencilRowMajor, &grids, OrderBlocks);
+    benchStencil("tiled 16x16, row order", stencilTiled, &grids, OrderRows);
+    benchStencil("tiled 16x16, column order", stencilTiled, &grids, OrderColumns);
+    benchStencil("tiled 16x16, 16x16 block order", stencilTiled, &grids, OrderBlocks);
+    benchStencil("tiled 16x16, tile-local pointers", stencilTiledLocal, &grids, OrderBlocks);
+    benchStencil("morton, row order", stencilMorton, &grids, OrderRows);
+    benchStencil("morton, column order", stencilMorton, &grids, OrderColumns);
+    benchStencil("morton, 16x16 block order", stencilMorton, &grids, OrderBlocks);
+    benchStencil("morton, neighbour steps", stencilMortonSteps, &grids, OrderRows);
+
+    benchBulkOperations();
+    benchParallelForRows();
+
+    floatFreeArray(grids.rows);
+    floatFreeTiledArray(&grids.tiled);
+    floatFreeMortonArray(&grids.morton);
+    return 0;
+}
@@ -0,0 +1,25 @@
+#ifndef SHL_BENCH_COMMON_H
+#define SHL_BENCH_COMMON_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <time.h>
+
+static inline uint64_t bench_nowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline void bench_report(const char* name, uint64_t elapsedNs, uint64_t operations)
+{
+    double seconds = (double)elapsedNs / 1e9;
+    printf("%-48s %10.2f ms %12.2f Mops/s %10.2f ns/op\n",
+           name,
+           (double)elapsedNs / 1e6,
+           seconds > 0 ? (double)operations / seconds / 1e6 : 0.0,
+           operations > 0 ? (double)elapsedNs / (double)operations : 0.0);
+}
+
+#endif // SHL_BENCH_COMMON_H
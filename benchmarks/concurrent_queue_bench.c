@@ -0,0 +1,302 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include "../concurrent_queue.h"
+#include "../queue.h"
+#include "bench_common.h"
+
+shlDeclareSpscQueue(IntSpscQueue, int)
+shlDefineSpscQueue(IntSpscQueue, int)
+shlDeclareMpmcQueue(IntMpmcQueue, int)
+shlDefineMpmcQueue(IntMpmcQueue, int)
+shlDeclareQueue(IntQueue, int)
+shlDefineQueue(IntQueue, int)
+
+#define ITEM_COUNT 4000000
+#define PING_PONG_COUNT 100000
+#define QUEUE_CAPACITY 4096
+#define BATCH_SIZE 64
+#define MAX_THREADS 8
+
+typedef enum
+{
+    QueueKindSpsc,
+    QueueKindMpmc,
+    QueueKindMutex
+} QueueKind;
+
+/* queue.h wrapped in a mutex, the baseline these queues replace */
+typedef struct
+{
+    pthread_mutex_t mutex;
+    IntQueue queue;
+} LockedQueue;
+
+static void lockedInit(LockedQueue* locked)
+{
+    pthread_mutex_init(&locked->mutex, NULL);
+    IntQueueInit(&locked->queue, (IntQueueOptions){ .defaultValue = -1 });
+    IntQueueReserve(&locked->queue, QUEUE_CAPACITY);
+}
+
+static void lockedFree(LockedQueue* locked)
+{
+    IntQueueFree(&locked->queue);
+    pthread_mutex_destroy(&locked->mutex);
+}
+
+static bool lockedPush(LockedQueue* locked, int value)
+{
+    bool pushed = false;
+    pthread_mutex_lock(&locked->mutex);
+    if (locked->queue.count < QUEUE_CAPACITY)
+    {
+        IntQueuePush(&locked->queue, value);
+        pushed = true;
+    }
+    pthread_mutex_unlock(&locked->mutex);
+    return pushed;
+}
+
+static bool lockedPop(LockedQueue* locked, int* value)
+{
+    bool popped = false;
+    pthread_mutex_lock(&locked->mutex);
+    if (locked->queue.count > 0)
+    {
+        *value = IntQueuePop(&locked->queue);
+        popped = true;
+    }
+    pthread_mutex_unlock(&locked->mutex);
+    return popped;
+}
+
+typedef struct
+{
+    QueueKind kind;
+    IntSpscQueue spsc;
+    IntMpmcQueue mpmc;
+    LockedQueue locked;
+} AnyQueue;
+
+static void anyInit(AnyQueue* queue, QueueKind kind)
+{
+    queue->kind = kind;
+    switch (kind)
+    {
+        case QueueKindSpsc: IntSpscQueueInit(&queue->spsc, (IntSpscQueueOptions){ .capacity = QUEUE_CAPACITY }); break;
+        case QueueKindMpmc: IntMpmcQueueInit(&queue->mpmc, (IntMpmcQueueOptions){ .capacity = QUEUE_CAPACITY }); break;
+        case QueueKindMutex: lockedInit(&queue->locked); break;
+    }
+}
+
+static void anyFree(AnyQueue* queue)
+{
+    switch (queue->kind)
+    {
+        case QueueKindSpsc: IntSpscQueueFree(&queue->spsc); break;
+        case QueueKindMpmc: IntMpmcQueueFree(&queue->mpmc); break;
+        case QueueKindMutex: lockedFree(&queue->locked); break;
+    }
+}
+
+static bool anyPush(AnyQueue* queue, int value)
+{
+    switch (queue->kind)
+    {
+        case QueueKindSpsc: return IntSpscQueuePush(&queue->spsc, value);
+        case QueueKindMpmc: return IntMpmcQueuePush(&queue->mpmc, value);
+        case QueueKindMutex: return lockedPush(&queue->locked, value);
+    }
+    return false;
+}
+
+static bool anyPop(AnyQueue* queue, int* value)
+{
+    switch (queue->kind)
+    {
+        case QueueKindSpsc: return IntSpscQueuePop(&queue->spsc, value);
+        case QueueKindMpmc: return IntMpmcQueuePop(&queue->mpmc, value);
+        case QueueKindMutex: return lockedPop(&queue->locked, value);
+    }
+    return false;
+}
+
+static int32_t anyPushN(AnyQueue* queue, int32_t count, int values[])
+{
+    switch (queue->kind)
+    {
+        case QueueKindSpsc: return IntSpscQueuePushN(&queue->spsc, count, values);
+        case QueueKindMpmc: return IntMpmcQueuePushN(&queue->mpmc, count, values);
+        case QueueKindMutex: return anyPush(queue, values[0]) ? 1 : 0;
+    }
+    return 0;
+}
+
+static int32_t anyPopN(AnyQueue* queue, int32_t count, int values[])
+{
+    switch (queue->kind)
+    {
+        case QueueKindSpsc: return IntSpscQueuePopN(&queue->spsc, count, values);
+        case QueueKindMpmc: return IntMpmcQueuePopN(&queue->mpmc, count, values);
+        case QueueKindMutex: return anyPop(queue, values) ? 1 : 0;
+    }
+    return 0;
+}
+
+typedef struct
+{
+    AnyQueue* queue;
+    int count;
+    int batch;
+    atomic_int* remaining;
+} ThroughputContext;
+
+static void* throughputProducer(void* arg)
+{
+    ThroughputContext* context = (ThroughputContext*)arg;
+    int values[BATCH_SIZE];
+
+    for (int i = 0; i < BATCH_SIZE; i++)
+        values[i] = i;
+
+    for (int sent = 0; sent < context->count;)
+    {
+        int n = context->count - sent < context->batch ? context->count - sent : context->batch;
+        int pushed = context->batch > 1 ? anyPushN(context->queue, n, values) : (anyPush(context->queue, sent) ? 1 : 0);
+
+        if (pushed == 0)
+            sched_yield();
+
+        sent += pushed;
+    }
+
+    return NULL;
+}
+
+static void* throughputConsumer(void* arg)
+{
+    ThroughputContext* context = (ThroughputContext*)arg;
+    int values[BATCH_SIZE];
+
+    while (atomic_load_explicit(context->remaining, memory_order_relaxed) > 0)
+    {
+        int popped = context->batch > 1 ? anyPopN(context->queue, context->batch, values) : (anyPop(context->queue, values) ? 1 : 0);
+
+        if (popped == 0)
+            sched_yield();
+        else
+            atomic_fetch_sub_explicit(context->remaining, popped, memory_order_relaxed);
+    }
+
+    return NULL;
+}
+
+static void benchThroughput(const char* name, QueueKind kind, int producers, int consumers, int batch)
+{
+    AnyQueue queue;
+    atomic_int remaining;
+    ThroughputContext producerContexts[MAX_THREADS];
+    ThroughputContext consumerContext;
+    pthread_t threads[MAX_THREADS * 2];
+    int perProducer = ITEM_COUNT / producers;
+
+    anyInit(&queue, kind);
+    atomic_init(&remaining, perProducer * producers);
+    consumerContext = (ThroughputContext){ &queue, 0, batch, &remaining };
+
+    uint64_t start = bench_nowNs();
+
+    for (int i = 0; i < producers; i++)
+    {
+        producerContexts[i] = (ThroughputContext){ &queue, perProducer, batch, &remaining };
+        pthread_create(&threads[i], NULL, throughputProducer, &producerContexts[i]);
+    }
+
+    for (int i = 0; i < consumers; i++)
+        pthread_create(&threads[producers + i], NULL, throughputConsumer, &consumerContext);
+
+    for (int i = 0; i < producers + consumers; i++)
+        pthread_join(threads[i], NULL);
+
+    bench_report(name, bench_nowNs() - start, (uint64_t)perProducer * (uint64_t)producers);
+    anyFree(&queue);
+}
+
+typedef struct
+{
+    AnyQueue* ping;
+    AnyQueue* pong;
+} PingPongContext;
+
+static void* pingPongEcho(void* arg)
+{
+    PingPongContext* context = (PingPongContext*)arg;
+    int value;
+
+    for (int i = 0; i < PING_PONG_COUNT; i++)
+    {
+        while (!anyPop(context->ping, &value))
+            sched_yield();
+
+        while (!anyPush(context->pong, value))
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+static void benchLatency(const char* name, QueueKind kind)
+{
+    AnyQueue ping;
+    AnyQueue pong;
+    PingPongContext context = { &ping, &pong };
+    pthread_t echo;
+    int value;
+
+    anyInit(&ping, kind);
+    anyInit(&pong, kind);
+    pthread_create(&echo, NULL, pingPongEcho, &context);
+
+    uint64_t start = bench_nowNs();
+
+    for (int i = 0; i < PING_PONG_COUNT; i++)
+    {
+        while (!anyPush(&ping, i))
+            sched_yield();
+
+        while (!anyPop(&pong, &value))
+            sched_yield();
+    }
+
+    uint64_t elapsed = bench_nowNs() - start;
+    pthread_join(echo, NULL);
+
+    /* one operation is one round trip, so ns/op is the round-trip latency */
+    bench_report(name, elapsed, PING_PONG_COUNT);
+    anyFree(&ping);
+    anyFree(&pong);
+}
+
+int main(void)
+{
+    printf("Throughput (%d items, capacity %d)\n", ITEM_COUNT, QUEUE_CAPACITY);
+    benchThroughput("spsc 1p/1c", QueueKindSpsc, 1, 1, 1);
+    benchThroughput("spsc 1p/1c PushN/PopN", QueueKindSpsc, 1, 1, BATCH_SIZE);
+    benchThroughput("mpmc 1p/1c", QueueKindMpmc, 1, 1, 1);
+    benchThroughput("mpmc 1p/1c PushN/PopN", QueueKindMpmc, 1, 1, BATCH_SIZE);
+    benchThroughput("mpmc 4p/4c", QueueKindMpmc, 4, 4, 1);
+    benchThroughput("mpmc 4p/4c PushN/PopN", QueueKindMpmc, 4, 4, BATCH_SIZE);
+    benchThroughput("mutex + queue.h 1p/1c", QueueKindMutex, 1, 1, 1);
+    benchThroughput("mutex + queue.h 4p/4c", QueueKindMutex, 4, 4, 1);
+
+    printf("\nRound-trip latency (%d ping-pongs)\n", PING_PONG_COUNT);
+    benchLatency("spsc", QueueKindSpsc);
+    benchLatency("mpmc", QueueKindMpmc);
+    benchLatency("mutex + queue.h", QueueKindMutex);
+
+    return 0;
+}
@@ -0,0 +1,162 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+
+#define SHL_MZ_THREAD_SAFE
+#define SHL_MZ_IMPLEMENTATION
+#include "../memzone.h"
+#include "bench_common.h"
+
+#define OPERATION_COUNT 4000000
+#define LIVE_COUNT 64
+#define SHARED_SLOT_COUNT 4096
+#define MAX_THREADS 32
+#define ZONE_SIZE (256 * 1024 * 1024)
+
+typedef enum
+{
+    AllocatorKindMemzone,
+    AllocatorKindMalloc
+} AllocatorKind;
+
+typedef struct
+{
+    AllocatorKind kind;
+    memzone_t* zone;
+    _Atomic(void*)* shared;
+    int operations;
+    uint32_t seed;
+} WorkerContext;
+
+static void* anyAlloc(WorkerContext* context, size_t size)
+{
+    if (context->kind == AllocatorKindMemzone)
+        return mz_alloc(context->zone, size);
+
+    return malloc(size);
+}
+
+static void anyFree(WorkerContext* context, void* p)
+{
+    if (context->kind == AllocatorKindMemzone)
+        mz_free(context->zone, p);
+    else
+        free(p);
+}
+
+/* every thread replaces a random entry of its own small set of live blocks */
+static void* localWorker(void* arg)
+{
+    WorkerContext* context = (WorkerContext*)arg;
+    void* live[LIVE_COUNT] = {0};
+    uint32_t seed = context->seed;
+
+    for (int i = 0; i < context->operations; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int slot = (int)((seed >> 16) % LIVE_COUNT);
+
+        if (live[slot] != NULL)
+            anyFree(context, live[slot]);
+
+        live[slot] = anyAlloc(context, 8 + (seed >> 8) % 249);
+        *(volatile char*)live[slot] = 1;
+    }
+
+    for (int i = 0; i < LIVE_COUNT; i++)
+    {
+        if (live[i] != NULL)
+            anyFree(context, live[i]);
+    }
+
+    if (context->kind == AllocatorKindMemzone)
+        mz_threadFlush(context->zone);
+
+    return NULL;
+}
+
+/* blocks go through a shared array, so most of them are freed by a thread that didn't allocate them */
+static void* sharedWorker(void* arg)
+{
+    WorkerContext* context = (WorkerContext*)arg;
+    uint32_t seed = context->seed;
+
+    for (int i = 0; i < context->operations; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int slot = (int)((seed >> 16) % SHARED_SLOT_COUNT);
+
+        void* p = anyAlloc(context, 8 + (seed >> 8) % 249);
+        *(volatile char*)p = 1;
+
+        void* old = atomic_exchange(&context->shared[slot], p);
+        if (old != NULL)
+            anyFree(context, old);
+    }
+
+    if (context->kind == AllocatorKindMemzone)
+        mz_threadFlush(context->zone);
+
+    return NULL;
+}
+
+static void benchThroughput(const char* name, AllocatorKind kind, void* (*worker)(void*), int threadCount)
+{
+    static _Atomic(void*) shared[SHARED_SLOT_COUNT];
+    WorkerContext contexts[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    char label[64];
+
+    memzone_t* zone = kind == AllocatorKindMemzone ? mz_init(ZONE_SIZE) : NULL;
+    for (int i = 0; i < SHARED_SLOT_COUNT; i++)
+        atomic_init(&shared[i], NULL);
+
+    uint64_t start = bench_nowNs();
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        contexts[i] = (WorkerContext){ kind, zone, shared, OPERATION_COUNT / threadCount, 12345u + (uint32_t)i * 7919u };
+        pthread_create(&threads[i], NULL, worker, &contexts[i]);
+    }
+
+    for (int i = 0; i < threadCount; i++)
+        pthread_join(threads[i], NULL);
+
+    snprintf(label, sizeof(label), "%s %2d threads", name, threadCount);
+    bench_report(label, bench_nowNs() - start, (uint64_t)(OPERATION_COUNT / threadCount) * (uint64_t)threadCount);
+
+    for (int i = 0; i < SHARED_SLOT_COUNT; i++)
+    {
+        void* p = atomic_load(&shared[i]);
+        if (p != NULL)
+            anyFree(&contexts[0], p);
+    }
+
+    mz_destroy(zone);
+}
+
+int main(void)
+{
+    static const int threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+    const size_t count = sizeof(threadCounts) / sizeof(threadCounts[0]);
+
+    printf("Alloc + free throughput, 8-256 bytes (%d operations, %d live blocks per thread)\n", OPERATION_COUNT, LIVE_COUNT);
+
+    for (size_t i = 0; i < count; i++)
+        benchThroughput("memzone.h thread-safe", AllocatorKindMemzone, localWorker, threadCounts[i]);
+
+    for (size_t i = 0; i < count; i++)
+        benchThroughput("malloc", AllocatorKindMalloc, localWorker, threadCounts[i]);
+
+    printf("Alloc + cross-thread free throughput, 8-256 bytes (%d operations, %d shared slots)\n", OPERATION_COUNT, SHARED_SLOT_COUNT);
+
+    for (size_t i = 0; i < count; i++)
+        benchThroughput("memzone.h thread-safe", AllocatorKindMemzone, sharedWorker, threadCounts[i]);
+
+    for (size_t i = 0; i < count; i++)
+        benchThroughput("malloc", AllocatorKindMalloc, sharedWorker, threadCounts[i]);
+
+    return 0;
+}
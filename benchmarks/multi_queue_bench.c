@@ -0,0 +1,145 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "../binary_heap.h"
+#include "../multi_queue.h"
+#include "bench_common.h"
+
+static int32_t compareInt(const int a, const int b)
+{
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+shlDeclareMultiQueue(IntMultiQueue, int)
+shlDefineMultiQueue(IntMultiQueue, int)
+shlDeclareBinaryHeap(IntHeap, int)
+shlDefineBinaryHeap(IntHeap, int)
+
+#define OPERATION_COUNT 4000000
+#define PREFILL_COUNT 100000
+#define MAX_THREADS 32
+
+typedef enum
+{
+    QueueKindMulti,
+    QueueKindMutex
+} QueueKind;
+
+typedef struct
+{
+    QueueKind kind;
+    IntMultiQueue multi;
+    pthread_mutex_t mutex;
+    IntHeap heap;
+} AnyQueue;
+
+typedef struct
+{
+    AnyQueue* queue;
+    int operations;
+    uint32_t seed;
+} WorkerContext;
+
+static void anyPush(AnyQueue* queue, int value)
+{
+    if (queue->kind == QueueKindMulti)
+    {
+        IntMultiQueuePush(&queue->multi, value);
+        return;
+    }
+
+    pthread_mutex_lock(&queue->mutex);
+    IntHeapPush(&queue->heap, value);
+    pthread_mutex_unlock(&queue->mutex);
+}
+
+static bool anyPop(AnyQueue* queue, int* value)
+{
+    if (queue->kind == QueueKindMulti)
+        return IntMultiQueuePop(&queue->multi, value);
+
+    bool popped = false;
+    pthread_mutex_lock(&queue->mutex);
+    if (queue->heap.count > 0)
+    {
+        *value = IntHeapPop(&queue->heap);
+        popped = true;
+    }
+    pthread_mutex_unlock(&queue->mutex);
+    return popped;
+}
+
+/* every pop is followed by a push of a larger key, like a scheduler rescheduling its tasks */
+static void* worker(void* arg)
+{
+    WorkerContext* context = (WorkerContext*)arg;
+    uint32_t seed = context->seed;
+    int value;
+
+    for (int i = 0; i < context->operations; i += 2)
+    {
+        seed = seed * 1103515245u + 12345u;
+
+        if (!anyPop(context->queue, &value))
+            value = 0;
+
+        anyPush(context->queue, value + 1 + (int)((seed >> 16) % 1024));
+    }
+
+    return NULL;
+}
+
+static void benchThroughput(const char* name, QueueKind kind, int threadCount, int relaxation)
+{
+    static AnyQueue queue;
+    WorkerContext contexts[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    char label[64];
+
+    queue.kind = kind;
+    IntMultiQueueInit(&queue.multi, (IntMultiQueueOptions){ .defaultValue = -1, .compareFn = compareInt, .threadCount = threadCount, .relaxation = relaxation });
+    IntHeapInit(&queue.heap, (IntHeapOptions){ .defaultValue = -1, .compareFn = compareInt });
+    pthread_mutex_init(&queue.mutex, NULL);
+
+    for (int i = 0; i < PREFILL_COUNT; i++)
+        anyPush(&queue, (i * 7919) % PREFILL_COUNT);
+
+    uint64_t start = bench_nowNs();
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        contexts[i] = (WorkerContext){ &queue, OPERATION_COUNT / threadCount, 12345u + (uint32_t)i * 7919u };
+        pthread_create(&threads[i], NULL, worker, &contexts[i]);
+    }
+
+    for (int i = 0; i < threadCount; i++)
+        pthread_join(threads[i], NULL);
+
+    snprintf(label, sizeof(label), "%s %2d threads", name, threadCount);
+    bench_report(label, bench_nowNs() - start, (uint64_t)(OPERATION_COUNT / threadCount) * (uint64_t)threadCount);
+
+    IntMultiQueueFree(&queue.multi);
+    IntHeapFree(&queue.heap);
+    pthread_mutex_destroy(&queue.mutex);
+}
+
+int main(void)
+{
+    static const int threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+    const size_t count = sizeof(threadCounts) / sizeof(threadCounts[0]);
+
+    printf("Pop + push throughput (%d operations, %d items prefilled)\n", OPERATION_COUNT, PREFILL_COUNT);
+
+    for (size_t i = 0; i < count; i++)
+        benchThroughput("multi_queue.h relaxation 2", QueueKindMulti, threadCounts[i], 2);
+
+    for (size_t i = 0; i < count; i++)
+        benchThroughput("multi_queue.h relaxation 4", QueueKindMulti, threadCounts[i], 4);
+
+    for (size_t i = 0; i < count; i++)
+        benchThroughput("mutex + binary_heap.h", QueueKindMutex, threadCounts[i], 1);
+
+    return 0;
+}
@@ -0,0 +1,220 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+
+#include "../binary_heap.h"
+#include "../radix_heap.h"
+#include "bench_common.h"
+
+typedef struct
+{
+    uint32_t distance;
+    int32_t node;
+} QueueEntry;
+
+static int32_t compareEntry(const QueueEntry a, const QueueEntry b)
+{
+    return a.distance < b.distance ? -1 : (a.distance > b.distance ? 1 : 0);
+}
+
+static int32_t compareDistance(const uint32_t a, const uint32_t b)
+{
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+shlDeclareBinaryHeap(EntryHeap, QueueEntry)
+shlDefineBinaryHeap(EntryHeap, QueueEntry)
+shlDeclareIndexedHeap(DistanceHeap, uint32_t)
+shlDefineIndexedHeap(DistanceHeap, uint32_t)
+shlDeclareRadixHeap(NodeRadixHeap, int32_t)
+shlDefineRadixHeap(NodeRadixHeap, int32_t)
+
+#define GRID_SIZE 1024
+#define NODE_COUNT (GRID_SIZE * GRID_SIZE)
+
+static uint8_t g_cost[NODE_COUNT];
+static uint32_t g_best[NODE_COUNT];
+
+static const int g_dx[] = { 1, -1, 0, 0 };
+static const int g_dy[] = { 0, 0, 1, -1 };
+
+static int32_t neighbor(int32_t node, int direction)
+{
+    int x = node % GRID_SIZE + g_dx[direction];
+    int y = node / GRID_SIZE + g_dy[direction];
+
+    if (x < 0 || y < 0 || x >= GRID_SIZE || y >= GRID_SIZE)
+        return -1;
+
+    return y * GRID_SIZE + x;
+}
+
+static void resetDistances(void)
+{
+    for (int32_t i = 0; i < NODE_COUNT; i++)
+        g_best[i] = UINT32_MAX;
+
+    g_best[0] = 0;
+}
+
+static uint64_t checksum(void)
+{
+    uint64_t sum = 0;
+
+    for (int32_t i = 0; i < NODE_COUNT; i++)
+        sum += g_best[i];
+
+    return sum;
+}
+
+/* lazy deletion: a node is pushed again on every improvement and stale entries are skipped */
+static uint64_t dijkstraBinaryHeap(int32_t arity, uint64_t* pops)
+{
+    EntryHeap open;
+    EntryHeapInit(&open, (EntryHeapOptions){ .defaultValue = { 0, -1 }, .compareFn = compareEntry, .arity = arity });
+
+    resetDistances();
+    EntryHeapPush(&open, (QueueEntry){ 0, 0 });
+
+    while (open.count > 0)
+    {
+        QueueEntry entry = EntryHeapPop(&open);
+        (*pops)++;
+
+        if (entry.distance > g_best[entry.node])
+            continue;
+
+        for (int d = 0; d < 4; d++)
+        {
+            int32_t next = neighbor(entry.node, d);
+            if (next < 0)
+                continue;
+
+            uint32_t distance = entry.distance + g_cost[next];
+            if (distance < g_best[next])
+            {
+                g_best[next] = distance;
+                EntryHeapPush(&open, (QueueEntry){ distance, next });
+            }
+        }
+    }
+
+    EntryHeapFree(&open);
+    return checksum();
+}
+
+static uint64_t dijkstraIndexedHeap(int32_t arity, uint64_t* pops)
+{
+    DistanceHeap open;
+    DistanceHeapInit(&open, (DistanceHeapOptions){ .defaultValue = UINT32_MAX, .compareFn = compareDistance, .arity = arity });
+
+    resetDistances();
+    DistanceHeapPushWithHandle(&open, 0, 0);
+
+    while (open.count > 0)
+    {
+        int32_t node;
+        uint32_t current = DistanceHeapPop(&open, &node);
+        (*pops)++;
+
+        for (int d = 0; d < 4; d++)
+        {
+            int32_t next = neighbor(node, d);
+            if (next < 0)
+                continue;
+
+            uint32_t distance = current + g_cost[next];
+            if (distance < g_best[next])
+            {
+                g_best[next] = distance;
+                DistanceHeapPushWithHandle(&open, next, distance);
+            }
+        }
+    }
+
+    DistanceHeapFree(&open);
+    return checksum();
+}
+
+static uint64_t dijkstraRadixHeap(uint64_t* pops)
+{
+    NodeRadixHeap open;
+    NodeRadixHeapInit(&open, (NodeRadixHeapOptions){ .defaultValue = -1 });
+
+    resetDistances();
+    NodeRadixHeapPush(&open, 0, 0);
+
+    while (open.count > 0)
+    {
+        uint32_t current;
+        int32_t node = NodeRadixHeapPop(&open, &current);
+        (*pops)++;
+
+        if (current > g_best[node])
+            continue;
+
+        for (int d = 0; d < 4; d++)
+        {
+            int32_t next = neighbor(node, d);
+            if (next < 0)
+                continue;
+
+            uint32_t distance = current + g_cost[next];
+            if (distance < g_best[next])
+            {
+                g_best[next] = distance;
+                NodeRadixHeapPush(&open, distance, next);
+            }
+        }
+    }
+
+    NodeRadixHeapFree(&open);
+    return checksum();
+}
+
+int main(void)
+{
+    uint32_t seed = 12345u;
+    for (int32_t i = 0; i < NODE_COUNT; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        g_cost[i] = (uint8_t)(1 + (seed >> 16) % 9);
+    }
+
+    printf("Dijkstra on a %dx%d grid, weights 1-9 (one op is one Pop)\n", GRID_SIZE, GRID_SIZE);
+
+    uint64_t pops = 0;
+    uint64_t start = bench_nowNs();
+    uint64_t expected = dijkstraBinaryHeap(2, &pops);
+    bench_report("binary_heap.h 2-ary, lazy deletion", bench_nowNs() - start, pops);
+
+    pops = 0;
+    start = bench_nowNs();
+    uint64_t result = dijkstraBinaryHeap(4, &pops);
+    bench_report("binary_heap.h 4-ary, lazy deletion", bench_nowNs() - start, pops);
+    if (result != expected)
+        printf("  checksum mismatch\n");
+
+    pops = 0;
+    start = bench_nowNs();
+    result = dijkstraIndexedHeap(2, &pops);
+    bench_report("indexed heap 2-ary, decrease-key", bench_nowNs() - start, pops);
+    if (result != expected)
+        printf("  checksum mismatch\n");
+
+    pops = 0;
+    start = bench_nowNs();
+    result = dijkstraIndexedHeap(4, &pops);
+    bench_report("indexed heap 4-ary, decrease-key", bench_nowNs() - start, pops);
+    if (result != expected)
+        printf("  checksum mismatch\n");
+
+    pops = 0;
+    start = bench_nowNs();
+    result = dijkstraRadixHeap(&pops);
+    bench_report("radix_heap.h, lazy deletion", bench_nowNs() - start, pops);
+    if (result != expected)
+        printf("  checksum mismatch\n");
+
+    return 0;
+}
@@ -0,0 +1,207 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include "../queue.h"
+#include "../work_stealing_deque.h"
+#include "bench_common.h"
+
+shlDeclareWorkStealingDeque(TaskDeque, int)
+shlDefineWorkStealingDeque(TaskDeque, int)
+shlDeclareQueue(TaskQueue, int)
+shlDefineQueue(TaskQueue, int)
+
+/* a task is the depth of its subtree, every task above depth 0 forks two */
+#define TREE_DEPTH 20
+#define LEAF_WORK 200
+#define FLUSH_INTERVAL 256
+#define MAX_THREADS 32
+
+typedef enum
+{
+    SchedulerStealing,
+    SchedulerMutex
+} SchedulerKind;
+
+typedef struct
+{
+    SchedulerKind kind;
+    int threadCount;
+    TaskDeque deques[MAX_THREADS];
+    pthread_mutex_t mutex;
+    TaskQueue shared;
+    atomic_llong pending;
+    atomic_ullong checksum;
+} Scheduler;
+
+typedef struct
+{
+    Scheduler* scheduler;
+    int index;
+} WorkerContext;
+
+static uint64_t leafWork(int seed)
+{
+    uint64_t x = (uint64_t)seed * 0x9E3779B97F4A7C15ull + 1;
+
+    for (int i = 0; i < LEAF_WORK; i++)
+    {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+
+    return x;
+}
+
+static void schedulerPush(Scheduler* scheduler, int index, int task)
+{
+    if (scheduler->kind == SchedulerStealing)
+    {
+        TaskDequePush(&scheduler->deques[index], task);
+        return;
+    }
+
+    pthread_mutex_lock(&scheduler->mutex);
+    TaskQueuePush(&scheduler->shared, task);
+    pthread_mutex_unlock(&scheduler->mutex);
+}
+
+static bool schedulerTake(Scheduler* scheduler, int index, uint32_t* random, int* task)
+{
+    if (scheduler->kind == SchedulerMutex)
+    {
+        bool taken = false;
+        pthread_mutex_lock(&scheduler->mutex);
+        if (scheduler->shared.count > 0)
+        {
+            *task = TaskQueuePopBack(&scheduler->shared);
+            taken = true;
+        }
+        pthread_mutex_unlock(&scheduler->mutex);
+        return taken;
+    }
+
+    if (TaskDequePop(&scheduler->deques[index], task))
+        return true;
+
+    for (int attempt = 0; attempt < scheduler->threadCount; attempt++)
+    {
+        *random ^= *random << 13;
+        *random ^= *random >> 17;
+        *random ^= *random << 5;
+
+        int victim = (int)(*random % (uint32_t)scheduler->threadCount);
+        if (victim != index && TaskDequeSteal(&scheduler->deques[victim], task))
+            return true;
+    }
+
+    return false;
+}
+
+static void* worker(void* arg)
+{
+    WorkerContext* context = (WorkerContext*)arg;
+    Scheduler* scheduler = context->scheduler;
+    uint32_t random = 2463534242u + (uint32_t)context->index * 7919u;
+    uint64_t checksum = 0;
+    long long completed = 0;
+    int task;
+
+    for (;;)
+    {
+        if (schedulerTake(scheduler, context->index, &random, &task))
+        {
+            if (task > 0)
+            {
+                schedulerPush(scheduler, context->index, task - 1);
+                schedulerPush(scheduler, context->index, task - 1);
+            }
+            else
+            {
+                checksum += leafWork((int)completed);
+            }
+
+            if (++completed == FLUSH_INTERVAL)
+            {
+                atomic_fetch_sub_explicit(&scheduler->pending, completed, memory_order_relaxed);
+                completed = 0;
+            }
+
+            continue;
+        }
+
+        if (completed > 0)
+        {
+            atomic_fetch_sub_explicit(&scheduler->pending, completed, memory_order_relaxed);
+            completed = 0;
+        }
+
+        if (atomic_load_explicit(&scheduler->pending, memory_order_relaxed) == 0)
+            break;
+
+        sched_yield();
+    }
+
+    atomic_fetch_add_explicit(&scheduler->checksum, checksum, memory_order_relaxed);
+    return NULL;
+}
+
+static void benchForkJoin(const char* name, SchedulerKind kind, int threadCount)
+{
+    static Scheduler scheduler;
+    WorkerContext contexts[MAX_THREADS];
+    pthread_t threads[MAX_THREADS];
+    long long taskCount = (2ll << TREE_DEPTH) - 1;
+    char label[64];
+
+    scheduler.kind = kind;
+    scheduler.threadCount = threadCount;
+    atomic_init(&scheduler.pending, taskCount);
+    atomic_init(&scheduler.checksum, 0);
+
+    for (int i = 0; i < threadCount; i++)
+        TaskDequeInit(&scheduler.deques[i], (TaskDequeOptions){ .capacity = 64 });
+
+    pthread_mutex_init(&scheduler.mutex, NULL);
+    TaskQueueInit(&scheduler.shared, (TaskQueueOptions){ .defaultValue = -1 });
+
+    schedulerPush(&scheduler, 0, TREE_DEPTH);
+
+    uint64_t start = bench_nowNs();
+
+    for (int i = 0; i < threadCount; i++)
+    {
+        contexts[i] = (WorkerContext){ &scheduler, i };
+        pthread_create(&threads[i], NULL, worker, &contexts[i]);
+    }
+
+    for (int i = 0; i < threadCount; i++)
+        pthread_join(threads[i], NULL);
+
+    snprintf(label, sizeof(label), "%s %2d threads", name, threadCount);
+    bench_report(label, bench_nowNs() - start, (uint64_t)taskCount);
+
+    for (int i = 0; i < threadCount; i++)
+        TaskDequeFree(&scheduler.deques[i]);
+
+    TaskQueueFree(&scheduler.shared);
+    pthread_mutex_destroy(&scheduler.mutex);
+}
+
+int main(void)
+{
+    static const int threadCounts[] = { 1, 2, 4, 8, 16, 32 };
+
+    printf("Fork-join task tree (depth %d, %lld tasks)\n", TREE_DEPTH, (2ll << TREE_DEPTH) - 1);
+
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++)
+        benchForkJoin("work-stealing deques", SchedulerStealing, threadCounts[i]);
+
+    for (size_t i = 0; i < sizeof(threadCounts) / sizeof(threadCounts[0]); i++)
+        benchForkJoin("mutex + queue.h deque", SchedulerMutex, threadCounts[i]);
+
+    return 0;
+}
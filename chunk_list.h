@@ -0,0 +1,269 @@
+/*
+    chunk_list.h - acoto87 (acoto87@gmail.com)
+
+    MIT License
+
+    Copyright (c) 2018 Alejandro Coto Gutiérrez
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Single-header macro library to declare and define strongly typed
+    append-only lists stored in fixed-size chunks, so items never move once
+    added.
+
+    USAGE
+    Declare a chunk list type with shlDeclareChunkList(name, type), then
+    define it once with shlDefineChunkList(name, type) in a C source file.
+
+    CUSTOMISATION
+    Provide a default value for out-of-range reads, an equality function for
+    search-related helpers, a free function when the item type owns
+    resources, and optionally the number of items per chunk. The chunk size is
+    rounded up to a power of two so indexing is a shift and a mask.
+
+    NOTES
+    Growing the list allocates a new chunk and only reallocates the table of
+    chunk pointers, so pointers returned by GetPtr stay valid until the item
+    is removed or the list is freed. Clear keeps the chunks allocated for
+    reuse.
+*/
+
+#ifndef SHL_CHUNK_LIST_H
+#define SHL_CHUNK_LIST_H
+
+#include "shl_internal.h"
+
+#define SHL__CHUNK_LIST_DEFAULT_CHUNK_SIZE 1024
+
+#define shlDeclareChunkList(typeName, itemType) \
+    typedef struct \
+    { \
+        itemType defaultValue; \
+        bool (*equalsFn)(const itemType item1, const itemType item2); \
+        void (*freeFn)(itemType item); \
+        int32_t chunkSize; \
+    } typeName ## Options; \
+    \
+    typedef struct \
+    { \
+        int32_t count; \
+        int32_t chunkShift; \
+        int32_t chunkCount; \
+        int32_t chunkCapacity; \
+        bool (*equalsFn)(const itemType item1, const itemType item2); \
+        void (*freeFn)(itemType item); \
+        itemType defaultValue; \
+        itemType** chunks; \
+    } typeName; \
+    \
+    void typeName ## Init(typeName* list, typeName ## Options options); \
+    void typeName ## Free(typeName* list); \
+    void typeName ## Add(typeName* list, itemType value); \
+    void typeName ## AddRange(typeName* list, int32_t count, itemType values[]); \
+    int32_t typeName ## IndexOf(typeName* list, itemType value); \
+    itemType typeName ## Get(typeName* list, int32_t index); \
+    itemType* typeName ## GetPtr(typeName* list, int32_t index); \
+    void typeName ## Set(typeName* list, int32_t index, itemType value); \
+    bool typeName ## Contains(typeName* list, itemType value); \
+    void typeName ## RemoveLast(typeName* list); \
+    void typeName ## Clear(typeName* list); \
+    void typeName ## CopyTo(typeName* list, itemType array[], int32_t index);
+
+#define shlDefineChunkList(typeName, itemType) \
+    void typeName ## __addChunk(typeName* list) \
+    { \
+        if (list->chunkCount == list->chunkCapacity) \
+            shl__resizeArray((void**)&list->chunks, &list->chunkCapacity, list->chunkCount + 1, sizeof(itemType*), 0.0f); \
+        \
+        list->chunks[list->chunkCount] = (itemType *)SHL_MALLOC(((size_t)1 << list->chunkShift) * sizeof(itemType)); \
+        list->chunkCount++; \
+    } \
+    \
+    void typeName ## Init(typeName* list, typeName ## Options options) \
+    { \
+        int32_t chunkSize = options.chunkSize > 0 ? options.chunkSize : SHL__CHUNK_LIST_DEFAULT_CHUNK_SIZE; \
+        \
+        list->defaultValue = options.defaultValue; \
+        list->equalsFn = options.equalsFn; \
+        list->freeFn = options.freeFn; \
+        list->chunkShift = 0; \
+        while (list->chunkShift < 30 && ((int32_t)1 << list->chunkShift) < chunkSize) \
+            list->chunkShift++; \
+        \
+        list->count = 0; \
+        list->chunkCount = 0; \
+        list->chunkCapacity = SHL__INITIAL_CAPACITY; \
+        list->chunks = (itemType **)SHL_MALLOC((size_t)list->chunkCapacity * sizeof(itemType*)); \
+    } \
+    \
+    void typeName ## Free(typeName* list) \
+    { \
+        if (!list->chunks) \
+            return; \
+        \
+        typeName ## Clear(list); \
+        \
+        for(int32_t i = 0; i < list->chunkCount; i++) \
+            SHL_FREE(list->chunks[i]); \
+        \
+        SHL_FREE(list->chunks); \
+        list->chunks = 0; \
+        list->chunkCount = 0; \
+    } \
+    \
+    void typeName ## Add(typeName* list, itemType value) \
+    { \
+        if (!list->chunks) \
+            return; \
+        \
+        int32_t chunkIndex = list->count >> list->chunkShift; \
+        if (chunkIndex == list->chunkCount) \
+            typeName ## __addChunk(list); \
+        \
+        list->chunks[chunkIndex][list->count & (((int32_t)1 << list->chunkShift) - 1)] = value; \
+        list->count++; \
+    } \
+    \
+    void typeName ## AddRange(typeName* list, int32_t count, itemType values[]) \
+    { \
+        if (!list->chunks) \
+            return; \
+        \
+        int32_t chunkSize = (int32_t)1 << list->chunkShift; \
+        int32_t copied = 0; \
+        \
+        while (copied < count) \
+        { \
+            int32_t chunkIndex = list->count >> list->chunkShift; \
+            int32_t offset = list->count & (chunkSize - 1); \
+            int32_t length = chunkSize - offset; \
+            \
+            if (length > count - copied) \
+                length = count - copied; \
+            \
+            if (chunkIndex == list->chunkCount) \
+                typeName ## __addChunk(list); \
+            \
+            memcpy(list->chunks[chunkIndex] + offset, values + copied, (size_t)length * sizeof(itemType)); \
+            list->count += length; \
+            copied += length; \
+        } \
+    } \
+    \
+    itemType* typeName ## GetPtr(typeName* list, int32_t index) \
+    { \
+        if (!list->chunks) \
+            return 0; \
+        \
+        if (index < 0 || index >= list->count) \
+            return 0; \
+        \
+        return &list->chunks[index >> list->chunkShift][index & (((int32_t)1 << list->chunkShift) - 1)]; \
+    } \
+    \
+    itemType typeName ## Get(typeName* list, int32_t index) \
+    { \
+        itemType* item = typeName ## GetPtr(list, index); \
+        return item ? *item : list->defaultValue; \
+    } \
+    \
+    void typeName ## Set(typeName* list, int32_t index, itemType value) \
+    { \
+        itemType* item = typeName ## GetPtr(list, index); \
+        if (!item) \
+            return; \
+        \
+        if (list->freeFn) \
+            list->freeFn(*item); \
+        \
+        *item = value; \
+    } \
+    \
+    int32_t typeName ## IndexOf(typeName* list, itemType value) \
+    { \
+        if (!list->chunks) \
+            return -1; \
+        \
+        if (!list->equalsFn) \
+            return -1; \
+        \
+        int32_t chunkSize = (int32_t)1 << list->chunkShift; \
+        for(int32_t i = 0; i < list->count; i += chunkSize) \
+        { \
+            itemType* chunk = list->chunks[i >> list->chunkShift]; \
+            int32_t length = list->count - i < chunkSize ? list->count - i : chunkSize; \
+            \
+            for(int32_t j = 0; j < length; j++) \
+            { \
+                if (list->equalsFn(chunk[j], value)) \
+                    return i + j; \
+            } \
+        } \
+        \
+        return -1; \
+    } \
+    \
+    bool typeName ## Contains(typeName* list, itemType value) \
+    { \
+        return typeName ## IndexOf(list, value) >= 0; \
+    } \
+    \
+    void typeName ## RemoveLast(typeName* list) \
+    { \
+        itemType* item = typeName ## GetPtr(list, list->count - 1); \
+        if (!item) \
+            return; \
+        \
+        if (list->freeFn) \
+            list->freeFn(*item); \
+        \
+        list->count--; \
+    } \
+    \
+    void typeName ## Clear(typeName* list) \
+    { \
+        if (!list->chunks) \
+            return; \
+        \
+        if (list->freeFn) \
+        { \
+            for(int32_t i = 0; i < list->count; i++) \
+                list->freeFn(*typeName ## GetPtr(list, i)); \
+        } \
+        \
+        list->count = 0; \
+    } \
+    \
+    void typeName ## CopyTo(typeName* list, itemType array[], int32_t index) \
+    { \
+        if (!list->chunks) \
+            return; \
+        \
+        if (index < 0) \
+            return; \
+        \
+        int32_t chunkSize = (int32_t)1 << list->chunkShift; \
+        for(int32_t i = 0; i < list->count; i += chunkSize) \
+        { \
+            int32_t length = list->count - i < chunkSize ? list->count - i : chunkSize; \
+            memcpy(array + index + i, list->chunks[i >> list->chunkShift], (size_t)length * sizeof(itemType)); \
+        } \
+    }
+
+#endif // SHL_CHUNK_LIST_H
@@ -0,0 +1,423 @@
+/*
+    concurrent_queue.h - acoto87 (acoto87@gmail.com)
+
+    MIT License
+
+    Copyright (c) 2018 Alejandro Coto Gutiérrez
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Single-header macro library to declare and define strongly typed, bounded,
+    lock-free queues for passing items between threads.
+
+    USAGE
+    Declare a single-producer/single-consumer queue with
+    shlDeclareSpscQueue(name, type) and define it once with
+    shlDefineSpscQueue(name, type) in a C source file. Use
+    shlDeclareMpmcQueue(name, type) and shlDefineMpmcQueue(name, type) for a
+    queue shared by any number of producers and consumers. Both require C11
+    atomics.
+
+    CUSTOMISATION
+    Provide the capacity, which is rounded up to a power of two, and an
+    optional free function used by Free to release items still queued.
+    Values are stored by copy.
+
+    NOTES
+    The SPSC queue keeps head and tail on separate cache lines and publishes
+    them with acquire/release stores; each side also caches the other side's
+    index to avoid touching its cache line on every call. The MPMC queue is
+    Dmitry Vyukov's bounded queue: every cell carries a sequence number that
+    tells producers and consumers whether the cell is free for their lap.
+    Push and Pop never block; they return false when the queue is full or
+    empty. Init and Free are not thread-safe.
+*/
+
+#ifndef SHL_CONCURRENT_QUEUE_H
+#define SHL_CONCURRENT_QUEUE_H
+
+#include <stdatomic.h>
+
+#include "shl_internal.h"
+
+#define SHL__CONCURRENT_QUEUE_DEFAULT_CAPACITY 1024
+
+#define shlDeclareSpscQueue(typeName, itemType) \
+    typedef struct \
+    { \
+        int32_t capacity; \
+        void (*freeFn)(itemType item); \
+    } typeName ## Options; \
+    \
+    typedef struct \
+    { \
+        _Alignas(SHL__CACHE_LINE_SIZE) atomic_size_t head; \
+        size_t cachedTail; \
+        _Alignas(SHL__CACHE_LINE_SIZE) atomic_size_t tail; \
+        size_t cachedHead; \
+        _Alignas(SHL__CACHE_LINE_SIZE) int32_t capacity; \
+        size_t mask; \
+        void (*freeFn)(itemType item); \
+        itemType* items; \
+    } typeName; \
+    \
+    void typeName ## Init(typeName* queue, typeName ## Options options); \
+    void typeName ## Free(typeName* queue); \
+    bool typeName ## Push(typeName* queue, itemType value); \
+    bool typeName ## Pop(typeName* queue, itemType* value); \
+    int32_t typeName ## PushN(typeName* queue, int32_t count, itemType values[]); \
+    int32_t typeName ## PopN(typeName* queue, int32_t count, itemType values[]); \
+    int32_t typeName ## Count(typeName* queue);
+
+#define shlDefineSpscQueue(typeName, itemType) \
+    void typeName ## Init(typeName* queue, typeName ## Options options) \
+    { \
+        int32_t capacity = options.capacity > 0 ? options.capacity : SHL__CONCURRENT_QUEUE_DEFAULT_CAPACITY; \
+        \
+        queue->capacity = shl__nextPowerOfTwo(capacity); \
+        queue->mask = (size_t)queue->capacity - 1; \
+        queue->freeFn = options.freeFn; \
+        queue->cachedHead = 0; \
+        queue->cachedTail = 0; \
+        atomic_init(&queue->head, 0); \
+        atomic_init(&queue->tail, 0); \
+        queue->items = (itemType *)SHL_MALLOC((size_t)queue->capacity * sizeof(itemType)); \
+    } \
+    \
+    void typeName ## Free(typeName* queue) \
+    { \
+        if (!queue->items) \
+            return; \
+        \
+        if (queue->freeFn) \
+        { \
+            itemType item; \
+            while (typeName ## Pop(queue, &item)) \
+                queue->freeFn(item); \
+        } \
+        \
+        SHL_FREE(queue->items); \
+        queue->items = 0; \
+    } \
+    \
+    bool typeName ## Push(typeName* queue, itemType value) \
+    { \
+        size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed); \
+        \
+        if (tail - queue->cachedHead > queue->mask) \
+        { \
+            queue->cachedHead = atomic_load_explicit(&queue->head, memory_order_acquire); \
+            if (tail - queue->cachedHead > queue->mask) \
+                return false; \
+        } \
+        \
+        queue->items[tail & queue->mask] = value; \
+        atomic_store_explicit(&queue->tail, tail + 1, memory_order_release); \
+        return true; \
+    } \
+    \
+    bool typeName ## Pop(typeName* queue, itemType* value) \
+    { \
+        size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed); \
+        \
+        if (head == queue->cachedTail) \
+        { \
+            queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire); \
+            if (head == queue->cachedTail) \
+                return false; \
+        } \
+        \
+        *value = queue->items[head & queue->mask]; \
+        atomic_store_explicit(&queue->head, head + 1, memory_order_release); \
+        return true; \
+    } \
+    \
+    int32_t typeName ## PushN(typeName* queue, int32_t count, itemType values[]) \
+    { \
+        size_t tail = atomic_load_explicit(&queue->tail, memory_order_relaxed); \
+        size_t available = (size_t)queue->capacity - (tail - queue->cachedHead); \
+        \
+        if (count <= 0) \
+            return 0; \
+        \
+        if (available < (size_t)count) \
+        { \
+            queue->cachedHead = atomic_load_explicit(&queue->head, memory_order_acquire); \
+            available = (size_t)queue->capacity - (tail - queue->cachedHead); \
+        } \
+        \
+        size_t n = available < (size_t)count ? available : (size_t)count; \
+        size_t index = tail & queue->mask; \
+        size_t first = n < (size_t)queue->capacity - index ? n : (size_t)queue->capacity - index; \
+        \
+        memcpy(queue->items + index, values, first * sizeof(itemType)); \
+        memcpy(queue->items, values + first, (n - first) * sizeof(itemType)); \
+        atomic_store_explicit(&queue->tail, tail + n, memory_order_release); \
+        return (int32_t)n; \
+    } \
+    \
+    int32_t typeName ## PopN(typeName* queue, int32_t count, itemType values[]) \
+    { \
+        size_t head = atomic_load_explicit(&queue->head, memory_order_relaxed); \
+        size_t available = queue->cachedTail - head; \
+        \
+        if (count <= 0) \
+            return 0; \
+        \
+        if (available < (size_t)count) \
+        { \
+            queue->cachedTail = atomic_load_explicit(&queue->tail, memory_order_acquire); \
+            available = queue->cachedTail - head; \
+        } \
+        \
+        size_t n = available < (size_t)count ? available : (size_t)count; \
+        size_t index = head & queue->mask; \
+        size_t first = n < (size_t)queue->capacity - index ? n : (size_t)queue->capacity - index; \
+        \
+        memcpy(values, queue->items + index, first * sizeof(itemType)); \
+        memcpy(values + first, queue->items, (n - first) * sizeof(itemType)); \
+        atomic_store_explicit(&queue->head, head + n, memory_order_release); \
+        return (int32_t)n; \
+    } \
+    \
+    int32_t typeName ## Count(typeName* queue) \
+    { \
+        size_t head = atomic_load_explicit(&queue->head, memory_order_acquire); \
+        size_t tail = atomic_load_explicit(&queue->tail, memory_order_acquire); \
+        return tail > head ? (int32_t)(tail - head) : 0; \
+    }
+
+#define shlDeclareMpmcQueue(typeName, itemType) \
+    typedef struct \
+    { \
+        int32_t capacity; \
+        void (*freeFn)(itemType item); \
+    } typeName ## Options; \
+    \
+    typedef struct \
+    { \
+        atomic_size_t sequence; \
+        itemType value; \
+    } typeName ## __Cell; \
+    \
+    typedef struct \
+    { \
+        _Alignas(SHL__CACHE_LINE_SIZE) atomic_size_t enqueuePos; \
+        _Alignas(SHL__CACHE_LINE_SIZE) atomic_size_t dequeuePos; \
+        _Alignas(SHL__CACHE_LINE_SIZE) int32_t capacity; \
+        size_t mask; \
+        void (*freeFn)(itemType item); \
+        typeName ## __Cell* cells; \
+    } typeName; \
+    \
+    void typeName ## Init(typeName* queue, typeName ## Options options); \
+    void typeName ## Free(typeName* queue); \
+    bool typeName ## Push(typeName* queue, itemType value); \
+    bool typeName ## Pop(typeName* queue, itemType* value); \
+    int32_t typeName ## PushN(typeName* queue, int32_t count, itemType values[]); \
+    int32_t typeName ## PopN(typeName* queue, int32_t count, itemType values[]); \
+    int32_t typeName ## Count(typeName* queue);
+
+#define shlDefineMpmcQueue(typeName, itemType) \
+    void typeName ## Init(typeName* queue, typeName ## Options options) \
+    { \
+        int32_t capacity = options.capacity > 1 ? options.capacity : SHL__CONCURRENT_QUEUE_DEFAULT_CAPACITY; \
+        \
+        queue->capacity = shl__nextPowerOfTwo(capacity); \
+        queue->mask = (size_t)queue->capacity - 1; \
+        queue->freeFn = options.freeFn; \
+        queue->cells = (typeName ## __Cell *)SHL_MALLOC((size_t)queue->capacity * sizeof(typeName ## __Cell)); \
+        \
+        for(int32_t i = 0; i < queue->capacity; i++) \
+            atomic_init(&queue->cells[i].sequence, (size_t)i); \
+        \
+        atomic_init(&queue->enqueuePos, 0); \
+        atomic_init(&queue->dequeuePos, 0); \
+    } \
+    \
+    void typeName ## Free(typeName* queue) \
+    { \
+        if (!queue->cells) \
+            return; \
+        \
+        if (queue->freeFn) \
+        { \
+            itemType item; \
+            while (typeName ## Pop(queue, &item)) \
+                queue->freeFn(item); \
+        } \
+        \
+        SHL_FREE(queue->cells); \
+        queue->cells = 0; \
+    } \
+    \
+    bool typeName ## Push(typeName* queue, itemType value) \
+    { \
+        typeName ## __Cell* cell; \
+        size_t pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed); \
+        \
+        for (;;) \
+        { \
+            cell = &queue->cells[pos & queue->mask]; \
+            size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire); \
+            intptr_t diff = (intptr_t)sequence - (intptr_t)pos; \
+            \
+            if (diff == 0) \
+            { \
+                if (atomic_compare_exchange_weak_explicit(&queue->enqueuePos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) \
+                    break; \
+            } \
+            else if (diff < 0) \
+            { \
+                return false; \
+            } \
+            else \
+            { \
+                pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed); \
+            } \
+        } \
+        \
+        cell->value = value; \
+        atomic_store_explicit(&cell->sequence, pos + 1, memory_order_release); \
+        return true; \
+    } \
+    \
+    bool typeName ## Pop(typeName* queue, itemType* value) \
+    { \
+        typeName ## __Cell* cell; \
+        size_t pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed); \
+        \
+        for (;;) \
+        { \
+            cell = &queue->cells[pos & queue->mask]; \
+            size_t sequence = atomic_load_explicit(&cell->sequence, memory_order_acquire); \
+            intptr_t diff = (intptr_t)sequence - (intptr_t)(pos + 1); \
+            \
+            if (diff == 0) \
+            { \
+                if (atomic_compare_exchange_weak_explicit(&queue->dequeuePos, &pos, pos + 1, memory_order_relaxed, memory_order_relaxed)) \
+                    break; \
+            } \
+            else if (diff < 0) \
+            { \
+                return false; \
+            } \
+            else \
+            { \
+                pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed); \
+            } \
+        } \
+        \
+        *value = cell->value; \
+        atomic_store_explicit(&cell->sequence, pos + queue->mask + 1, memory_order_release); \
+        return true; \
+    } \
+    \
+    int32_t typeName ## PushN(typeName* queue, int32_t count, itemType values[]) \
+    { \
+        size_t pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed); \
+        \
+        while (count > 0) \
+        { \
+            int32_t available = 0; \
+            while (available < count) \
+            { \
+                size_t sequence = atomic_load_explicit(&queue->cells[(pos + (size_t)available) & queue->mask].sequence, memory_order_acquire); \
+                if (sequence != pos + (size_t)available) \
+                    break; \
+                \
+                available++; \
+            } \
+            \
+            if (available == 0) \
+            { \
+                size_t sequence = atomic_load_explicit(&queue->cells[pos & queue->mask].sequence, memory_order_acquire); \
+                if ((intptr_t)sequence - (intptr_t)pos < 0) \
+                    return 0; \
+                \
+                pos = atomic_load_explicit(&queue->enqueuePos, memory_order_relaxed); \
+                continue; \
+            } \
+            \
+            if (atomic_compare_exchange_weak_explicit(&queue->enqueuePos, &pos, pos + (size_t)available, memory_order_relaxed, memory_order_relaxed)) \
+            { \
+                for(int32_t i = 0; i < available; i++) \
+                { \
+                    typeName ## __Cell* cell = &queue->cells[(pos + (size_t)i) & queue->mask]; \
+                    cell->value = values[i]; \
+                    atomic_store_explicit(&cell->sequence, pos + (size_t)i + 1, memory_order_release); \
+                } \
+                \
+                return available; \
+            } \
+        } \
+        \
+        return 0; \
+    } \
+    \
+    int32_t typeName ## PopN(typeName* queue, int32_t count, itemType values[]) \
+    { \
+        size_t pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed); \
+        \
+        while (count > 0) \
+        { \
+            int32_t available = 0; \
+            while (available < count) \
+            { \
+                size_t sequence = atomic_load_explicit(&queue->cells[(pos + (size_t)available) & queue->mask].sequence, memory_order_acquire); \
+                if (sequence != pos + (size_t)available + 1) \
+                    break; \
+                \
+                available++; \
+            } \
+            \
+            if (available == 0) \
+            { \
+                size_t sequence = atomic_load_explicit(&queue->cells[pos & queue->mask].sequence, memory_order_acquire); \
+                if ((intptr_t)sequence - (intptr_t)(pos + 1) < 0) \
+                    return 0; \
+                \
+                pos = atomic_load_explicit(&queue->dequeuePos, memory_order_relaxed); \
+                continue; \
+            } \
+            \
+            if (atomic_compare_exchange_weak_explicit(&queue->dequeuePos, &pos, pos + (size_t)available, memory_order_relaxed, memory_order_relaxed)) \
+            { \
+                for(int32_t i = 0; i < available; i++) \
+                { \
+                    typeName ## __Cell* cell = &queue->cells[(pos + (size_t)i) & queue->mask]; \
+                    values[i] = cell->value; \
+                    atomic_store_explicit(&cell->sequence, pos + (size_t)i + queue->mask + 1, memory_order_release); \
+                } \
+                \
+                return available; \
+            } \
+        } \
+        \
+        return 0; \
+    } \
+    \
+    int32_t typeName ## Count(typeName* queue) \
+    { \
+        size_t dequeuePos = atomic_load_explicit(&queue->dequeuePos, memory_order_acquire); \
+        size_t enqueuePos = atomic_load_explicit(&queue->enqueuePos, memory_order_acquire); \
+        return enqueuePos > dequeuePos ? (int32_t)(enqueuePos - dequeuePos) : 0; \
+    }
+
+#endif // SHL_CONCURRENT_QUEUE_H
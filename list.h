@@ -29,7 +29,10 @@
     USAGE
     Include this header in one or more C translation units, then use
     shlDeclareList(name, type) in a header and shlDefineList(name, type) in a
-    single C file.
+    single C file. For lists that usually stay short, use
+    shlDeclareSmallList(name, type, N) with shlDefineSmallList(name, type)
+    instead; these store up to N items inline and only allocate once they
+    outgrow them.
 
     CUSTOMISATION
     Provide a default value for out-of-range reads, an equality function for
@@ -39,7 +42,20 @@
     NOTES
     The implementation is header-only and uses dynamic allocation internally.
     Call Free when finished with a list instance, and prefer AddRange or
-    InsertRange for bulk operations.
+    InsertRange for bulk operations. When order doesn't matter, use
+    RemoveAtSwapBack or RemoveIf instead of repeated RemoveAt calls. A small
+    list points at its own inline storage, so don't copy or move the struct
+    by value while it hasn't spilled to the heap.
+
+    SERIALIZATION
+    Include memory_buffer.h and use shlDeclareListSerialization(name, type)
+    and shlDefineListSerialization(name, type) to add WriteTo, ReadFrom and
+    AttachView. Items are written as one block in host byte order after a
+    small header, so this is meant for plain-old-data item types. A list
+    created by AttachView reads its items straight from the buffer and never
+    writes to it: Add, Insert, Set, the Remove functions, Reverse and Sort
+    copy the items into the list's own storage first. Clear only drops the
+    view.
 */
 
 #ifndef SHL_LIST_H
@@ -47,26 +63,20 @@
 
 #include "shl_internal.h"
 
-#define shlDeclareList(typeName, itemType) \
+#define shl__declareListOptions(typeName, itemType) \
     typedef struct \
     { \
         itemType defaultValue; \
         bool (*equalsFn)(const itemType item1, const itemType item2); \
         void (*freeFn)(itemType item); \
-    } typeName ## Options; \
-    \
-    typedef struct \
-    { \
-        int32_t count; \
-        int32_t capacity; \
-        bool (*equalsFn)(const itemType item1, const itemType item2); \
-        void (*freeFn)(itemType item); \
-        itemType defaultValue; \
-        itemType* items; \
-    } typeName; \
-    \
+        float growthFactor; \
+    } typeName ## Options;
+
+#define shl__declareListFunctions(typeName, itemType) \
     void typeName ## Init(typeName* list, typeName ## Options options); \
     void typeName ## Free(typeName* list); \
+    void typeName ## Reserve(typeName* list, int32_t capacity); \
+    void typeName ## ShrinkToFit(typeName* list); \
     void typeName ## Add(typeName* list, itemType value); \
     void typeName ## AddRange(typeName* list, int32_t count, itemType value[]); \
     void typeName ## Insert(typeName* list, int32_t index, itemType value); \
@@ -78,13 +88,54 @@
     void typeName ## Remove(typeName* list, itemType value); \
     void typeName ## RemoveAt(typeName* list, int32_t index); \
     void typeName ## RemoveAtRange(typeName* list, int32_t index, int32_t count); \
+    void typeName ## RemoveAtSwapBack(typeName* list, int32_t index); \
+    int32_t typeName ## RemoveIf(typeName* list, bool (*predicate)(const itemType item, void* userData), void* userData); \
     void typeName ## Clear(typeName* list); \
     void typeName ## Reverse(typeName* list); \
     void typeName ## Sort(typeName* list, int32_t (*compareFn)(const itemType item1, const itemType item2)); \
     void typeName ## CopyTo(typeName* list, itemType array[], int32_t index); \
-    itemType* typeName ## ToArray(typeName* list); \
+    itemType* typeName ## ToArray(typeName* list);
 
-#define shlDefineList(typeName, itemType) \
+#define shlDeclareList(typeName, itemType) \
+    shl__declareListOptions(typeName, itemType) \
+    \
+    typedef struct \
+    { \
+        int32_t count; \
+        int32_t capacity; \
+        float growthFactor; \
+        bool (*equalsFn)(const itemType item1, const itemType item2); \
+        void (*freeFn)(itemType item); \
+        itemType defaultValue; \
+        itemType* items; \
+    } typeName; \
+    \
+    shl__declareListFunctions(typeName, itemType)
+
+#define shlDeclareSmallList(typeName, itemType, inlineCapacity) \
+    shl__declareListOptions(typeName, itemType) \
+    \
+    typedef struct \
+    { \
+        int32_t count; \
+        int32_t capacity; \
+        float growthFactor; \
+        bool (*equalsFn)(const itemType item1, const itemType item2); \
+        void (*freeFn)(itemType item); \
+        itemType defaultValue; \
+        itemType* items; \
+        itemType inlineItems[inlineCapacity]; \
+    } typeName; \
+    \
+    shl__declareListFunctions(typeName, itemType)
+
+#define shl__defineListFunctions(typeName, itemType) \
+    void typeName ## __detachView(typeName* list) \
+    { \
+        if (list->capacity == 0) \
+            shl__detachArray((void**)&list->items, &list->capacity, list->count, shl__grownCapacity(0, list->count, list->growthFactor), sizeof(itemType)); \
+    } \
+    \
     void typeName ## __qsort(typeName* list, int32_t left, int32_t right, int32_t (*compareFn)(const itemType item1, const itemType item2)) \
     { \
         if (left >= right) \
@@ -113,27 +164,6 @@
         typeName ## __qsort(list, j + 1, right, compareFn); \
     } \
     \
-    void typeName ## Init(typeName* list, typeName ## Options options) \
-    { \
-        list->defaultValue = options.defaultValue; \
-        list->equalsFn = options.equalsFn; \
-        list->freeFn = options.freeFn; \
-        list->capacity = SHL__INITIAL_CAPACITY; \
-        list->count = 0; \
-        list->items = (itemType *)SHL_MALLOC((size_t)list->capacity * sizeof(itemType)); \
-    } \
-    \
-    void typeName ## Free(typeName* list) \
-    { \
-        if (!list->items) \
-            return; \
-        \
-        typeName ## Clear(list); \
-        \
-        SHL_FREE(list->items); \
-        list->items = 0; \
-    } \
-    \
     void typeName ## InsertRange(typeName* list, int32_t index, int32_t count, itemType values[]) \
     { \
         if (!list->items) \
@@ -142,8 +172,8 @@
         if (index < 0 || index > list->count) \
             return; \
         \
-        if (list->count + count >= list->capacity) \
-            shl__resizeArray((void**)&list->items, &list->capacity, list->count + count, sizeof(itemType)); \
+        if (list->count + count > list->capacity) \
+            typeName ## __grow(list, list->count + count); \
         \
         memmove(list->items + index + count, list->items + index, (list->count - index) * sizeof(itemType)); \
         memcpy(list->items + index, values, count * sizeof(itemType)); \
@@ -206,6 +236,8 @@
         if (index < 0 || index >= list->count) \
             return; \
         \
+        typeName ## __detachView(list); \
+        \
         itemType currentValue = list->items[index]; \
         if (list->freeFn) \
             list->freeFn(currentValue); \
@@ -224,6 +256,8 @@
         if (index + count > list->count) \
             return; \
         \
+        typeName ## __detachView(list); \
+        \
         if (list->freeFn) \
         { \
             for(int32_t i = 0; i < count; i++) \
@@ -246,6 +280,56 @@
             typeName ## RemoveAt(list, index); \
     } \
     \
+    void typeName ## RemoveAtSwapBack(typeName *list, int32_t index) \
+    { \
+        if (!list->items) \
+            return; \
+        \
+        if (index < 0 || index >= list->count) \
+            return; \
+        \
+        typeName ## __detachView(list); \
+        \
+        if (list->freeFn) \
+            list->freeFn(list->items[index]); \
+        \
+        list->count--; \
+        list->items[index] = list->items[list->count]; \
+    } \
+    \
+    int32_t typeName ## RemoveIf(typeName *list, bool (*predicate)(const itemType item, void* userData), void* userData) \
+    { \
+        if (!list->items) \
+            return 0; \
+        \
+        if (!predicate) \
+            return 0; \
+        \
+        typeName ## __detachView(list); \
+        \
+        int32_t j = 0; \
+        for(int32_t i = 0; i < list->count; i++) \
+        { \
+            itemType item = list->items[i]; \
+            if (predicate(item, userData)) \
+            { \
+                if (list->freeFn) \
+                    list->freeFn(item); \
+                \
+                continue; \
+            } \
+            \
+            if (i != j) \
+                list->items[j] = item; \
+            \
+            j++; \
+        } \
+        \
+        int32_t removed = list->count - j; \
+        list->count = j; \
+        return removed; \
+    } \
+    \
     void typeName ## Clear(typeName* list) \
     { \
         if (!list->items) \
@@ -265,6 +349,8 @@
         if (!list->items) \
             return; \
         \
+        typeName ## __detachView(list); \
+        \
         int32_t count = list->count; \
         for(int32_t i = 0; i < count / 2; i++) \
         { \
@@ -275,6 +361,10 @@
     } \
     void typeName ## Sort(typeName* list, int32_t (*compareFn)(const itemType item1, const itemType item2)) \
     { \
+        if (!list->items) \
+            return; \
+        \
+        typeName ## __detachView(list); \
         typeName ## __qsort(list, 0, list->count - 1, compareFn); \
     } \
     \
@@ -297,4 +387,229 @@
         return array; \
     }
 
+#define shlDefineList(typeName, itemType) \
+    void typeName ## __grow(typeName* list, int32_t minSize) \
+    { \
+        if (list->capacity == 0) \
+            shl__detachArray((void**)&list->items, &list->capacity, list->count, shl__grownCapacity(0, minSize, list->growthFactor), sizeof(itemType)); \
+        else \
+            shl__resizeArray((void**)&list->items, &list->capacity, minSize, sizeof(itemType), list->growthFactor); \
+    } \
+    \
+    void typeName ## Init(typeName* list, typeName ## Options options) \
+    { \
+        list->defaultValue = options.defaultValue; \
+        list->equalsFn = options.equalsFn; \
+        list->freeFn = options.freeFn; \
+        list->growthFactor = options.growthFactor; \
+        list->capacity = SHL__INITIAL_CAPACITY; \
+        list->count = 0; \
+        list->items = (itemType *)SHL_MALLOC((size_t)list->capacity * sizeof(itemType)); \
+    } \
+    \
+    void typeName ## Free(typeName* list) \
+    { \
+        if (!list->items) \
+            return; \
+        \
+        typeName ## Clear(list); \
+        \
+        if (list->capacity > 0) \
+            SHL_FREE(list->items); \
+        \
+        list->items = 0; \
+    } \
+    \
+    void typeName ## Reserve(typeName* list, int32_t capacity) \
+    { \
+        if (!list->items) \
+            return; \
+        \
+        if (list->capacity == 0) \
+            shl__detachArray((void**)&list->items, &list->capacity, list->count, capacity > list->count ? capacity : list->count, sizeof(itemType)); \
+        else if (capacity > list->capacity) \
+            shl__reallocArray((void**)&list->items, &list->capacity, capacity, sizeof(itemType)); \
+    } \
+    \
+    void typeName ## ShrinkToFit(typeName* list) \
+    { \
+        if (!list->items) \
+            return; \
+        \
+        int32_t capacity = list->count > 0 ? list->count : 1; \
+        if (capacity < list->capacity) \
+            shl__reallocArray((void**)&list->items, &list->capacity, capacity, sizeof(itemType)); \
+    } \
+    \
+    shl__defineListFunctions(typeName, itemType)
+
+#define shlDefineSmallList(typeName, itemType) \
+    void typeName ## __grow(typeName* list, int32_t minSize) \
+    { \
+        if (list->capacity == 0) \
+        { \
+            shl__detachArray((void**)&list->items, &list->capacity, list->count, shl__grownCapacity(0, minSize, list->growthFactor), sizeof(itemType)); \
+            return; \
+        } \
+        \
+        int32_t newCapacity = shl__grownCapacity(list->capacity, minSize, list->growthFactor); \
+        shl__resizeSmallArray((void**)&list->items, &list->capacity, newCapacity, sizeof(itemType), list->inlineItems); \
+    } \
+    \
+    void typeName ## Init(typeName* list, typeName ## Options options) \
+    { \
+        list->defaultValue = options.defaultValue; \
+        list->equalsFn = options.equalsFn; \
+        list->freeFn = options.freeFn; \
+        list->growthFactor = options.growthFactor; \
+        list->capacity = (int32_t)(sizeof(list->inlineItems) / sizeof(list->inlineItems[0])); \
+        list->count = 0; \
+        list->items = list->inlineItems; \
+    } \
+    \
+    void typeName ## Free(typeName* list) \
+    { \
+        if (!list->items) \
+            return; \
+        \
+        typeName ## Clear(list); \
+        \
+        if (list->items != list->inlineItems && list->capacity > 0) \
+            SHL_FREE(list->items); \
+        \
+        list->items = 0; \
+    } \
+    \
+    void typeName ## Reserve(typeName* list, int32_t capacity) \
+    { \
+        if (!list->items) \
+            return; \
+        \
+        if (list->capacity == 0) \
+            shl__detachArray((void**)&list->items, &list->capacity, list->count, capacity > list->count ? capacity : list->count, sizeof(itemType)); \
+        else if (capacity > list->capacity) \
+            shl__resizeSmallArray((void**)&list->items, &list->capacity, capacity, sizeof(itemType), list->inlineItems); \
+    } \
+    \
+    void typeName ## ShrinkToFit(typeName* list) \
+    { \
+        if (!list->items || list->items == list->inlineItems || list->capacity == 0) \
+            return; \
+        \
+        int32_t inlineCapacity = (int32_t)(sizeof(list->inlineItems) / sizeof(list->inlineItems[0])); \
+        if (list->count <= inlineCapacity) \
+        { \
+            memcpy(list->inlineItems, list->items, (size_t)list->count * sizeof(itemType)); \
+            SHL_FREE(list->items); \
+            list->items = list->inlineItems; \
+            list->capacity = inlineCapacity; \
+        } \
+        else if (list->count < list->capacity) \
+        { \
+            shl__reallocArray((void**)&list->items, &list->capacity, list->count, sizeof(itemType)); \
+        } \
+    } \
+    \
+    shl__defineListFunctions(typeName, itemType)
+
+#define shlDeclareListSerialization(typeName, itemType) \
+    bool typeName ## WriteTo(typeName* list, memory_buffer_t* buffer); \
+    bool typeName ## ReadFrom(typeName* list, memory_buffer_t* buffer); \
+    bool typeName ## AttachView(typeName* list, typeName ## Options options, memory_buffer_t* buffer);
+
+#define shlDefineListSerialization(typeName, itemType) \
+    typedef struct \
+    { \
+        char c; \
+        itemType value; \
+    } typeName ## __AlignProbe; \
+    \
+    bool typeName ## __readHeader(memory_buffer_t* buffer, uint32_t* count) \
+    { \
+        uint8_t header[8]; \
+        if (!mb_readBytes(buffer, header, sizeof(header))) \
+            return false; \
+        \
+        uint32_t itemSize = (uint32_t)header[0] | ((uint32_t)header[1] << 8) | ((uint32_t)header[2] << 16) | ((uint32_t)header[3] << 24); \
+        *count = (uint32_t)header[4] | ((uint32_t)header[5] << 8) | ((uint32_t)header[6] << 16) | ((uint32_t)header[7] << 24); \
+        \
+        if (itemSize != sizeof(itemType) || *count > INT32_MAX) \
+        { \
+            mb_skip(buffer, -(int32_t)sizeof(header)); \
+            return false; \
+        } \
+        \
+        return true; \
+    } \
+    \
+    bool typeName ## WriteTo(typeName* list, memory_buffer_t* buffer) \
+    { \
+        if (!list->items) \
+            return false; \
+        \
+        uint32_t itemSize = (uint32_t)sizeof(itemType); \
+        uint32_t count = (uint32_t)list->count; \
+        uint8_t header[8] = \
+        { \
+            (uint8_t)itemSize, (uint8_t)(itemSize >> 8), (uint8_t)(itemSize >> 16), (uint8_t)(itemSize >> 24), \
+            (uint8_t)count, (uint8_t)(count >> 8), (uint8_t)(count >> 16), (uint8_t)(count >> 24) \
+        }; \
+        \
+        if (!mb_writeBytes(buffer, header, sizeof(header))) \
+            return false; \
+        \
+        return mb_writeBytes(buffer, (uint8_t*)list->items, (size_t)list->count * sizeof(itemType)); \
+    } \
+    \
+    bool typeName ## ReadFrom(typeName* list, memory_buffer_t* buffer) \
+    { \
+        if (!list->items) \
+            return false; \
+        \
+        uint32_t count = 0; \
+        const uint8_t* view = 0; \
+        uint32_t start = (uint32_t)mb_position(buffer); \
+        if (!typeName ## __readHeader(buffer, &count)) \
+            return false; \
+        \
+        if (!mb_readView(buffer, &view, (size_t)count * sizeof(itemType))) \
+        { \
+            mb_seek(buffer, start); \
+            return false; \
+        } \
+        \
+        typeName ## Clear(list); \
+        typeName ## Reserve(list, (int32_t)count); \
+        memcpy(list->items, view, (size_t)count * sizeof(itemType)); \
+        list->count = (int32_t)count; \
+        return true; \
+    } \
+    \
+    bool typeName ## AttachView(typeName* list, typeName ## Options options, memory_buffer_t* buffer) \
+    { \
+        uint32_t count = 0; \
+        const uint8_t* view = 0; \
+        uint32_t start = (uint32_t)mb_position(buffer); \
+        \
+        list->items = 0; \
+        if (!typeName ## __readHeader(buffer, &count)) \
+            return false; \
+        \
+        if (!mb_readView(buffer, &view, (size_t)count * sizeof(itemType)) || \
+            (uintptr_t)view % offsetof(typeName ## __AlignProbe, value) != 0) \
+        { \
+            mb_seek(buffer, start); \
+            return false; \
+        } \
+        \
+        list->defaultValue = options.defaultValue; \
+        list->equalsFn = options.equalsFn; \
+        list->freeFn = options.freeFn; \
+        list->growthFactor = options.growthFactor; \
+        list->capacity = 0; \
+        list->count = (int32_t)count; \
+        list->items = (itemType *)view; \
+        return true; \
+    }
+
 #endif // SHL_LIST_H
@@ -79,6 +79,7 @@ bool mb_scanTo(memory_buffer_t* buffer, const void* data, size_t length);
 bool mb_read(memory_buffer_t* buffer, uint8_t* value);
 bool mb_readBytes(memory_buffer_t* buffer, uint8_t* value, size_t count);
 bool mb_readString(memory_buffer_t* buffer, char* str, size_t count);
+bool mb_readView(memory_buffer_t* buffer, const uint8_t** view, size_t count);
 
 bool mb_readInt16LE(memory_buffer_t* buffer, int16_t* value);
 bool mb_readInt16BE(memory_buffer_t* buffer, int16_t* value);
@@ -248,6 +249,16 @@ bool mb_readString(memory_buffer_t* buffer, char* str, size_t count)
     return mb_readBytes(buffer, (uint8_t*)str, count);
 }
 
+bool mb_readView(memory_buffer_t* buffer, const uint8_t** view, size_t count)
+{
+    if (buffer->_pointer + count > mb_end(buffer))
+        return false;
+
+    *view = buffer->_pointer;
+    buffer->_pointer += count;
+    return true;
+}
+
 bool mb_readInt16LE(memory_buffer_t* buffer, int16_t* value)
 {
     uint8_t byte0, byte1;
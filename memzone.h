@@ -43,6 +43,16 @@
     need custom allocation. Optional hooks include SHL_MZ_ASSERT, SHL_MZ_DEBUG, and
     SHL_MZ_PRIVATE_API for diagnostics and internal-structure exposure.
 
+    THREADS
+    Define SHL_MZ_THREAD_SAFE (needs C11 atomics and pthreads) before every
+    include to share a zone between threads. Every call takes a per-zone lock,
+    except allocations and frees of up to 256 bytes with the default alignment:
+    each thread keeps small caches (magazines) of those blocks per size class,
+    refilled from the zone in batches. Blocks freed by a thread other than the
+    one that allocated them are queued lock-free back to the owner's cache.
+    Call mz_threadFlush before a thread exits to give its cached blocks back,
+    and define SHL_MZ_MAX_THREADS to change how many caches a zone can have.
+
     AUDIT
     For per-zone audit logging (every alloc/free written to a structured text
     file), include the companion header memzone_audit.h in your implementation
@@ -52,6 +62,8 @@
     The allocator returns stable pointers until the zone is reset or destroyed.
     Use mz_setReporter to install custom diagnostics, mz_validate to sanity-
     check the zone, and mz_free only with pointers that came from the zone.
+    Free blocks are indexed in segregated lists by size class, so finding a
+    block to allocate doesn't walk the block list.
 
     See memzone.md file for more information about memory layout for each allocation/deallocation.
 
@@ -68,6 +80,11 @@
 #include <string.h>
 #include <math.h>
 
+#if defined(SHL_MZ_THREAD_SAFE)
+#include <pthread.h>
+#include <stdatomic.h>
+#endif
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -83,21 +100,48 @@ typedef enum
 
 typedef void (*mz_reporter_t)(const memzone_t* zone, mz_report_t report, const void* context, const char* message, void* userData);
 
+// Free blocks are indexed by size class in two levels, like TLSF: one level per power of two
+// and MZ__SL_COUNT linear classes inside each level. Blocks under 2^MZ__FL_SHIFT bytes share
+// the first level and blocks over the last level share its last class.
+#define MZ__FL_SHIFT 6
+#define MZ__FL_COUNT 28
+#define MZ__SL_LOG2 2
+#define MZ__SL_COUNT (1 << MZ__SL_LOG2)
+
+#if defined(SHL_MZ_THREAD_SAFE) && !defined(SHL_MZ_MAX_THREADS)
+#define SHL_MZ_MAX_THREADS 32
+#endif
+
 #if defined(SHL_MZ_PRIVATE_API)
 typedef struct memblock_s
 {
     size_t size;                        // size of the block
     void* user;                         // a pointer to the pointer returned to the user
     struct memblock_s *next, *prev;     // pointers to next and prev in the block list
-} memblock_t;
+#if defined(SHL_MZ_THREAD_SAFE)
+    uint16_t owner;                     // index + 1 of the thread cache that allocated the block, 0 for blocks outside the caches
+    uint8_t sizeClass;                  // cache size class of the block, only when owner isn't 0
+    atomic_bool cached;                 // the block is back in a thread cache and not with the user
+#endif
+    struct memblock_s *nextFree, *prevFree; // pointers to next and prev in the free list of the block size class, only while the block is free
+} memblock_t;                           // prevFree must stay last, the check word of an unpadded allocation overlays it
 
 struct memzone_s
 {
     size_t usedSize;                    // how much space is used without including blocks data
     size_t maxSize;                     // the max allowed size that can be allocated
-    memblock_t* rover;                  // a pointer to a free block that is used when allocating
     mz_reporter_t reporter;             // optional runtime diagnostics hook, defaults to stderr
     void* reporterUserData;             // user data passed to the diagnostics hook
+    uintptr_t blockKey;                 // xor-ed with the block address in the check word of each allocation, changes on every reset
+#if defined(SHL_MZ_THREAD_SAFE)
+    pthread_mutex_t lock;               // guards everything in the zone but the magazines of the thread caches
+    uint32_t id;                        // tells apart zones created at the same address
+    int32_t cacheCount;                 // number of thread caches created
+    struct mz__threadCache_s* caches[SHL_MZ_MAX_THREADS]; // thread caches, each one used by a single thread at a time
+#endif
+    uint32_t freeLevels;                // bit i is set when any of the free lists of level i is not empty
+    uint8_t freeClasses[MZ__FL_COUNT];  // bit j of freeClasses[i] is set when freeLists[i][j] is not empty
+    memblock_t* freeLists[MZ__FL_COUNT][MZ__SL_COUNT]; // free blocks segregated by size class
     memblock_t blockList;               // list of blocks, here is where the requested memory begins
 };
 #endif
@@ -119,6 +163,7 @@ bool mz_validate(const memzone_t* zone);
 int32_t mz_blockCount(const memzone_t* zone);
 size_t mz_usableFreeSize(const memzone_t* zone);
 float mz_fragmentation(const memzone_t* zone);
+void mz_threadFlush(memzone_t* zone);
 
 #ifdef __cplusplus
 }
@@ -149,15 +194,30 @@ typedef struct memblock_s
     size_t size;                        // size of the block
     void* user;                         // a pointer to the pointer returned to the user
     struct memblock_s *next, *prev;     // pointers to next and prev in the block list
-} memblock_t;
+#if defined(SHL_MZ_THREAD_SAFE)
+    uint16_t owner;                     // index + 1 of the thread cache that allocated the block, 0 for blocks outside the caches
+    uint8_t sizeClass;                  // cache size class of the block, only when owner isn't 0
+    atomic_bool cached;                 // the block is back in a thread cache and not with the user
+#endif
+    struct memblock_s *nextFree, *prevFree; // pointers to next and prev in the free list of the block size class, only while the block is free
+} memblock_t;                           // prevFree must stay last, the check word of an unpadded allocation overlays it
 
 struct memzone_s
 {
     size_t usedSize;                    // how much space is used without including blocks data
     size_t maxSize;                     // the max allowed size that can be allocated
-    memblock_t* rover;                  // a pointer to a free block that is used when allocating
     mz_reporter_t reporter;             // optional runtime diagnostics hook, defaults to stderr
     void* reporterUserData;             // user data passed to the diagnostics hook
+    uintptr_t blockKey;                 // xor-ed with the block address in the check word of each allocation, changes on every reset
+#if defined(SHL_MZ_THREAD_SAFE)
+    pthread_mutex_t lock;               // guards everything in the zone but the magazines of the thread caches
+    uint32_t id;                        // tells apart zones created at the same address
+    int32_t cacheCount;                 // number of thread caches created
+    struct mz__threadCache_s* caches[SHL_MZ_MAX_THREADS]; // thread caches, each one used by a single thread at a time
+#endif
+    uint32_t freeLevels;                // bit i is set when any of the free lists of level i is not empty
+    uint8_t freeClasses[MZ__FL_COUNT];  // bit j of freeClasses[i] is set when freeLists[i][j] is not empty
+    memblock_t* freeLists[MZ__FL_COUNT][MZ__SL_COUNT]; // free blocks segregated by size class
     memblock_t blockList;               // list of blocks, here is where the requested memory begins
 };
 #endif
@@ -167,6 +227,51 @@ struct memzone_s
 #define MZ__MAX(a, b) ((a) > (b) ? (a) : (b))
 #define MZ__DEFAULT_ALIGNMENT MZ__MAX(MZ__ALIGNOF(memblock_t), MZ__MAX(MZ__ALIGNOF(void*), MZ__ALIGNOF(size_t)))
 #define MZ__IS_BLOCK_EMPTY(block) ((block)->user == NULL)
+#define MZ__MAX_ALIGNMENT 64
+#define MZ__BLOCK_MAGIC ((uintptr_t)0x6D7A626C6F636B21ull)
+
+#if defined(SHL_MZ_THREAD_SAFE)
+#define MZ__LOCK(zone) pthread_mutex_lock((pthread_mutex_t*)&(zone)->lock)
+#define MZ__UNLOCK(zone) pthread_mutex_unlock((pthread_mutex_t*)&(zone)->lock)
+#else
+#define MZ__LOCK(zone) ((void)0)
+#define MZ__UNLOCK(zone) ((void)0)
+#endif
+
+#if defined(SHL_MZ_THREAD_SAFE)
+// thread caches keep blocks of the power of two sizes from 8 to 256 bytes, allocated with the
+// default alignment, in magazines of MZ__MAGAZINE_SIZE blocks per size class
+#define MZ__CACHE_CLASS_COUNT 6
+#define MZ__CACHE_MIN_SHIFT 3
+#define MZ__MAGAZINE_SIZE 32
+#define MZ__MAGAZINE_BATCH (MZ__MAGAZINE_SIZE / 2)
+#define MZ__THREAD_SLOT_COUNT 8
+#define MZ__CACHE_LINE_SIZE 64
+
+typedef struct mz__threadCache_s
+{
+    _Atomic(void*) remoteFrees;         // payloads freed by other threads, linked through their first word
+    uint8_t padding[MZ__CACHE_LINE_SIZE]; // keeps the remote frees and the magazines in different cache lines
+    int32_t index;                      // position of the cache in the zone, the owner of its blocks minus one
+    const void* holder;                 // slot table of the thread that holds the cache, NULL when free, guarded by the zone lock
+    int32_t counts[MZ__CACHE_CLASS_COUNT];
+    void* items[MZ__CACHE_CLASS_COUNT][MZ__MAGAZINE_SIZE];
+} mz__threadCache_t;
+
+typedef struct
+{
+    const memzone_t* zone;
+    uint32_t zoneId;
+    int32_t cache;                      // index of the thread cache in the zone, -1 when the zone had none left
+    uint32_t stamp;                     // when the slot was taken, the oldest one is evicted when all are taken
+} mz__threadSlot_t;
+
+static atomic_uint mz__nextZoneId = 1;
+
+// every thread remembers its caches for the last MZ__THREAD_SLOT_COUNT zones it used
+static _Thread_local mz__threadSlot_t mz__threadSlots[MZ__THREAD_SLOT_COUNT];
+static _Thread_local uint32_t mz__threadSlotStamp;
+#endif
 
 static bool mz__alignUp(size_t value, size_t alignment, size_t* alignedValue)
 {
@@ -215,7 +320,7 @@ static bool mz__isSupportedAlignment(size_t alignment)
         return false;
     }
 
-    return alignment == mz_alignment() || alignment == 16 || alignment == 32 || alignment == 64;
+    return alignment == mz_alignment() || alignment == 16 || alignment == 32 || alignment == MZ__MAX_ALIGNMENT;
 }
 
 static const char* mz__reportName(mz_report_t report)
@@ -268,10 +373,12 @@ static bool mz__validationFailure(const memzone_t* zone, const void* context, co
     return false;
 }
 
+static bool mz__validate(const memzone_t* zone);
+
 static void mz__debugAssertValid(const memzone_t* zone)
 {
 #if defined(SHL_MZ_DEBUG)
-    SHL_MZ_ASSERT(mz_validate(zone));
+    SHL_MZ_ASSERT(mz__validate(zone));
 #else
     (void)zone;
 #endif
@@ -321,27 +428,263 @@ static bool mz__isPrevBlockAdjacent(const memblock_t* block)
     return MZ__POINTER_OFFSET(const uint8_t, block->prev, block->prev->size) == (const uint8_t*)block;
 }
 
-static const memblock_t* mz__findBlock(const memzone_t* zone, const void* p)
+static int32_t mz__floorLog2(size_t value)
 {
-    if (zone == NULL || p == NULL)
+#if defined(__GNUC__) || defined(__clang__)
+    return (int32_t)(sizeof(unsigned long long) * 8 - 1) - __builtin_clzll((unsigned long long)value);
+#else
+    int32_t log = 0;
+    while (value >>= 1)
     {
-        return NULL;
+        log++;
     }
 
-    const memblock_t* rover = &zone->blockList;
-    do
+    return log;
+#endif
+}
+
+static int32_t mz__lowestBit(uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctz(value);
+#else
+    int32_t bit = 0;
+    while ((value & 1) == 0)
+    {
+        value >>= 1;
+        bit++;
+    }
+
+    return bit;
+#endif
+}
+
+static void mz__sizeClass(size_t size, int32_t* fl, int32_t* sl)
+{
+    if (size < ((size_t)1 << MZ__FL_SHIFT))
+    {
+        *fl = 0;
+        *sl = (int32_t)(size >> (MZ__FL_SHIFT - MZ__SL_LOG2));
+        return;
+    }
+
+    int32_t log = mz__floorLog2(size);
+    *fl = log - MZ__FL_SHIFT + 1;
+    *sl = (int32_t)((size >> (log - MZ__SL_LOG2)) & (MZ__SL_COUNT - 1));
+
+    if (*fl >= MZ__FL_COUNT)
+    {
+        *fl = MZ__FL_COUNT - 1;
+        *sl = MZ__SL_COUNT - 1;
+    }
+}
+
+static void mz__insertFreeBlock(memzone_t* zone, memblock_t* block)
+{
+    int32_t fl, sl;
+    mz__sizeClass(block->size, &fl, &sl);
+
+    memblock_t* head = zone->freeLists[fl][sl];
+    block->prevFree = NULL;
+    block->nextFree = head;
+    if (head != NULL)
+    {
+        head->prevFree = block;
+    }
+
+    zone->freeLists[fl][sl] = block;
+    zone->freeLevels |= 1u << fl;
+    zone->freeClasses[fl] |= (uint8_t)(1u << sl);
+}
+
+static void mz__removeFreeBlock(memzone_t* zone, memblock_t* block)
+{
+    int32_t fl, sl;
+    mz__sizeClass(block->size, &fl, &sl);
+
+    if (block->prevFree != NULL)
+    {
+        block->prevFree->nextFree = block->nextFree;
+    }
+    else
+    {
+        zone->freeLists[fl][sl] = block->nextFree;
+    }
+
+    if (block->nextFree != NULL)
+    {
+        block->nextFree->prevFree = block->prevFree;
+    }
+
+    if (zone->freeLists[fl][sl] == NULL)
     {
-        if (rover->user == p)
+        zone->freeClasses[fl] &= (uint8_t)~(1u << sl);
+        if (zone->freeClasses[fl] == 0)
         {
-            return rover;
+            zone->freeLevels &= ~(1u << fl);
         }
+    }
 
-        rover = rover->next;
-    } while (rover != &zone->blockList);
+    block->nextFree = NULL;
+    block->prevFree = NULL;
+}
+
+static bool mz__blockFits(memblock_t* block, size_t alignedSize, size_t alignment, size_t* padding, size_t* sizeToAlloc)
+{
+    uintptr_t payloadAddress = (uintptr_t)mz__payloadPointer(block);
+    size_t currentPadding = 0;
+    size_t remainder = payloadAddress % alignment;
+    if (remainder != 0)
+    {
+        currentPadding = alignment - remainder;
+    }
+
+    if (currentPadding > mz__payloadSize(block) || alignedSize > mz__payloadSize(block) - currentPadding)
+    {
+        return false;
+    }
+
+    *padding = currentPadding;
+    *sizeToAlloc = mz__headerSize() + currentPadding + alignedSize;
+    return true;
+}
+
+static memblock_t* mz__firstFreeList(const memzone_t* zone, int32_t* fl, int32_t* sl)
+{
+    uint32_t classes = (uint32_t)zone->freeClasses[*fl] & (~0u << *sl);
+    if (classes == 0)
+    {
+        uint32_t levels = *fl + 1 < MZ__FL_COUNT ? zone->freeLevels & (~0u << (*fl + 1)) : 0;
+        if (levels == 0)
+        {
+            return NULL;
+        }
+
+        *fl = mz__lowestBit(levels);
+        classes = zone->freeClasses[*fl];
+    }
+
+    *sl = mz__lowestBit(classes);
+    return zone->freeLists[*fl][*sl];
+}
+
+static memblock_t* mz__findFreeBlock(memzone_t* zone, size_t alignedSize, size_t alignment, size_t* padding, size_t* sizeToAlloc)
+{
+    size_t minSize = mz__headerSize() + alignedSize;
+    size_t searchSize = minSize + (alignment - mz_alignment());
+    int32_t fl, sl;
+
+    // round the worst case size up to the next class, so any block of that class or above fits
+    size_t round = searchSize < ((size_t)1 << MZ__FL_SHIFT)
+        ? ((size_t)1 << (MZ__FL_SHIFT - MZ__SL_LOG2)) - 1
+        : ((size_t)1 << (mz__floorLog2(searchSize) - MZ__SL_LOG2)) - 1;
+
+    if (searchSize <= ((size_t)-1) - round)
+    {
+        mz__sizeClass(searchSize + round, &fl, &sl);
+
+        memblock_t* block = mz__firstFreeList(zone, &fl, &sl);
+        if (block != NULL && mz__blockFits(block, alignedSize, alignment, padding, sizeToAlloc))
+        {
+            return block;
+        }
+    }
+
+    // otherwise only the classes that can hold both fitting and smaller blocks are left, search them first-fit
+    mz__sizeClass(minSize, &fl, &sl);
+
+    memblock_t* list = mz__firstFreeList(zone, &fl, &sl);
+    while (list != NULL)
+    {
+        for (memblock_t* block = list; block != NULL; block = block->nextFree)
+        {
+            if (mz__blockFits(block, alignedSize, alignment, padding, sizeToAlloc))
+            {
+                return block;
+            }
+        }
+
+        if (++sl == MZ__SL_COUNT)
+        {
+            if (++fl == MZ__FL_COUNT)
+            {
+                break;
+            }
+
+            sl = 0;
+        }
+
+        list = mz__firstFreeList(zone, &fl, &sl);
+    }
 
     return NULL;
 }
 
+static void mz__resetBlocks(memzone_t* zone)
+{
+    // a new key makes the check words of the allocations before the reset stale
+    zone->blockKey = zone->blockKey * (uintptr_t)0x9E3779B97F4A7C15ull + 1;
+    zone->usedSize = mz__zoneBaseSize();
+    zone->freeLevels = 0;
+    memset(zone->freeClasses, 0, sizeof(zone->freeClasses));
+    memset(zone->freeLists, 0, sizeof(zone->freeLists));
+
+    zone->blockList = (memblock_t){0};
+    zone->blockList.size = zone->maxSize - offsetof(memzone_t, blockList);
+    zone->blockList.user = NULL;
+    zone->blockList.next = &zone->blockList;
+    zone->blockList.prev = &zone->blockList;
+    mz__insertFreeBlock(zone, &zone->blockList);
+}
+
+// every allocation stores the address of its block, xor-ed with the zone key, in the word right
+// before the user pointer: the end of the block header, or the end of the alignment padding
+static uintptr_t mz__blockCheck(const memzone_t* zone, const memblock_t* block)
+{
+    return (uintptr_t)block ^ zone->blockKey;
+}
+
+static void mz__writeBlockCheck(void* p, uintptr_t check)
+{
+    memcpy((uint8_t*)p - sizeof(uintptr_t), &check, sizeof(uintptr_t));
+}
+
+static uintptr_t mz__readBlockCheck(const void* p)
+{
+    uintptr_t check;
+    memcpy(&check, (const uint8_t*)p - sizeof(uintptr_t), sizeof(uintptr_t));
+    return check;
+}
+
+static const memblock_t* mz__findBlock(const memzone_t* zone, const void* p)
+{
+    if (zone == NULL || p == NULL)
+    {
+        return NULL;
+    }
+
+    const uint8_t* user = (const uint8_t*)p;
+    const uint8_t* firstBlockStart = (const uint8_t*)&zone->blockList;
+    const uint8_t* zoneEnd = (const uint8_t*)zone + zone->maxSize;
+    if (user < firstBlockStart + mz__headerSize() || user >= zoneEnd || ((uintptr_t)user % mz_alignment()) != 0)
+    {
+        return NULL;
+    }
+
+    const uint8_t* block = (const uint8_t*)(mz__readBlockCheck(p) ^ zone->blockKey);
+    if (block < firstBlockStart || block > user - mz__headerSize() || (size_t)(user - block) >= mz__headerSize() + MZ__MAX_ALIGNMENT)
+    {
+        return NULL;
+    }
+
+    if (((uintptr_t)block % mz_alignment()) != 0 || ((const memblock_t*)block)->user != p)
+    {
+        return NULL;
+    }
+
+    return (const memblock_t*)block;
+}
+
 size_t mz_alignment(void)
 {
     return MZ__DEFAULT_ALIGNMENT;
@@ -354,7 +697,15 @@ size_t mz_maxSize(const memzone_t* zone)
 
 size_t mz_usedSize(const memzone_t* zone)
 {
-    return zone != NULL ? zone->usedSize : 0;
+    if (zone == NULL)
+    {
+        return 0;
+    }
+
+    MZ__LOCK(zone);
+    size_t usedSize = zone->usedSize;
+    MZ__UNLOCK(zone);
+    return usedSize;
 }
 
 memzone_t* mz_init(size_t maxSize)
@@ -373,18 +724,17 @@ memzone_t* mz_init(size_t maxSize)
         return NULL;
     }
 
-    zone->usedSize = mz__zoneBaseSize();
     zone->maxSize = maxSize;
     zone->reporter = mz__stderrReporter;
     zone->reporterUserData = NULL;
-
-    zone->blockList = (memblock_t){0};
-    zone->blockList.size = maxSize - offsetof(memzone_t, blockList);
-    zone->blockList.user = NULL;
-    zone->blockList.next = &zone->blockList;
-    zone->blockList.prev = &zone->blockList;
-
-    zone->rover = &zone->blockList;
+    zone->blockKey = MZ__BLOCK_MAGIC ^ (uintptr_t)zone;
+#if defined(SHL_MZ_THREAD_SAFE)
+    pthread_mutex_init(&zone->lock, NULL);
+    zone->id = atomic_fetch_add(&mz__nextZoneId, 1);
+    zone->cacheCount = 0;
+    memset(zone->caches, 0, sizeof(zone->caches));
+#endif
+    mz__resetBlocks(zone);
 
     mz__debugAssertValid(zone);
 
@@ -393,6 +743,28 @@ memzone_t* mz_init(size_t maxSize)
 
 void mz_destroy(memzone_t* zone)
 {
+#if defined(SHL_MZ_THREAD_SAFE)
+    if (zone != NULL)
+    {
+        // the slot of the calling thread is free for the next zone, other threads must have flushed theirs
+        for (int32_t i = 0; i < MZ__THREAD_SLOT_COUNT; i++)
+        {
+            mz__threadSlot_t* slot = &mz__threadSlots[i];
+            if (slot->zone == zone && slot->zoneId == zone->id)
+            {
+                *slot = (mz__threadSlot_t){0};
+            }
+        }
+
+        for (int32_t i = 0; i < zone->cacheCount; i++)
+        {
+            SHL_MZ_FREE(zone->caches[i]);
+        }
+
+        pthread_mutex_destroy(&zone->lock);
+    }
+#endif
+
     SHL_MZ_FREE(zone);
 }
 
@@ -403,14 +775,20 @@ void mz_reset(memzone_t* zone)
         return;
     }
 
-    zone->usedSize = mz__zoneBaseSize();
-    zone->blockList = (memblock_t){0};
-    zone->blockList.size = zone->maxSize - offsetof(memzone_t, blockList);
-    zone->blockList.user = NULL;
-    zone->blockList.next = &zone->blockList;
-    zone->blockList.prev = &zone->blockList;
-    zone->rover = &zone->blockList;
+    MZ__LOCK(zone);
+
+#if defined(SHL_MZ_THREAD_SAFE)
+    // the cached blocks go away with the rest, the threads keep their caches
+    for (int32_t i = 0; i < zone->cacheCount; i++)
+    {
+        memset(zone->caches[i]->counts, 0, sizeof(zone->caches[i]->counts));
+        atomic_store(&zone->caches[i]->remoteFrees, NULL);
+    }
+#endif
+
+    mz__resetBlocks(zone);
     mz__debugAssertValid(zone);
+    MZ__UNLOCK(zone);
 }
 
 void* mz_alloc(memzone_t* zone, size_t size)
@@ -425,11 +803,62 @@ void mz_setReporter(memzone_t* zone, mz_reporter_t reporter, void* userData)
         return;
     }
 
+    MZ__LOCK(zone);
     zone->reporter = reporter;
     zone->reporterUserData = userData;
+    MZ__UNLOCK(zone);
 }
 
-void* mz_allocAligned(memzone_t* zone, size_t size, size_t alignment)
+// takes a block for alignedSize bytes out of the free lists, without zeroing it or reporting failures
+static void* mz__takeFreeBlock(memzone_t* zone, size_t alignedSize, size_t alignment)
+{
+    size_t padding = 0;
+    size_t sizeToAlloc = 0;
+    memblock_t* rover = mz__findFreeBlock(zone, alignedSize, alignment, &padding, &sizeToAlloc);
+    if (rover == NULL)
+    {
+        return NULL;
+    }
+
+    mz__removeFreeBlock(zone, rover);
+
+    size_t headerSize = mz__headerSize();
+    size_t usedPayloadSize = mz__payloadSize(rover);
+    size_t remainingSize = rover->size - sizeToAlloc;
+    if (remainingSize >= headerSize + mz_alignment())
+    {
+        // create a new empty block with the remaining free space
+        memblock_t* newBlock = MZ__POINTER_OFFSET(memblock_t, rover, sizeToAlloc);
+        newBlock->size = remainingSize;
+        newBlock->user = NULL;
+        newBlock->prev = rover;
+        newBlock->next = rover->next;
+
+        // set the next block to point to the new one
+        rover->next->prev = newBlock;
+        rover->next = newBlock;
+        rover->size = sizeToAlloc;
+
+        // index the new free block by its size class
+        mz__insertFreeBlock(zone, newBlock);
+        zone->usedSize += headerSize;
+        usedPayloadSize = padding + alignedSize;
+    }
+
+    zone->usedSize += usedPayloadSize;
+
+    rover->user = MZ__POINTER_OFFSET(void, mz__payloadPointer(rover), padding);
+    mz__writeBlockCheck(rover->user, mz__blockCheck(zone, rover));
+#if defined(SHL_MZ_THREAD_SAFE)
+    rover->owner = 0;
+    rover->sizeClass = 0;
+    atomic_store_explicit(&rover->cached, false, memory_order_relaxed);
+#endif
+
+    return rover->user;
+}
+
+static void* mz__allocAligned(memzone_t* zone, size_t size, size_t alignment)
 {
     if (zone == NULL || size == 0)
     {
@@ -458,7 +887,6 @@ void* mz_allocAligned(memzone_t* zone, size_t size, size_t alignment)
         return NULL;
     }
 
-    size_t headerSize = mz__headerSize();
     if (alignedSize > zone->maxSize - zone->usedSize)
     {
         char message[160];
@@ -469,44 +897,8 @@ void* mz_allocAligned(memzone_t* zone, size_t size, size_t alignment)
         return NULL;
     }
 
-    memblock_t* start = zone->rover != NULL ? zone->rover : &zone->blockList;
-    memblock_t* rover = start;
-    size_t padding = 0;
-    size_t sizeToAlloc = 0;
-    bool found = false;
-    do
-    {
-        if (MZ__IS_BLOCK_EMPTY(rover))
-        {
-            uintptr_t payloadAddress = (uintptr_t)mz__payloadPointer(rover);
-            size_t currentPadding = 0;
-            size_t remainder = payloadAddress % alignment;
-            if (remainder != 0)
-            {
-                currentPadding = alignment - remainder;
-            }
-
-            if (currentPadding <= mz__payloadSize(rover) && alignedSize <= mz__payloadSize(rover) - currentPadding)
-            {
-                size_t currentSizeToAlloc = headerSize + currentPadding;
-                if (alignedSize <= ((size_t)-1) - currentSizeToAlloc)
-                {
-                    currentSizeToAlloc += alignedSize;
-                    if (rover->size >= currentSizeToAlloc)
-                    {
-                        padding = currentPadding;
-                        sizeToAlloc = currentSizeToAlloc;
-                        found = true;
-                        break;
-                    }
-                }
-            }
-        }
-
-        rover = rover->next;
-    } while (rover != start);
-
-    if (!found)
+    void* p = mz__takeFreeBlock(zone, alignedSize, alignment);
+    if (p == NULL)
     {
         char message[160];
         snprintf(message, sizeof(message),
@@ -516,43 +908,14 @@ void* mz_allocAligned(memzone_t* zone, size_t size, size_t alignment)
         return NULL;
     }
 
-    size_t usedPayloadSize = mz__payloadSize(rover);
-    size_t remainingSize = rover->size - sizeToAlloc;
-    if (remainingSize >= headerSize + mz_alignment())
-    {
-        // create a new empty block with the remaining free space
-        memblock_t* newBlock = MZ__POINTER_OFFSET(memblock_t, rover, sizeToAlloc);
-        newBlock->size = remainingSize;
-        newBlock->user = NULL;
-        newBlock->prev = rover;
-        newBlock->next = rover->next;
-
-        // set the next block to point to the new one
-        rover->next->prev = newBlock;
-        rover->next = newBlock;
-        rover->size = sizeToAlloc;
-
-        // update the zone rover with the new free block created
-        zone->rover = newBlock;
-        zone->usedSize += headerSize;
-        usedPayloadSize = padding + alignedSize;
-    }
-    else
-    {
-        zone->rover = rover->next;
-    }
-
-    zone->usedSize += usedPayloadSize;
-
-    rover->user = MZ__POINTER_OFFSET(void, mz__payloadPointer(rover), padding);
-    memset(rover->user, 0, alignedSize);
-    mz__debugAssertValid(zone);
-    return rover->user;
-}
-
-void mz_free(memzone_t* zone, void* p)
-{
-    if (zone == NULL || p == NULL)
+    memset(p, 0, alignedSize);
+    mz__debugAssertValid(zone);
+    return p;
+}
+
+static void mz__free(memzone_t* zone, void* p)
+{
+    if (zone == NULL || p == NULL)
     {
         return;
     }
@@ -565,7 +928,7 @@ void mz_free(memzone_t* zone, void* p)
     }
 
     rover->user = NULL;
-    zone->rover = rover;
+    mz__writeBlockCheck(p, 0);
 
     zone->usedSize -= mz__payloadSize(rover);
 
@@ -573,31 +936,30 @@ void mz_free(memzone_t* zone, void* p)
     if (rover->next != rover && MZ__IS_BLOCK_EMPTY(rover->next) && mz__isNextBlockAdjacent(rover))
     {
         memblock_t* next = rover->next;
+        mz__removeFreeBlock(zone, next);
         rover->size += next->size;
         rover->next = next->next;
         rover->next->prev = rover;
         zone->usedSize -= mz__headerSize();
-        if (zone->rover == next)
-        {
-            zone->rover = rover;
-        }
     }
 
     // merge with previous if empty
     if (rover->prev != rover && MZ__IS_BLOCK_EMPTY(rover->prev) && mz__isPrevBlockAdjacent(rover))
     {
         memblock_t* prev = rover->prev;
+        mz__removeFreeBlock(zone, prev);
         prev->size += rover->size;
         prev->next = rover->next;
         prev->next->prev = prev;
         zone->usedSize -= mz__headerSize();
-        zone->rover = prev;
+        rover = prev;
     }
 
+    mz__insertFreeBlock(zone, rover);
     mz__debugAssertValid(zone);
 }
 
-void* mz_realloc(memzone_t* zone, void* p, size_t size)
+static void* mz__realloc(memzone_t* zone, void* p, size_t size)
 {
     if (zone == NULL)
     {
@@ -606,12 +968,12 @@ void* mz_realloc(memzone_t* zone, void* p, size_t size)
 
     if (p == NULL)
     {
-        return mz_alloc(zone, size);
+        return mz__allocAligned(zone, size, mz_alignment());
     }
 
     if (size == 0)
     {
-        mz_free(zone, p);
+        mz__free(zone, p);
         return NULL;
     }
 
@@ -649,6 +1011,8 @@ void* mz_realloc(memzone_t* zone, void* p, size_t size)
         size_t extraNeeded = alignedSize - currentAllocSize;
         if (next->size >= extraNeeded)
         {
+            mz__removeFreeBlock(zone, next);
+
             size_t remainingSize = next->size - extraNeeded;
             if (remainingSize >= headerSize + mz_alignment())
             {
@@ -666,8 +1030,8 @@ void* mz_realloc(memzone_t* zone, void* p, size_t size)
                 block->size += extraNeeded;
                 block->next = newBlock;
 
+                mz__insertFreeBlock(zone, newBlock);
                 zone->usedSize += extraNeeded;
-                zone->rover = newBlock;
             }
             else
             {
@@ -676,10 +1040,6 @@ void* mz_realloc(memzone_t* zone, void* p, size_t size)
                 block->next = next->next;
                 block->next->prev = block;
                 zone->usedSize += nextSize - mz__headerSize();
-                if (zone->rover == next)
-                {
-                    zone->rover = block->next;
-                }
             }
 
             mz__debugAssertValid(zone);
@@ -688,33 +1048,22 @@ void* mz_realloc(memzone_t* zone, void* p, size_t size)
     }
 
     // Case 3: allocate new block, copy data, free old block
-    void* newP = mz_alloc(zone, size);
+    void* newP = mz__allocAligned(zone, size, mz_alignment());
     if (newP == NULL)
     {
         return NULL;
     }
 
     memcpy(newP, p, currentAllocSize);
-    mz_free(zone, p);
+    mz__free(zone, p);
     return newP;
 }
 
-bool mz_contains(const memzone_t* zone, const void* p)
-{
-    return mz__findBlock(zone, p) != NULL;
-}
-
-size_t mz_allocationSize(const memzone_t* zone, const void* p)
-{
-    const memblock_t* block = mz__findBlock(zone, p);
-    return mz__allocationSize(block);
-}
-
-bool mz_validate(const memzone_t* zone)
+static bool mz__validate(const memzone_t* zone)
 {
-    if (zone == NULL || zone->rover == NULL)
+    if (zone == NULL)
     {
-        return mz__validationFailure(zone, zone != NULL ? (const void*)zone->rover : NULL, "zone or rover pointer is null");
+        return mz__validationFailure(zone, NULL, "zone pointer is null");
     }
 
     const uint8_t* zoneStart = (const uint8_t*)zone;
@@ -736,7 +1085,7 @@ bool mz_validate(const memzone_t* zone)
     size_t totalBlockSize = 0;
     size_t totalAllocatedPayload = 0;
     int32_t blockCount = 0;
-    bool roverFound = false;
+    int32_t freeBlockCount = 0;
     const memblock_t* previousBlock = NULL;
 
     const memblock_t* rover = &zone->blockList;
@@ -796,12 +1145,16 @@ bool mz_validate(const memzone_t* zone)
                 return mz__validationFailure(zone, rover, "user pointer is not aligned to the allocator alignment");
             }
 
+            if ((const uint8_t*)rover->user - payloadStart >= MZ__MAX_ALIGNMENT || mz__readBlockCheck(rover->user) != mz__blockCheck(zone, rover))
+            {
+                return mz__validationFailure(zone, rover, "the check word before the user pointer does not point back at the block");
+            }
+
             totalAllocatedPayload += mz__payloadSize(rover);
         }
-
-        if (rover == zone->rover)
+        else
         {
-            roverFound = true;
+            freeBlockCount++;
         }
 
         previousBlock = rover;
@@ -816,11 +1169,6 @@ bool mz_validate(const memzone_t* zone)
         return mz__validationFailure(zone, &zone->blockList, "block links are not bidirectionally consistent");
     }
 
-    if (!roverFound)
-    {
-        return mz__validationFailure(zone, zone->rover, "rover does not point at a block in the circular list");
-    }
-
     if (totalBlockSize != zone->maxSize - offsetof(memzone_t, blockList))
     {
         return mz__validationFailure(zone, &zone->blockList, "total block size does not match the zone payload span");
@@ -836,6 +1184,62 @@ bool mz_validate(const memzone_t* zone)
         return mz__validationFailure(zone, zone, "used size does not match allocated payload plus allocator metadata");
     }
 
+    int32_t indexedFreeCount = 0;
+    for (int32_t fl = 0; fl < MZ__FL_COUNT; fl++)
+    {
+        for (int32_t sl = 0; sl < MZ__SL_COUNT; sl++)
+        {
+            bool isIndexed = ((zone->freeClasses[fl] >> sl) & 1) != 0;
+            if ((zone->freeLists[fl][sl] != NULL) != isIndexed)
+            {
+                return mz__validationFailure(zone, zone, "free list bitmaps do not match the free lists");
+            }
+
+            const memblock_t* previousFree = NULL;
+            for (const memblock_t* block = zone->freeLists[fl][sl]; block != NULL; block = block->nextFree)
+            {
+                if (++indexedFreeCount > freeBlockCount)
+                {
+                    return mz__validationFailure(zone, block, "free lists hold more blocks than the zone has free blocks");
+                }
+
+                if ((const uint8_t*)block < firstBlockStart || (const uint8_t*)block >= zoneEnd || ((uintptr_t)block % mz_alignment()) != 0)
+                {
+                    return mz__validationFailure(zone, block, "free list entry is not a block of the zone");
+                }
+
+                if (!MZ__IS_BLOCK_EMPTY(block))
+                {
+                    return mz__validationFailure(zone, block, "free list entry is an allocated block");
+                }
+
+                int32_t blockFl, blockSl;
+                mz__sizeClass(block->size, &blockFl, &blockSl);
+                if (blockFl != fl || blockSl != sl)
+                {
+                    return mz__validationFailure(zone, block, "free block is indexed in the wrong size class");
+                }
+
+                if (block->prevFree != previousFree)
+                {
+                    return mz__validationFailure(zone, block, "free list links are not bidirectionally consistent");
+                }
+
+                previousFree = block;
+            }
+        }
+
+        if ((((zone->freeLevels >> fl) & 1) != 0) != (zone->freeClasses[fl] != 0))
+        {
+            return mz__validationFailure(zone, zone, "free list bitmaps do not match the free lists");
+        }
+    }
+
+    if (indexedFreeCount != freeBlockCount)
+    {
+        return mz__validationFailure(zone, zone, "some free blocks are missing from the free lists");
+    }
+
     return true;
 }
 
@@ -848,12 +1252,14 @@ int32_t mz_blockCount(const memzone_t* zone)
 
     int32_t numberOfBlocks = 0;
 
+    MZ__LOCK(zone);
     const memblock_t* rover = &zone->blockList;
     do
     {
         numberOfBlocks++;
         rover = rover->next;
     } while (rover != &zone->blockList);
+    MZ__UNLOCK(zone);
 
     return numberOfBlocks;
 }
@@ -867,6 +1273,7 @@ size_t mz_usableFreeSize(const memzone_t* zone)
 
     size_t usableFreeSize = 0;
 
+    MZ__LOCK(zone);
     const memblock_t* rover = &zone->blockList;
     do
     {
@@ -877,6 +1284,7 @@ size_t mz_usableFreeSize(const memzone_t* zone)
 
         rover = rover->next;
     } while (rover != &zone->blockList);
+    MZ__UNLOCK(zone);
 
     return usableFreeSize;
 }
@@ -900,6 +1308,7 @@ float mz_fragmentation(const memzone_t* zone)
     size_t free = 0;
     size_t freeMax = 0;
 
+    MZ__LOCK(zone);
     const memblock_t* rover = &zone->blockList;
     do
     {
@@ -914,9 +1323,454 @@ float mz_fragmentation(const memzone_t* zone)
 
         rover = rover->next;
     } while (rover != &zone->blockList);
+    MZ__UNLOCK(zone);
 
     return free > 0 ? ((float)(free - freeMax) / free) * 100 : 0;
 }
 
+static bool mz__isCachedBlock(const memblock_t* block)
+{
+#if defined(SHL_MZ_THREAD_SAFE)
+    return block->owner != 0 && atomic_load_explicit(&block->cached, memory_order_relaxed);
+#else
+    (void)block;
+    return false;
+#endif
+}
+
+#if defined(SHL_MZ_THREAD_SAFE)
+static int32_t mz__cacheClass(size_t size, size_t alignment)
+{
+    if (alignment != mz_alignment() || size > ((size_t)1 << (MZ__CACHE_MIN_SHIFT + MZ__CACHE_CLASS_COUNT - 1)))
+    {
+        return -1;
+    }
+
+    return size <= ((size_t)1 << MZ__CACHE_MIN_SHIFT) ? 0 : mz__floorLog2(size - 1) + 1 - MZ__CACHE_MIN_SHIFT;
+}
+
+static size_t mz__cacheClassSize(int32_t sizeClass)
+{
+    return (size_t)1 << (sizeClass + MZ__CACHE_MIN_SHIFT);
+}
+
+static memblock_t* mz__cachedBlock(const memzone_t* zone, const void* p)
+{
+    return (memblock_t*)(mz__readBlockCheck(p) ^ zone->blockKey);
+}
+
+static void* mz__nextRemoteFree(const void* p)
+{
+    void* next;
+    memcpy(&next, p, sizeof(void*));
+    return next;
+}
+
+static mz__threadCache_t* mz__threadCache(memzone_t* zone, bool create)
+{
+    mz__threadSlot_t* freeSlot = NULL;
+
+    for (int32_t i = 0; i < MZ__THREAD_SLOT_COUNT; i++)
+    {
+        mz__threadSlot_t* slot = &mz__threadSlots[i];
+        if (slot->zone == zone && slot->zoneId == zone->id)
+        {
+            return slot->cache >= 0 ? zone->caches[slot->cache] : NULL;
+        }
+
+        // a slot of another zone created at the same address is stale
+        if (freeSlot == NULL && (slot->zone == NULL || slot->zone == zone))
+        {
+            freeSlot = slot;
+        }
+    }
+
+    if (!create)
+    {
+        return NULL;
+    }
+
+    // the zone of an evicted slot may be gone, so its cache stays held by this thread until it uses that zone again
+    if (freeSlot == NULL)
+    {
+        freeSlot = &mz__threadSlots[0];
+        for (int32_t i = 1; i < MZ__THREAD_SLOT_COUNT; i++)
+        {
+            if (mz__threadSlots[i].stamp - freeSlot->stamp > UINT32_MAX / 2)
+            {
+                freeSlot = &mz__threadSlots[i];
+            }
+        }
+    }
+
+    MZ__LOCK(zone);
+
+    // a cache this thread held before its slot was evicted comes first, then any free one
+    int32_t index = -1;
+    for (int32_t i = 0; i < zone->cacheCount; i++)
+    {
+        if (zone->caches[i]->holder == mz__threadSlots)
+        {
+            index = i;
+            break;
+        }
+
+        if (index < 0 && zone->caches[i]->holder == NULL)
+        {
+            index = i;
+        }
+    }
+
+    if (index < 0 && zone->cacheCount < SHL_MZ_MAX_THREADS)
+    {
+        mz__threadCache_t* cache = (mz__threadCache_t*)SHL_MZ_MALLOC(sizeof(mz__threadCache_t));
+        if (cache != NULL)
+        {
+            memset(cache, 0, sizeof(mz__threadCache_t));
+            atomic_init(&cache->remoteFrees, NULL);
+            cache->index = zone->cacheCount;
+            zone->caches[zone->cacheCount++] = cache;
+            index = cache->index;
+        }
+    }
+
+    if (index >= 0)
+    {
+        zone->caches[index]->holder = mz__threadSlots;
+    }
+
+    MZ__UNLOCK(zone);
+
+    *freeSlot = (mz__threadSlot_t){ zone, zone->id, index, mz__threadSlotStamp++ };
+    return index >= 0 ? zone->caches[index] : NULL;
+}
+
+static void mz__refillCache(memzone_t* zone, mz__threadCache_t* cache, int32_t sizeClass)
+{
+    // the blocks other threads gave back come first, the ones that don't fit go back to the zone
+    void* overflow = NULL;
+    void* remote = atomic_exchange_explicit(&cache->remoteFrees, NULL, memory_order_acquire);
+    while (remote != NULL)
+    {
+        void* next = mz__nextRemoteFree(remote);
+        int32_t remoteClass = mz__cachedBlock(zone, remote)->sizeClass;
+        if (cache->counts[remoteClass] < MZ__MAGAZINE_SIZE)
+        {
+            cache->items[remoteClass][cache->counts[remoteClass]++] = remote;
+        }
+        else
+        {
+            memcpy(remote, &overflow, sizeof(void*));
+            overflow = remote;
+        }
+
+        remote = next;
+    }
+
+    if (cache->counts[sizeClass] > 0 && overflow == NULL)
+    {
+        return;
+    }
+
+    MZ__LOCK(zone);
+
+    while (overflow != NULL)
+    {
+        void* next = mz__nextRemoteFree(overflow);
+        mz__free(zone, overflow);
+        overflow = next;
+    }
+
+    size_t classSize = mz__cacheClassSize(sizeClass);
+    while (cache->counts[sizeClass] < MZ__MAGAZINE_BATCH)
+    {
+        void* p = mz__takeFreeBlock(zone, classSize, mz_alignment());
+        if (p == NULL)
+        {
+            break;
+        }
+
+        memblock_t* block = mz__cachedBlock(zone, p);
+        block->owner = (uint16_t)(cache->index + 1);
+        block->sizeClass = (uint8_t)sizeClass;
+        atomic_store_explicit(&block->cached, true, memory_order_relaxed);
+        cache->items[sizeClass][cache->counts[sizeClass]++] = p;
+    }
+
+    mz__debugAssertValid(zone);
+    MZ__UNLOCK(zone);
+}
+
+static void* mz__cacheAlloc(memzone_t* zone, mz__threadCache_t* cache, int32_t sizeClass)
+{
+    if (cache->counts[sizeClass] == 0)
+    {
+        mz__refillCache(zone, cache, sizeClass);
+        if (cache->counts[sizeClass] == 0)
+        {
+            return NULL;
+        }
+    }
+
+    void* p = cache->items[sizeClass][--cache->counts[sizeClass]];
+    atomic_store_explicit(&mz__cachedBlock(zone, p)->cached, false, memory_order_relaxed);
+    memset(p, 0, mz__cacheClassSize(sizeClass));
+    return p;
+}
+
+static void mz__cacheFree(memzone_t* zone, memblock_t* block, void* p)
+{
+    mz__threadCache_t* cache = mz__threadCache(zone, false);
+    if (cache != NULL && cache->index == block->owner - 1)
+    {
+        // only a double free races with the owner here, so a plain load and store are enough
+        if (atomic_load_explicit(&block->cached, memory_order_relaxed))
+        {
+            mz__report(zone, MZ_REPORT_INVALID_FREE, p, "pointer was already freed to a thread cache");
+            return;
+        }
+
+        atomic_store_explicit(&block->cached, true, memory_order_relaxed);
+
+        // a full magazine gives its oldest half back to the zone
+        int32_t sizeClass = block->sizeClass;
+        if (cache->counts[sizeClass] == MZ__MAGAZINE_SIZE)
+        {
+            MZ__LOCK(zone);
+            for (int32_t i = 0; i < MZ__MAGAZINE_BATCH; i++)
+            {
+                mz__free(zone, cache->items[sizeClass][i]);
+            }
+            MZ__UNLOCK(zone);
+
+            memmove(cache->items[sizeClass], cache->items[sizeClass] + MZ__MAGAZINE_BATCH, (MZ__MAGAZINE_SIZE - MZ__MAGAZINE_BATCH) * sizeof(void*));
+            cache->counts[sizeClass] -= MZ__MAGAZINE_BATCH;
+        }
+
+        cache->items[sizeClass][cache->counts[sizeClass]++] = p;
+        return;
+    }
+
+    if (atomic_exchange_explicit(&block->cached, true, memory_order_relaxed))
+    {
+        mz__report(zone, MZ_REPORT_INVALID_FREE, p, "pointer was already freed to a thread cache");
+        return;
+    }
+
+    // blocks of other threads are queued on their cache, linked through the payload
+    mz__threadCache_t* owner = zone->caches[block->owner - 1];
+    void* head = atomic_load_explicit(&owner->remoteFrees, memory_order_relaxed);
+    do
+    {
+        memcpy(p, &head, sizeof(void*));
+    } while (!atomic_compare_exchange_weak_explicit(&owner->remoteFrees, &head, p, memory_order_release, memory_order_relaxed));
+}
+#endif
+
+void* mz_allocAligned(memzone_t* zone, size_t size, size_t alignment)
+{
+    if (zone == NULL || size == 0)
+    {
+        return NULL;
+    }
+
+#if defined(SHL_MZ_THREAD_SAFE)
+    int32_t sizeClass = mz__cacheClass(size, alignment);
+    if (sizeClass >= 0)
+    {
+        mz__threadCache_t* cache = mz__threadCache(zone, true);
+        if (cache != NULL)
+        {
+            void* p = mz__cacheAlloc(zone, cache, sizeClass);
+            if (p != NULL)
+            {
+                return p;
+            }
+        }
+    }
+#endif
+
+    MZ__LOCK(zone);
+    void* p = mz__allocAligned(zone, size, alignment);
+    MZ__UNLOCK(zone);
+    return p;
+}
+
+void mz_free(memzone_t* zone, void* p)
+{
+    if (zone == NULL || p == NULL)
+    {
+        return;
+    }
+
+#if defined(SHL_MZ_THREAD_SAFE)
+    memblock_t* block = (memblock_t*)mz__findBlock(zone, p);
+    if (block != NULL && block->owner != 0)
+    {
+        mz__cacheFree(zone, block, p);
+        return;
+    }
+#endif
+
+    MZ__LOCK(zone);
+    mz__free(zone, p);
+    MZ__UNLOCK(zone);
+}
+
+void* mz_realloc(memzone_t* zone, void* p, size_t size)
+{
+#if defined(SHL_MZ_THREAD_SAFE)
+    if (zone != NULL && p != NULL && size != 0)
+    {
+        memblock_t* block = (memblock_t*)mz__findBlock(zone, p);
+        if (block != NULL && block->owner != 0)
+        {
+            if (mz__isCachedBlock(block))
+            {
+                mz__report(zone, MZ_REPORT_INVALID_FREE, p, "pointer was already freed to a thread cache");
+                return NULL;
+            }
+
+            // cached blocks keep their size class, so they only move to grow past it
+            size_t classSize = mz__cacheClassSize(block->sizeClass);
+            if (size <= classSize)
+            {
+                return p;
+            }
+
+            void* newP = mz_alloc(zone, size);
+            if (newP == NULL)
+            {
+                return NULL;
+            }
+
+            memcpy(newP, p, classSize);
+            mz_free(zone, p);
+            return newP;
+        }
+    }
+#endif
+
+    if (zone == NULL)
+    {
+        return NULL;
+    }
+
+    MZ__LOCK(zone);
+    void* newP = mz__realloc(zone, p, size);
+    MZ__UNLOCK(zone);
+    return newP;
+}
+
+bool mz_contains(const memzone_t* zone, const void* p)
+{
+    if (zone == NULL)
+    {
+        return false;
+    }
+
+    MZ__LOCK(zone);
+    const memblock_t* block = mz__findBlock(zone, p);
+    bool contains = block != NULL && !mz__isCachedBlock(block);
+    MZ__UNLOCK(zone);
+    return contains;
+}
+
+size_t mz_allocationSize(const memzone_t* zone, const void* p)
+{
+    if (zone == NULL)
+    {
+        return 0;
+    }
+
+    MZ__LOCK(zone);
+    const memblock_t* block = mz__findBlock(zone, p);
+    size_t allocationSize = block != NULL && !mz__isCachedBlock(block) ? mz__allocationSize(block) : 0;
+    MZ__UNLOCK(zone);
+    return allocationSize;
+}
+
+bool mz_validate(const memzone_t* zone)
+{
+    if (zone == NULL)
+    {
+        return mz__validate(zone);
+    }
+
+    MZ__LOCK(zone);
+    bool valid = mz__validate(zone);
+    MZ__UNLOCK(zone);
+    return valid;
+}
+
+void mz_threadFlush(memzone_t* zone)
+{
+#if defined(SHL_MZ_THREAD_SAFE)
+    if (zone == NULL)
+    {
+        return;
+    }
+
+    mz__threadCache_t* cache = NULL;
+    for (int32_t i = 0; i < MZ__THREAD_SLOT_COUNT; i++)
+    {
+        mz__threadSlot_t* slot = &mz__threadSlots[i];
+        if (slot->zone == zone && slot->zoneId == zone->id)
+        {
+            cache = slot->cache >= 0 ? zone->caches[slot->cache] : NULL;
+            *slot = (mz__threadSlot_t){0};
+            break;
+        }
+    }
+
+    MZ__LOCK(zone);
+
+    // the slot may have been evicted while this thread still holds the cache
+    for (int32_t i = 0; cache == NULL && i < zone->cacheCount; i++)
+    {
+        if (zone->caches[i]->holder == mz__threadSlots)
+        {
+            cache = zone->caches[i];
+        }
+    }
+
+    if (cache != NULL)
+    {
+        for (int32_t sizeClass = 0; sizeClass < MZ__CACHE_CLASS_COUNT; sizeClass++)
+        {
+            for (int32_t i = 0; i < cache->counts[sizeClass]; i++)
+            {
+                mz__free(zone, cache->items[sizeClass][i]);
+            }
+
+            cache->counts[sizeClass] = 0;
+        }
+
+        cache->holder = NULL;
+    }
+
+    // no thread takes the remote frees of the caches nobody holds, so they go back to the zone here
+    for (int32_t i = 0; i < zone->cacheCount; i++)
+    {
+        if (zone->caches[i]->holder != NULL)
+        {
+            continue;
+        }
+
+        void* remote = atomic_exchange_explicit(&zone->caches[i]->remoteFrees, NULL, memory_order_acquire);
+        while (remote != NULL)
+        {
+            void* next = mz__nextRemoteFree(remote);
+            mz__free(zone, remote);
+            remote = next;
+        }
+    }
+
+    MZ__UNLOCK(zone);
+#else
+    (void)zone;
+#endif
+}
+
 #endif // SHL_MZ_IMPLEMENTATION
 #endif // SHL_MZ_H
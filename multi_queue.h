@@ -0,0 +1,260 @@
+/*
+    multi_queue.h - acoto87 (acoto87@gmail.com)
+
+    MIT License
+
+    Copyright (c) 2018 Alejandro Coto Gutiérrez
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Single-header macro library to declare and define strongly typed
+    concurrent priority queues for multi-threaded schedulers.
+
+    USAGE
+    Declare a queue type with shlDeclareMultiQueue(name, type), then define it
+    once with shlDefineMultiQueue(name, type) in a C source file. Requires C11
+    atomics and binary_heap.h.
+
+    CUSTOMISATION
+    Provide a compare function that orders items, an optional free function
+    for owned values, the number of threads that will use the queue and the
+    relaxation factor, the number of sub-queues per thread.
+
+    NOTES
+    This is a MultiQueue: the items are spread over threadCount * relaxation
+    binary heaps, each one guarded by its own try-lock. Push adds the item to
+    a random heap that isn't locked. Pop locks two random heaps and removes
+    the smaller of their tops, so it returns one of the smallest items in the
+    queue rather than the smallest one; a larger relaxation factor means less
+    contention and a looser order. Pop only reports an empty queue after
+    checking every heap. Each lock shares a cache line with its own heap
+    header and nothing else: the slots are aligned to SHL__CACHE_LINE_SIZE
+    and Init over-allocates the slot array by one line to align it, so it
+    works with any SHL_MALLOC. Init and Free are not thread-safe.
+*/
+
+#ifndef SHL_MULTI_QUEUE_H
+#define SHL_MULTI_QUEUE_H
+
+#include <stdatomic.h>
+
+#include "binary_heap.h"
+
+#define SHL__MULTI_QUEUE_DEFAULT_THREAD_COUNT 4
+#define SHL__MULTI_QUEUE_DEFAULT_RELAXATION 2
+#define SHL__MULTI_QUEUE_EMPTY_TRIES 4
+
+static inline uint32_t shl__multiQueueRandom(void)
+{
+    static _Thread_local uint32_t state = 0;
+
+    if (state == 0)
+        state = (uint32_t)(uintptr_t)&state | 1u;
+
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+#define shlDeclareMultiQueue(typeName, itemType) \
+    shlDeclareBinaryHeap(typeName ## __Heap, itemType) \
+    \
+    typedef struct \
+    { \
+        itemType defaultValue; \
+        int32_t (*compareFn)(const itemType item1, const itemType item2); \
+        void (*freeFn)(itemType item); \
+        int32_t threadCount; \
+        int32_t relaxation; \
+        int32_t arity; \
+    } typeName ## Options; \
+    \
+    typedef struct \
+    { \
+        _Alignas(SHL__CACHE_LINE_SIZE) atomic_bool locked; \
+        typeName ## __Heap heap; \
+    } typeName ## __Slot; \
+    \
+    typedef struct \
+    { \
+        _Alignas(SHL__CACHE_LINE_SIZE) atomic_int count; \
+        _Alignas(SHL__CACHE_LINE_SIZE) int32_t queueCount; \
+        int32_t (*compareFn)(const itemType item1, const itemType item2); \
+        itemType defaultValue; \
+        typeName ## __Slot* queues; \
+        void* queuesBlock; \
+    } typeName; \
+    \
+    void typeName ## Init(typeName* queue, typeName ## Options options); \
+    void typeName ## Free(typeName* queue); \
+    void typeName ## Push(typeName* queue, itemType value); \
+    bool typeName ## Peek(typeName* queue, itemType* value); \
+    bool typeName ## Pop(typeName* queue, itemType* value); \
+    int32_t typeName ## Count(typeName* queue);
+
+#define shlDefineMultiQueue(typeName, itemType) \
+    shlDefineBinaryHeap(typeName ## __Heap, itemType) \
+    \
+    bool typeName ## __tryLock(typeName ## __Slot* slot) \
+    { \
+        return !atomic_load_explicit(&slot->locked, memory_order_relaxed) && \
+               !atomic_exchange_explicit(&slot->locked, true, memory_order_acquire); \
+    } \
+    \
+    void typeName ## __unlock(typeName ## __Slot* slot) \
+    { \
+        atomic_store_explicit(&slot->locked, false, memory_order_release); \
+    } \
+    \
+    typeName ## __Slot* typeName ## __lockRandom(typeName* queue) \
+    { \
+        for (;;) \
+        { \
+            typeName ## __Slot* slot = &queue->queues[shl__multiQueueRandom() % (uint32_t)queue->queueCount]; \
+            if (typeName ## __tryLock(slot)) \
+                return slot; \
+        } \
+    } \
+    \
+    typeName ## __Slot* typeName ## __lockBest(typeName* queue) \
+    { \
+        for(int32_t tries = 0; tries < SHL__MULTI_QUEUE_EMPTY_TRIES; tries++) \
+        { \
+            typeName ## __Slot* first = typeName ## __lockRandom(queue); \
+            typeName ## __Slot* second = &queue->queues[shl__multiQueueRandom() % (uint32_t)queue->queueCount]; \
+            \
+            if (second != first && typeName ## __tryLock(second)) \
+            { \
+                if (second->heap.count > 0 && \
+                    (first->heap.count == 0 || queue->compareFn(second->heap.items[0], first->heap.items[0]) < 0)) \
+                { \
+                    typeName ## __Slot* tmp = first; \
+                    first = second; \
+                    second = tmp; \
+                } \
+                \
+                typeName ## __unlock(second); \
+            } \
+            \
+            if (first->heap.count > 0) \
+                return first; \
+            \
+            typeName ## __unlock(first); \
+        } \
+        \
+        for(int32_t i = 0; i < queue->queueCount; i++) \
+        { \
+            typeName ## __Slot* slot = &queue->queues[i]; \
+            while (!typeName ## __tryLock(slot)) \
+                ; \
+            \
+            if (slot->heap.count > 0) \
+                return slot; \
+            \
+            typeName ## __unlock(slot); \
+        } \
+        \
+        return 0; \
+    } \
+    \
+    void typeName ## Init(typeName* queue, typeName ## Options options) \
+    { \
+        int32_t threadCount = options.threadCount > 0 ? options.threadCount : SHL__MULTI_QUEUE_DEFAULT_THREAD_COUNT; \
+        int32_t relaxation = options.relaxation > 0 ? options.relaxation : SHL__MULTI_QUEUE_DEFAULT_RELAXATION; \
+        \
+        queue->queueCount = threadCount * relaxation; \
+        queue->compareFn = options.compareFn; \
+        queue->defaultValue = options.defaultValue; \
+        queue->queuesBlock = SHL_MALLOC((size_t)queue->queueCount * sizeof(typeName ## __Slot) + SHL__CACHE_LINE_SIZE - 1); \
+        queue->queues = (typeName ## __Slot *)(((uintptr_t)queue->queuesBlock + SHL__CACHE_LINE_SIZE - 1) & ~(uintptr_t)(SHL__CACHE_LINE_SIZE - 1)); \
+        atomic_init(&queue->count, 0); \
+        \
+        for(int32_t i = 0; i < queue->queueCount; i++) \
+        { \
+            atomic_init(&queue->queues[i].locked, false); \
+            typeName ## __HeapInit(&queue->queues[i].heap, (typeName ## __HeapOptions){ \
+                .defaultValue = options.defaultValue, \
+                .compareFn = options.compareFn, \
+                .freeFn = options.freeFn, \
+                .arity = options.arity \
+            }); \
+        } \
+    } \
+    \
+    void typeName ## Free(typeName* queue) \
+    { \
+        if (!queue->queues) \
+            return; \
+        \
+        for(int32_t i = 0; i < queue->queueCount; i++) \
+            typeName ## __HeapFree(&queue->queues[i].heap); \
+        \
+        SHL_FREE(queue->queuesBlock); \
+        queue->queues = 0; \
+        queue->queuesBlock = 0; \
+        atomic_store_explicit(&queue->count, 0, memory_order_relaxed); \
+    } \
+    \
+    void typeName ## Push(typeName* queue, itemType value) \
+    { \
+        typeName ## __Slot* slot = typeName ## __lockRandom(queue); \
+        typeName ## __HeapPush(&slot->heap, value); \
+        typeName ## __unlock(slot); \
+        \
+        atomic_fetch_add_explicit(&queue->count, 1, memory_order_relaxed); \
+    } \
+    \
+    bool typeName ## Peek(typeName* queue, itemType* value) \
+    { \
+        if (atomic_load_explicit(&queue->count, memory_order_relaxed) <= 0) \
+            return false; \
+        \
+        typeName ## __Slot* slot = typeName ## __lockBest(queue); \
+        if (!slot) \
+            return false; \
+        \
+        *value = typeName ## __HeapPeek(&slot->heap); \
+        typeName ## __unlock(slot); \
+        return true; \
+    } \
+    \
+    bool typeName ## Pop(typeName* queue, itemType* value) \
+    { \
+        if (atomic_load_explicit(&queue->count, memory_order_relaxed) <= 0) \
+            return false; \
+        \
+        typeName ## __Slot* slot = typeName ## __lockBest(queue); \
+        if (!slot) \
+            return false; \
+        \
+        *value = typeName ## __HeapPop(&slot->heap); \
+        typeName ## __unlock(slot); \
+        \
+        atomic_fetch_sub_explicit(&queue->count, 1, memory_order_relaxed); \
+        return true; \
+    } \
+    \
+    int32_t typeName ## Count(typeName* queue) \
+    { \
+        int32_t count = atomic_load_explicit(&queue->count, memory_order_relaxed); \
+        return count > 0 ? count : 0; \
+    }
+
+#endif // SHL_MULTI_QUEUE_H
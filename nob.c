@@ -12,45 +12,65 @@ typedef struct
     const char* source;
     const char* output;
     const char* extraSource;  /* optional second source file (multi-TU tests) */
+    const char* standard;     /* optional C standard, defaults to c99 */
 } TestTarget;
 
 typedef enum
 {
     BuildModeDefault,
     BuildModeAsan,
-    BuildModeValgrind
+    BuildModeValgrind,
+    BuildModeBench
 } BuildMode;
 
 static const TestTarget TestTargets[] =
 {
-    { "tests/array_test.c",           "array_test",           NULL },
-    { "tests/binary_heap_test.c",     "binary_heap_test",     NULL },
-    { "tests/flic_test.c",            "flic_test",            NULL },
-    { "tests/list_test.c",            "list_test",            NULL },
-    { "tests/map_test.c",             "map_test",             NULL },
-    { "tests/memory_buffer_test.c",   "memory_buffer_test",   NULL },
-    { "tests/memzone_test.c",         "memzone_test",         NULL },
-    { "tests/memzone_audit_test.c",   "memzone_audit_test",   NULL },
-    { "tests/queue_test.c",           "queue_test",           NULL },
-    { "tests/set_test.c",             "set_test",             NULL },
-    { "tests/stack_test.c",           "stack_test",           NULL },
-    { "tests/wav_test.c",             "wav_test",             NULL },
-    { "tests/wstr_test.c",            "wstr_test",            NULL },
-    { "tests/multi_tu_test.c",        "multi_tu_test",        "tests/multi_tu_helper.c" },
+    { "tests/array_test.c",               "array_test",               NULL,                      NULL },
+    { "tests/binary_heap_test.c",         "binary_heap_test",         NULL,                      NULL },
+    { "tests/chunk_list_test.c",          "chunk_list_test",          NULL,                      NULL },
+    { "tests/concurrent_queue_test.c",    "concurrent_queue_test",    NULL,                      "c11" },
+    { "tests/flic_test.c",                "flic_test",                NULL,                      NULL },
+    { "tests/list_test.c",                "list_test",                NULL,                      NULL },
+    { "tests/map_test.c",                 "map_test",                 NULL,                      NULL },
+    { "tests/memory_buffer_test.c",       "memory_buffer_test",       NULL,                      NULL },
+    { "tests/memzone_test.c",             "memzone_test",             NULL,                      NULL },
+    { "tests/memzone_audit_test.c",       "memzone_audit_test",       NULL,                      NULL },
+    { "tests/memzone_thread_test.c",      "memzone_thread_test",      NULL,                      "c11" },
+    { "tests/multi_queue_test.c",         "multi_queue_test",         NULL,                      "c11" },
+    { "tests/pairing_heap_test.c",        "pairing_heap_test",        NULL,                      NULL },
+    { "tests/queue_test.c",               "queue_test",               NULL,                      NULL },
+    { "tests/radix_heap_test.c",          "radix_heap_test",          NULL,                      NULL },
+    { "tests/set_test.c",                 "set_test",                 NULL,                      NULL },
+    { "tests/sparse_grid_test.c",         "sparse_grid_test",         NULL,                      NULL },
+    { "tests/stack_test.c",               "stack_test",               NULL,                      NULL },
+    { "tests/wav_test.c",                 "wav_test",                 NULL,                      NULL },
+    { "tests/work_stealing_deque_test.c", "work_stealing_deque_test", NULL,                      "c11" },
+    { "tests/wstr_test.c",                "wstr_test",                NULL,                      NULL },
+    { "tests/multi_tu_test.c",            "multi_tu_test",            "tests/multi_tu_helper.c", NULL },
 };
 
-static const TestTarget* find_test_target(const char* name)
+static const TestTarget BenchTargets[] =
+{
+    { "benchmarks/array_bench.c",               "array_bench",               NULL, NULL },
+    { "benchmarks/concurrent_queue_bench.c",    "concurrent_queue_bench",    NULL, "c11" },
+    { "benchmarks/memzone_bench.c",             "memzone_bench",             NULL, "c11" },
+    { "benchmarks/multi_queue_bench.c",         "multi_queue_bench",         NULL, "c11" },
+    { "benchmarks/radix_heap_bench.c",          "radix_heap_bench",          NULL, NULL },
+    { "benchmarks/work_stealing_deque_bench.c", "work_stealing_deque_bench", NULL, "c11" },
+};
+
+static const TestTarget* find_target(const TestTarget* targets, size_t count, const char* name)
 {
     if (name == NULL || strcmp(name, "all") == 0)
     {
         return NULL;
     }
 
-    for (size_t i = 0; i < NOB_ARRAY_LEN(TestTargets); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
-        if (strcmp(TestTargets[i].output, name) == 0)
+        if (strcmp(targets[i].output, name) == 0)
         {
-            return &TestTargets[i];
+            return &targets[i];
         }
     }
 
@@ -59,13 +79,14 @@ static const TestTarget* find_test_target(const char* name)
 
 static void print_usage(const char* program)
 {
-    nob_log(NOB_INFO, "Usage: %s [build|test|asan|valgrind] [all|test_name]", program);
-    nob_log(NOB_INFO, "Examples: %s test, %s test wstr_test, %s asan array_test", program, program, program);
+    nob_log(NOB_INFO, "Usage: %s [build|test|asan|valgrind|bench] [all|target_name]", program);
+    nob_log(NOB_INFO, "Examples: %s test, %s test wstr_test, %s asan array_test, %s bench", program, program, program, program);
 }
 
-static void append_mode_flags(Nob_Cmd* cmd, BuildMode mode)
+static void append_mode_flags(Nob_Cmd* cmd, BuildMode mode, const char* standard)
 {
-    nob_cmd_append(cmd, "-std=c99", "-Wall", "-Wextra", "-Wpedantic", "-I.", "-Itests", "-Itests/vendor/unity/src");
+    nob_cmd_append(cmd, nob_temp_sprintf("-std=%s", standard != NULL ? standard : "c99"));
+    nob_cmd_append(cmd, "-Wall", "-Wextra", "-Wpedantic", "-I.", "-Itests", "-Itests/vendor/unity/src");
 
     switch (mode)
     {
@@ -75,21 +96,24 @@ static void append_mode_flags(Nob_Cmd* cmd, BuildMode mode)
         case BuildModeValgrind:
             nob_cmd_append(cmd, "-O0", "-g", "-DSHL_LEAK_CHECK=1");
             break;
+        case BuildModeBench:
+            nob_cmd_append(cmd, "-O2", "-DNDEBUG");
+            break;
         case BuildModeDefault:
         default:
             break;
     }
 }
 
-static bool build_tests(BuildMode mode, const char* out_dir, const TestTarget* selected_target)
+static bool build_targets(const TestTarget* targets, size_t count, BuildMode mode, const char* out_dir, const TestTarget* selected_target)
 {
     if (!nob_mkdir_if_not_exists("build")) return false;
     if (!nob_mkdir_if_not_exists(out_dir)) return false;
 
-    for (size_t i = 0; i < NOB_ARRAY_LEN(TestTargets); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
         Nob_Cmd cmd = {0};
-        const TestTarget target = TestTargets[i];
+        const TestTarget target = targets[i];
         const char* output_path = nob_temp_sprintf("%s/%s", out_dir, target.output);
 
         if (selected_target != NULL && strcmp(target.output, selected_target->output) != 0)
@@ -98,12 +122,14 @@ static bool build_tests(BuildMode mode, const char* out_dir, const TestTarget* s
         }
 
         nob_cc(&cmd);
-        append_mode_flags(&cmd, mode);
+        append_mode_flags(&cmd, mode, target.standard);
         nob_cc_output(&cmd, output_path);
         nob_cmd_append(&cmd, target.source);
         if (target.extraSource != NULL)
             nob_cmd_append(&cmd, target.extraSource);
-        nob_cmd_append(&cmd, "tests/vendor/unity/src/unity.c", "-lm");
+        if (mode != BuildModeBench)
+            nob_cmd_append(&cmd, "tests/vendor/unity/src/unity.c");
+        nob_cmd_append(&cmd, "-lm", "-pthread");
 
         if (!nob_cmd_run_sync(cmd))
             return false;
@@ -112,12 +138,12 @@ static bool build_tests(BuildMode mode, const char* out_dir, const TestTarget* s
     return true;
 }
 
-static bool run_tests(const char* out_dir, BuildMode mode, const TestTarget* selected_target)
+static bool run_targets(const TestTarget* targets, size_t count, const char* out_dir, BuildMode mode, const TestTarget* selected_target)
 {
-    for (size_t i = 0; i < NOB_ARRAY_LEN(TestTargets); ++i)
+    for (size_t i = 0; i < count; ++i)
     {
         Nob_Cmd cmd = {0};
-        const TestTarget target = TestTargets[i];
+        const TestTarget target = targets[i];
         const char* output_path = nob_temp_sprintf("%s/%s", out_dir, target.output);
 
         if (selected_target != NULL && strcmp(target.output, selected_target->output) != 0)
@@ -155,6 +181,8 @@ int main(int argc, char** argv)
     const char* test_name = argc > 2 ? argv[2] : NULL;
     BuildMode mode = BuildModeDefault;
     const char* out_dir = "build/default";
+    const TestTarget* targets = TestTargets;
+    size_t target_count = NOB_ARRAY_LEN(TestTargets);
     const TestTarget* selected_target = NULL;
     bool run = false;
 
@@ -188,33 +216,41 @@ int main(int argc, char** argv)
         out_dir = "build/valgrind";
         run = true;
     }
+    else if (strcmp(command, "bench") == 0)
+    {
+        mode = BuildModeBench;
+        out_dir = "build/bench";
+        targets = BenchTargets;
+        target_count = NOB_ARRAY_LEN(BenchTargets);
+        run = true;
+    }
     else
     {
-        nob_log(NOB_ERROR, "Unknown command `%s`. Expected build, test, asan, or valgrind.", command);
+        nob_log(NOB_ERROR, "Unknown command `%s`. Expected build, test, asan, valgrind, or bench.", command);
         print_usage(argv[0]);
         return 1;
     }
 
     if (test_name != NULL)
     {
-        selected_target = find_test_target(test_name);
+        selected_target = find_target(targets, target_count, test_name);
         if (selected_target == NULL && strcmp(test_name, "all") != 0)
         {
-            nob_log(NOB_ERROR, "Unknown test `%s`.", test_name);
+            nob_log(NOB_ERROR, "Unknown target `%s`.", test_name);
             print_usage(argv[0]);
-            nob_log(NOB_INFO, "Available tests:");
-            for (size_t i = 0; i < NOB_ARRAY_LEN(TestTargets); ++i)
+            nob_log(NOB_INFO, "Available targets:");
+            for (size_t i = 0; i < target_count; ++i)
             {
-                nob_log(NOB_INFO, "  %s", TestTargets[i].output);
+                nob_log(NOB_INFO, "  %s", targets[i].output);
             }
             return 1;
         }
     }
 
-    if (!build_tests(mode, out_dir, selected_target))
+    if (!build_targets(targets, target_count, mode, out_dir, selected_target))
         return 1;
 
-    if (run && !run_tests(out_dir, mode, selected_target))
+    if (run && !run_targets(targets, target_count, out_dir, mode, selected_target))
         return 1;
 
     return 0;
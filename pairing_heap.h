@@ -0,0 +1,382 @@
+/*
+    pairing_heap.h - acoto87 (acoto87@gmail.com)
+
+    MIT License
+
+    Copyright (c) 2018 Alejandro Coto Gutiérrez
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Single-header macro library to declare and define strongly typed pairing
+    heaps, mergeable priority queues whose nodes come from a shared pool.
+
+    USAGE
+    Declare a heap type with shlDeclarePairingHeap(name, type), then define it
+    once with shlDefinePairingHeap(name, type) in a C source file. This also
+    declares a name##Pool type for the node pool.
+
+    CUSTOMISATION
+    Provide a compare function that orders items, a default value for empty
+    reads, an optional free function for owned values and an optional pool
+    to share with other heaps. Items are stored by copy.
+
+    NOTES
+    This implementation behaves as a min-heap according to compareFn. Push
+    and Meld are O(1), Pop is amortised O(log n) with the two-pass pairing.
+    The pool hands out nodes from a list of chunks that never move, so nodes
+    link to each other by pointer and popped nodes go to a free list for
+    reuse. Heaps that share a pool meld by linking their roots. When the other
+    heap owns its pool, Meld first moves that pool's chunks and free nodes
+    into this heap's pool with PoolAdopt, which is O(chunks + free nodes) and
+    doesn't touch the nodes themselves. A pool isn't thread-safe, but each
+    thread can fill a heap with its own pool and a single thread can meld
+    them all afterwards. Call Free to return the nodes to the pool and Clear
+    to dispose of retained items.
+*/
+
+#ifndef SHL_PAIRING_HEAP_H
+#define SHL_PAIRING_HEAP_H
+
+#include "shl_internal.h"
+
+#define shlDeclarePairingHeap(typeName, itemType) \
+    typedef struct typeName ## __Node \
+    { \
+        itemType value; \
+        struct typeName ## __Node* child; \
+        struct typeName ## __Node* sibling; \
+    } typeName ## __Node; \
+    \
+    typedef struct typeName ## __Chunk \
+    { \
+        struct typeName ## __Chunk* next; \
+        int32_t count; \
+        int32_t capacity; \
+        typeName ## __Node nodes[]; \
+    } typeName ## __Chunk; \
+    \
+    typedef struct \
+    { \
+        int32_t count; \
+        int32_t capacity; \
+        float growthFactor; \
+        typeName ## __Node* freeList; \
+        typeName ## __Chunk* chunks; \
+    } typeName ## Pool; \
+    \
+    typedef struct \
+    { \
+        itemType defaultValue; \
+        int32_t (*compareFn)(const itemType item1, const itemType item2); \
+        void (*freeFn)(itemType item); \
+        float growthFactor; \
+        typeName ## Pool* pool; \
+    } typeName ## Options; \
+    \
+    typedef struct \
+    { \
+        int32_t count; \
+        bool ownsPool; \
+        typeName ## __Node* root; \
+        int32_t (*compareFn)(const itemType item1, const itemType item2); \
+        void (*freeFn)(itemType item); \
+        itemType defaultValue; \
+        typeName ## Pool* pool; \
+    } typeName; \
+    \
+    void typeName ## PoolInit(typeName ## Pool* pool, int32_t capacity, float growthFactor); \
+    void typeName ## PoolFree(typeName ## Pool* pool); \
+    void typeName ## PoolAdopt(typeName ## Pool* pool, typeName ## Pool* other); \
+    void typeName ## Init(typeName* heap, typeName ## Options options); \
+    void typeName ## Free(typeName* heap); \
+    void typeName ## Push(typeName* heap, itemType value); \
+    itemType typeName ## Peek(typeName* heap); \
+    itemType typeName ## Pop(typeName* heap); \
+    bool typeName ## Meld(typeName* heap, typeName* other); \
+    void typeName ## Clear(typeName* heap);
+
+#define shlDefinePairingHeap(typeName, itemType) \
+    typeName ## __Node* typeName ## __link(typeName* heap, typeName ## __Node* first, typeName ## __Node* second) \
+    { \
+        if (heap->compareFn(second->value, first->value) < 0) \
+        { \
+            typeName ## __Node* tmp = first; \
+            first = second; \
+            second = tmp; \
+        } \
+        \
+        second->sibling = first->child; \
+        first->child = second; \
+        return first; \
+    } \
+    \
+    void typeName ## __addChunk(typeName ## Pool* pool, int32_t capacity) \
+    { \
+        typeName ## __Chunk* chunk = (typeName ## __Chunk *)SHL_MALLOC(sizeof(typeName ## __Chunk) + (size_t)capacity * sizeof(typeName ## __Node)); \
+        chunk->next = pool->chunks; \
+        chunk->count = 0; \
+        chunk->capacity = capacity; \
+        \
+        pool->chunks = chunk; \
+        pool->capacity += capacity; \
+    } \
+    \
+    void typeName ## PoolInit(typeName ## Pool* pool, int32_t capacity, float growthFactor) \
+    { \
+        pool->count = 0; \
+        pool->capacity = 0; \
+        pool->growthFactor = growthFactor; \
+        pool->freeList = 0; \
+        pool->chunks = 0; \
+        \
+        typeName ## __addChunk(pool, capacity > 0 ? capacity : SHL__INITIAL_CAPACITY); \
+    } \
+    \
+    void typeName ## PoolFree(typeName ## Pool* pool) \
+    { \
+        typeName ## __Chunk* chunk = pool->chunks; \
+        while (chunk) \
+        { \
+            typeName ## __Chunk* next = chunk->next; \
+            SHL_FREE(chunk); \
+            chunk = next; \
+        } \
+        \
+        pool->chunks = 0; \
+        pool->count = 0; \
+        pool->capacity = 0; \
+        pool->freeList = 0; \
+    } \
+    \
+    void typeName ## PoolAdopt(typeName ## Pool* pool, typeName ## Pool* other) \
+    { \
+        if (pool == other || !other->chunks) \
+            return; \
+        \
+        typeName ## __Chunk* lastChunk = other->chunks; \
+        while (lastChunk->next) \
+            lastChunk = lastChunk->next; \
+        \
+        if (!pool->chunks || \
+            other->chunks->capacity - other->chunks->count > pool->chunks->capacity - pool->chunks->count) \
+        { \
+            lastChunk->next = pool->chunks; \
+            pool->chunks = other->chunks; \
+        } \
+        else \
+        { \
+            lastChunk->next = pool->chunks->next; \
+            pool->chunks->next = other->chunks; \
+        } \
+        \
+        if (other->freeList) \
+        { \
+            typeName ## __Node* lastFree = other->freeList; \
+            while (lastFree->sibling) \
+                lastFree = lastFree->sibling; \
+            \
+            lastFree->sibling = pool->freeList; \
+            pool->freeList = other->freeList; \
+        } \
+        \
+        pool->count += other->count; \
+        pool->capacity += other->capacity; \
+        \
+        other->chunks = 0; \
+        other->freeList = 0; \
+        other->count = 0; \
+        other->capacity = 0; \
+    } \
+    \
+    void typeName ## Init(typeName* heap, typeName ## Options options) \
+    { \
+        heap->count = 0; \
+        heap->root = 0; \
+        heap->compareFn = options.compareFn; \
+        heap->freeFn = options.freeFn; \
+        heap->defaultValue = options.defaultValue; \
+        heap->pool = options.pool; \
+        heap->ownsPool = !options.pool; \
+        \
+        if (heap->ownsPool) \
+        { \
+            heap->pool = (typeName ## Pool *)SHL_MALLOC(sizeof(typeName ## Pool)); \
+            typeName ## PoolInit(heap->pool, 0, options.growthFactor); \
+        } \
+    } \
+    \
+    void typeName ## Free(typeName* heap) \
+    { \
+        if (!heap->pool) \
+            return; \
+        \
+        typeName ## Clear(heap); \
+        \
+        if (heap->ownsPool) \
+        { \
+            typeName ## PoolFree(heap->pool); \
+            SHL_FREE(heap->pool); \
+        } \
+        \
+        heap->pool = 0; \
+    } \
+    \
+    void typeName ## Push(typeName* heap, itemType value) \
+    { \
+        if (!heap->pool) \
+            return; \
+        \
+        typeName ## Pool* pool = heap->pool; \
+        typeName ## __Node* node = pool->freeList; \
+        \
+        if (node) \
+        { \
+            pool->freeList = node->sibling; \
+        } \
+        else \
+        { \
+            if (!pool->chunks || pool->chunks->count == pool->chunks->capacity) \
+            { \
+                int32_t newCapacity = shl__grownCapacity(pool->capacity, pool->capacity + 1, pool->growthFactor); \
+                typeName ## __addChunk(pool, newCapacity - pool->capacity); \
+            } \
+            \
+            node = &pool->chunks->nodes[pool->chunks->count++]; \
+            pool->count++; \
+        } \
+        \
+        node->value = value; \
+        node->child = 0; \
+        node->sibling = 0; \
+        \
+        heap->root = heap->root ? typeName ## __link(heap, heap->root, node) : node; \
+        heap->count++; \
+    } \
+    \
+    itemType typeName ## Peek(typeName* heap) \
+    { \
+        if (!heap->pool || !heap->root) \
+            return heap->defaultValue; \
+        \
+        return heap->root->value; \
+    } \
+    \
+    itemType typeName ## Pop(typeName* heap) \
+    { \
+        if (!heap->pool || !heap->root) \
+            return heap->defaultValue; \
+        \
+        typeName ## Pool* pool = heap->pool; \
+        typeName ## __Node* root = heap->root; \
+        itemType returnValue = root->value; \
+        \
+        typeName ## __Node* pairs = 0; \
+        typeName ## __Node* first = root->child; \
+        while (first) \
+        { \
+            typeName ## __Node* second = first->sibling; \
+            if (!second) \
+            { \
+                first->sibling = pairs; \
+                pairs = first; \
+                break; \
+            } \
+            \
+            typeName ## __Node* next = second->sibling; \
+            first->sibling = 0; \
+            second->sibling = 0; \
+            \
+            typeName ## __Node* pair = typeName ## __link(heap, first, second); \
+            pair->sibling = pairs; \
+            pairs = pair; \
+            first = next; \
+        } \
+        \
+        typeName ## __Node* newRoot = 0; \
+        while (pairs) \
+        { \
+            typeName ## __Node* next = pairs->sibling; \
+            pairs->sibling = 0; \
+            newRoot = newRoot ? typeName ## __link(heap, newRoot, pairs) : pairs; \
+            pairs = next; \
+        } \
+        \
+        root->sibling = pool->freeList; \
+        pool->freeList = root; \
+        \
+        heap->root = newRoot; \
+        heap->count--; \
+        return returnValue; \
+    } \
+    \
+    bool typeName ## Meld(typeName* heap, typeName* other) \
+    { \
+        if (!heap->pool || !other->pool || heap == other) \
+            return false; \
+        \
+        if (heap->pool != other->pool) \
+        { \
+            if (!other->ownsPool) \
+                return false; \
+            \
+            typeName ## PoolAdopt(heap->pool, other->pool); \
+        } \
+        \
+        if (other->root) \
+            heap->root = heap->root ? typeName ## __link(heap, heap->root, other->root) : other->root; \
+        \
+        heap->count += other->count; \
+        other->root = 0; \
+        other->count = 0; \
+        return true; \
+    } \
+    \
+    void typeName ## Clear(typeName* heap) \
+    { \
+        if (!heap->pool) \
+            return; \
+        \
+        typeName ## Pool* pool = heap->pool; \
+        typeName ## __Node* node = heap->root; \
+        \
+        while (node) \
+        { \
+            typeName ## __Node* child = node->child; \
+            if (child) \
+            { \
+                node->child = child->sibling; \
+                child->sibling = node; \
+                node = child; \
+                continue; \
+            } \
+            \
+            typeName ## __Node* next = node->sibling; \
+            if (heap->freeFn) \
+                heap->freeFn(node->value); \
+            \
+            node->sibling = pool->freeList; \
+            pool->freeList = node; \
+            node = next; \
+        } \
+        \
+        heap->root = 0; \
+        heap->count = 0; \
+    }
+
+#endif // SHL_PAIRING_HEAP_H
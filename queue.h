@@ -33,12 +33,21 @@
     CUSTOMISATION
     Provide a default value for empty reads, an equality function for
     Contains, and a free function if queue elements own resources. Values are
-    stored by copy in a resizable circular buffer.
+    stored by copy in a resizable circular buffer whose capacity is always a
+    power of two, so wrapping an index is a mask instead of a division. The
+    grown capacity is rounded up to the next power of two, so growth factors
+    up to 2 double it, and it never goes past 2^30 items: Push, PushFront
+    and PushRange return false instead of growing further.
 
     NOTES
     Push appends to the tail, Pop removes from the head, and Peek returns the
-    next item without removing it. Clear releases per-item resources when a
-    free hook is configured.
+    next item without removing it. PushFront, PeekBack and PopBack work on the
+    opposite ends, so the queue also serves as a double-ended queue, and At
+    reads any item by its position from the head. PushRange and PopRange move
+    blocks of items with at most two copies, and PeekSpans exposes the queued
+    items in place as at most two contiguous regions. Clear, and PopRange when
+    it drops items instead of copying them out, release per-item resources
+    when a free hook is configured.
 */
 
 #ifndef SHL_QUEUE_H
@@ -52,6 +61,7 @@
         itemType defaultValue; \
         bool (*equalsFn)(const itemType item1, const itemType item2); \
         void (*freeFn)(itemType item); \
+        float growthFactor; \
     } typeName ## Options; \
     \
     typedef struct \
@@ -60,6 +70,7 @@
         int32_t tail; \
         int32_t count; \
         int32_t capacity; \
+        float growthFactor; \
         bool (*equalsFn)(const itemType item1, const itemType item2); \
         void (*freeFn)(itemType item); \
         itemType defaultValue; \
@@ -68,9 +79,18 @@
     \
     void typeName ## Init(typeName* queue, typeName ## Options options); \
     void typeName ## Free(typeName* queue); \
-    void typeName ## Push(typeName* queue, itemType value); \
+    void typeName ## Reserve(typeName* queue, int32_t capacity); \
+    void typeName ## ShrinkToFit(typeName* queue); \
+    bool typeName ## Push(typeName* queue, itemType value); \
     itemType typeName ## Peek(typeName* queue); \
     itemType typeName ## Pop(typeName* queue); \
+    bool typeName ## PushFront(typeName* queue, itemType value); \
+    itemType typeName ## PeekBack(typeName* queue); \
+    itemType typeName ## PopBack(typeName* queue); \
+    itemType typeName ## At(typeName* queue, int32_t index); \
+    bool typeName ## PushRange(typeName* queue, int32_t count, itemType values[]); \
+    int32_t typeName ## PopRange(typeName* queue, int32_t count, itemType values[]); \
+    void typeName ## PeekSpans(typeName* queue, itemType** first, int32_t* firstCount, itemType** second, int32_t* secondCount); \
     bool typeName ## Contains(typeName* queue, itemType value); \
     void typeName ## Clear(typeName* queue);
 
@@ -80,11 +100,12 @@
         queue->defaultValue = options.defaultValue; \
         queue->equalsFn = options.equalsFn; \
         queue->freeFn = options.freeFn; \
+        queue->growthFactor = options.growthFactor; \
         queue->capacity = SHL__INITIAL_CAPACITY; \
         queue->count = 0; \
         queue->head = 0; \
         queue->tail = 0; \
-        queue->items = (itemType *)SHL_CALLOC((size_t)queue->capacity, sizeof(itemType)); \
+        queue->items = (itemType *)SHL_MALLOC((size_t)queue->capacity * sizeof(itemType)); \
     } \
     \
     void typeName ## Free(typeName *queue) \
@@ -98,17 +119,38 @@
         queue->items = 0; \
     } \
     \
-    void typeName ## Push(typeName *queue, itemType value) \
+    void typeName ## Reserve(typeName *queue, int32_t capacity) \
     { \
         if (!queue->items) \
             return; \
         \
-        if (queue->count == queue->capacity) \
-            shl__resizeCircularArray((void**)&queue->items, &queue->capacity, &queue->head, &queue->tail, queue->count, sizeof(itemType)); \
+        if (capacity > queue->capacity && capacity <= SHL__MAX_POWER_OF_TWO_CAPACITY) \
+            shl__resizeCircularArray((void**)&queue->items, &queue->capacity, &queue->head, &queue->tail, queue->count, sizeof(itemType), shl__nextPowerOfTwo(capacity)); \
+    } \
+    \
+    void typeName ## ShrinkToFit(typeName *queue) \
+    { \
+        if (!queue->items) \
+            return; \
+        \
+        int32_t capacity = shl__nextPowerOfTwo(queue->count); \
+        if (capacity < queue->capacity) \
+            shl__resizeCircularArray((void**)&queue->items, &queue->capacity, &queue->head, &queue->tail, queue->count, sizeof(itemType), capacity); \
+    } \
+    \
+    bool typeName ## Push(typeName *queue, itemType value) \
+    { \
+        if (!queue->items) \
+            return false; \
+        \
+        if (queue->count == queue->capacity && \
+            !shl__growCircularArray((void**)&queue->items, &queue->capacity, &queue->head, &queue->tail, queue->count, sizeof(itemType), queue->capacity + 1, queue->growthFactor)) \
+            return false; \
         \
         queue->items[queue->tail] = value; \
-        queue->tail = (queue->tail + 1) % queue->capacity; \
+        queue->tail = (queue->tail + 1) & (queue->capacity - 1); \
         queue->count++; \
+        return true; \
     } \
     \
     itemType typeName ## Peek(typeName *queue) \
@@ -126,11 +168,131 @@
         \
         itemType value = queue->items[queue->head]; \
         queue->items[queue->head] = queue->defaultValue; \
-        queue->head = (queue->head + 1) % queue->capacity; \
+        queue->head = (queue->head + 1) & (queue->capacity - 1); \
         queue->count--; \
         return value; \
     } \
     \
+    bool typeName ## PushFront(typeName *queue, itemType value) \
+    { \
+        if (!queue->items) \
+            return false; \
+        \
+        if (queue->count == queue->capacity && \
+            !shl__growCircularArray((void**)&queue->items, &queue->capacity, &queue->head, &queue->tail, queue->count, sizeof(itemType), queue->capacity + 1, queue->growthFactor)) \
+            return false; \
+        \
+        queue->head = (queue->head - 1) & (queue->capacity - 1); \
+        queue->items[queue->head] = value; \
+        queue->count++; \
+        return true; \
+    } \
+    \
+    itemType typeName ## PeekBack(typeName *queue) \
+    { \
+        if (!queue->items || queue->count == 0) \
+            return queue->defaultValue; \
+        \
+        return queue->items[(queue->tail - 1) & (queue->capacity - 1)]; \
+    } \
+    \
+    itemType typeName ## PopBack(typeName *queue) \
+    { \
+        if (!queue->items || queue->count == 0) \
+            return queue->defaultValue; \
+        \
+        queue->tail = (queue->tail - 1) & (queue->capacity - 1); \
+        itemType value = queue->items[queue->tail]; \
+        queue->items[queue->tail] = queue->defaultValue; \
+        queue->count--; \
+        return value; \
+    } \
+    \
+    itemType typeName ## At(typeName *queue, int32_t index) \
+    { \
+        if (!queue->items) \
+            return queue->defaultValue; \
+        \
+        if (index < 0 || index >= queue->count) \
+            return queue->defaultValue; \
+        \
+        return queue->items[(queue->head + index) & (queue->capacity - 1)]; \
+    } \
+    \
+    bool typeName ## PushRange(typeName *queue, int32_t count, itemType values[]) \
+    { \
+        if (!queue->items) \
+            return false; \
+        \
+        if (count <= 0) \
+            return count == 0; \
+        \
+        if (count > SHL__MAX_POWER_OF_TWO_CAPACITY - queue->count) \
+            return false; \
+        \
+        if (queue->count + count > queue->capacity && \
+            !shl__growCircularArray((void**)&queue->items, &queue->capacity, &queue->head, &queue->tail, queue->count, sizeof(itemType), queue->count + count, queue->growthFactor)) \
+            return false; \
+        \
+        int32_t firstCount = queue->capacity - queue->tail < count ? queue->capacity - queue->tail : count; \
+        memcpy(queue->items + queue->tail, values, (size_t)firstCount * sizeof(itemType)); \
+        memcpy(queue->items, values + firstCount, (size_t)(count - firstCount) * sizeof(itemType)); \
+        \
+        queue->tail = (queue->tail + count) & (queue->capacity - 1); \
+        queue->count += count; \
+        return true; \
+    } \
+    \
+    int32_t typeName ## PopRange(typeName *queue, int32_t count, itemType values[]) \
+    { \
+        if (!queue->items) \
+            return 0; \
+        \
+        if (count > queue->count) \
+            count = queue->count; \
+        \
+        if (count <= 0) \
+            return 0; \
+        \
+        int32_t firstCount = queue->capacity - queue->head < count ? queue->capacity - queue->head : count; \
+        if (values) \
+        { \
+            memcpy(values, queue->items + queue->head, (size_t)firstCount * sizeof(itemType)); \
+            memcpy(values + firstCount, queue->items, (size_t)(count - firstCount) * sizeof(itemType)); \
+        } \
+        \
+        for(int32_t i = 0; i < count; i++) \
+        { \
+            itemType* item = &queue->items[i < firstCount ? queue->head + i : i - firstCount]; \
+            if (!values && queue->freeFn) \
+                queue->freeFn(*item); \
+            \
+            *item = queue->defaultValue; \
+        } \
+        \
+        queue->head = (queue->head + count) & (queue->capacity - 1); \
+        queue->count -= count; \
+        return count; \
+    } \
+    \
+    void typeName ## PeekSpans(typeName *queue, itemType** first, int32_t* firstCount, itemType** second, int32_t* secondCount) \
+    { \
+        *first = *second = 0; \
+        *firstCount = *secondCount = 0; \
+        \
+        if (!queue->items || queue->count == 0) \
+            return; \
+        \
+        *first = queue->items + queue->head; \
+        *firstCount = queue->capacity - queue->head < queue->count ? queue->capacity - queue->head : queue->count; \
+        \
+        if (*firstCount < queue->count) \
+        { \
+            *second = queue->items; \
+            *secondCount = queue->count - *firstCount; \
+        } \
+    } \
+    \
     bool typeName ## Contains(typeName *queue, itemType value) \
     { \
         if (!queue->items) \
@@ -139,10 +301,17 @@
         if (!queue->equalsFn) \
             return false; \
         \
-        for(int32_t i = 0; i < queue->count; i++) \
+        itemType* spans[2]; \
+        int32_t spanCounts[2]; \
+        typeName ## PeekSpans(queue, &spans[0], &spanCounts[0], &spans[1], &spanCounts[1]); \
+        \
+        for(int32_t span = 0; span < 2; span++) \
         { \
-            if (queue->equalsFn(queue->items[(queue->head + i) % queue->capacity], value)) \
-                return true; \
+            for(int32_t i = 0; i < spanCounts[span]; i++) \
+            { \
+                if (queue->equalsFn(spans[span][i], value)) \
+                    return true; \
+            } \
         } \
         \
         return false; \
@@ -156,7 +325,7 @@
         { \
             for(int32_t i = 0; i < queue->count; i++) \
             { \
-                int32_t index = (queue->head + i) % queue->capacity; \
+                int32_t index = (queue->head + i) & (queue->capacity - 1); \
                 queue->freeFn(queue->items[index]); \
                 queue->items[index] = queue->defaultValue; \
             } \
@@ -0,0 +1,258 @@
+/*
+    radix_heap.h - acoto87 (acoto87@gmail.com)
+
+    MIT License
+
+    Copyright (c) 2018 Alejandro Coto Gutiérrez
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Single-header macro library to declare and define strongly typed radix
+    heaps, priority queues for monotone integer priorities.
+
+    USAGE
+    Declare a heap type with shlDeclareRadixHeap(name, type), then define it
+    once with shlDefineRadixHeap(name, type) in a C source file.
+
+    CUSTOMISATION
+    Provide a default value for empty reads and an optional free function for
+    owned values. Items are stored by copy next to their 32-bit key.
+
+    NOTES
+    The keys must be monotone: a pushed key can't be less than the last key
+    popped, which holds for Dijkstra with non-negative weights and for timers.
+    Items live in 33 buckets; bucket i holds the keys whose highest bit that
+    differs from the last popped key is bit i - 1, and bucket 0 holds the keys
+    equal to it. Push is O(1). When bucket 0 is empty, Pop takes the first
+    non-empty bucket, makes its minimum the new last key and spreads the
+    bucket over lower ones; every item moves down at most 32 times, so Pop is
+    amortised O(log C) where C is the key range. Peek finds the same minimum
+    without spreading the bucket, so only Pop moves the bound that Push
+    checks; a Peek on an empty bucket 0 scans the first non-empty bucket. No
+    compare function is needed. Call Free to release internal storage and
+    Clear to dispose of retained items.
+*/
+
+#ifndef SHL_RADIX_HEAP_H
+#define SHL_RADIX_HEAP_H
+
+#include "shl_internal.h"
+
+#define SHL__RADIX_HEAP_BUCKET_COUNT 33
+
+static inline int32_t shl__radixBucket(uint32_t key, uint32_t last)
+{
+    uint32_t diff = key ^ last;
+
+    if (diff == 0)
+        return 0;
+
+#if defined(__GNUC__) || defined(__clang__)
+    return 32 - __builtin_clz(diff);
+#else
+    int32_t bucket = 0;
+    while (diff)
+    {
+        diff >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+#endif
+}
+
+#define shlDeclareRadixHeap(typeName, itemType) \
+    typedef struct \
+    { \
+        itemType defaultValue; \
+        void (*freeFn)(itemType item); \
+        float growthFactor; \
+    } typeName ## Options; \
+    \
+    typedef struct \
+    { \
+        uint32_t key; \
+        itemType value; \
+    } typeName ## __Entry; \
+    \
+    typedef struct \
+    { \
+        int32_t count; \
+        int32_t capacity; \
+        typeName ## __Entry* entries; \
+    } typeName ## __Bucket; \
+    \
+    typedef struct \
+    { \
+        int32_t count; \
+        uint32_t last; \
+        float growthFactor; \
+        void (*freeFn)(itemType item); \
+        itemType defaultValue; \
+        typeName ## __Bucket buckets[SHL__RADIX_HEAP_BUCKET_COUNT]; \
+    } typeName; \
+    \
+    void typeName ## Init(typeName* heap, typeName ## Options options); \
+    void typeName ## Free(typeName* heap); \
+    bool typeName ## Push(typeName* heap, uint32_t key, itemType value); \
+    itemType typeName ## Peek(typeName* heap, uint32_t* key); \
+    itemType typeName ## Pop(typeName* heap, uint32_t* key); \
+    void typeName ## Clear(typeName* heap);
+
+#define shlDefineRadixHeap(typeName, itemType) \
+    void typeName ## __add(typeName* heap, int32_t index, uint32_t key, itemType value) \
+    { \
+        typeName ## __Bucket* bucket = &heap->buckets[index]; \
+        \
+        if (bucket->count == bucket->capacity) \
+            shl__resizeArray((void**)&bucket->entries, &bucket->capacity, bucket->count + 1, sizeof(typeName ## __Entry), heap->growthFactor); \
+        \
+        bucket->entries[bucket->count].key = key; \
+        bucket->entries[bucket->count].value = value; \
+        bucket->count++; \
+    } \
+    \
+    int32_t typeName ## __findMin(typeName* heap, int32_t* index) \
+    { \
+        *index = 0; \
+        while (heap->buckets[*index].count == 0) \
+            (*index)++; \
+        \
+        typeName ## __Bucket* bucket = &heap->buckets[*index]; \
+        int32_t min = bucket->count - 1; \
+        if (*index > 0) \
+        { \
+            min = 0; \
+            for(int32_t i = 1; i < bucket->count; i++) \
+            { \
+                if (bucket->entries[i].key <= bucket->entries[min].key) \
+                    min = i; \
+            } \
+        } \
+        \
+        return min; \
+    } \
+    \
+    bool typeName ## __fillFirstBucket(typeName* heap) \
+    { \
+        if (heap->count == 0) \
+            return false; \
+        \
+        int32_t index; \
+        int32_t min = typeName ## __findMin(heap, &index); \
+        if (index == 0) \
+            return true; \
+        \
+        typeName ## __Bucket* bucket = &heap->buckets[index]; \
+        uint32_t last = bucket->entries[min].key; \
+        heap->last = last; \
+        \
+        int32_t count = bucket->count; \
+        bucket->count = 0; \
+        \
+        for(int32_t i = 0; i < count; i++) \
+        { \
+            typeName ## __Entry entry = bucket->entries[i]; \
+            typeName ## __add(heap, shl__radixBucket(entry.key, last), entry.key, entry.value); \
+        } \
+        \
+        return true; \
+    } \
+    \
+    void typeName ## Init(typeName* heap, typeName ## Options options) \
+    { \
+        heap->defaultValue = options.defaultValue; \
+        heap->freeFn = options.freeFn; \
+        heap->growthFactor = options.growthFactor; \
+        heap->count = 0; \
+        heap->last = 0; \
+        \
+        for(int32_t i = 0; i < SHL__RADIX_HEAP_BUCKET_COUNT; i++) \
+            heap->buckets[i] = (typeName ## __Bucket){ 0, 0, 0 }; \
+    } \
+    \
+    void typeName ## Free(typeName* heap) \
+    { \
+        typeName ## Clear(heap); \
+        \
+        for(int32_t i = 0; i < SHL__RADIX_HEAP_BUCKET_COUNT; i++) \
+        { \
+            SHL_FREE(heap->buckets[i].entries); \
+            heap->buckets[i] = (typeName ## __Bucket){ 0, 0, 0 }; \
+        } \
+    } \
+    \
+    bool typeName ## Push(typeName* heap, uint32_t key, itemType value) \
+    { \
+        if (key < heap->last) \
+            return false; \
+        \
+        typeName ## __add(heap, shl__radixBucket(key, heap->last), key, value); \
+        heap->count++; \
+        return true; \
+    } \
+    \
+    itemType typeName ## Peek(typeName* heap, uint32_t* key) \
+    { \
+        if (heap->count == 0) \
+            return heap->defaultValue; \
+        \
+        int32_t index; \
+        int32_t min = typeName ## __findMin(heap, &index); \
+        \
+        typeName ## __Bucket* bucket = &heap->buckets[index]; \
+        if (key) \
+            *key = bucket->entries[min].key; \
+        \
+        return bucket->entries[min].value; \
+    } \
+    \
+    itemType typeName ## Pop(typeName* heap, uint32_t* key) \
+    { \
+        if (!typeName ## __fillFirstBucket(heap)) \
+            return heap->defaultValue; \
+        \
+        typeName ## __Bucket* bucket = &heap->buckets[0]; \
+        bucket->count--; \
+        heap->count--; \
+        \
+        if (key) \
+            *key = bucket->entries[bucket->count].key; \
+        \
+        return bucket->entries[bucket->count].value; \
+    } \
+    \
+    void typeName ## Clear(typeName* heap) \
+    { \
+        for(int32_t i = 0; i < SHL__RADIX_HEAP_BUCKET_COUNT; i++) \
+        { \
+            if (heap->freeFn) \
+            { \
+                for(int32_t j = 0; j < heap->buckets[i].count; j++) \
+                    heap->freeFn(heap->buckets[i].entries[j].value); \
+            } \
+            \
+            heap->buckets[i].count = 0; \
+        } \
+        \
+        heap->count = 0; \
+        heap->last = 0; \
+    }
+
+#endif // SHL_RADIX_HEAP_H
@@ -28,10 +28,28 @@
 #define SHL__INITIAL_CAPACITY 8
 #define SHL__INITIAL_HASH_SHIFT 29
 #define SHL__INITIAL_HASH_LOAD_FACTOR 6
+#define SHL__CACHE_LINE_SIZE 64
 
-static inline int32_t shl__grownCapacity(int32_t currentCapacity, int32_t minSize)
+static inline int32_t shl__grownCapacity(int32_t currentCapacity, int32_t minSize, float growthFactor)
 {
-    int32_t newCapacity = currentCapacity > 0 ? (currentCapacity << 1) : SHL__INITIAL_CAPACITY;
+    int32_t newCapacity;
+
+    if (currentCapacity <= 0)
+    {
+        newCapacity = SHL__INITIAL_CAPACITY;
+    }
+    else if (growthFactor > 1.0f)
+    {
+        double grownCapacity = (double)currentCapacity * growthFactor;
+        newCapacity = grownCapacity >= (double)INT32_MAX ? INT32_MAX : (int32_t)grownCapacity;
+
+        if (newCapacity <= currentCapacity)
+            newCapacity = currentCapacity + 1;
+    }
+    else
+    {
+        newCapacity = currentCapacity > INT32_MAX / 2 ? INT32_MAX : (currentCapacity << 1);
+    }
 
     if (newCapacity < minSize)
         newCapacity = minSize;
@@ -39,41 +57,108 @@ static inline int32_t shl__grownCapacity(int32_t currentCapacity, int32_t minSiz
     return newCapacity;
 }
 
-static inline void shl__resizeArray(void** items, int32_t* capacity, int32_t minSize, size_t itemSize)
+static inline void shl__reallocArray(void** items, int32_t* capacity, int32_t newCapacity, size_t itemSize)
 {
-    *capacity = shl__grownCapacity(*capacity, minSize);
+    *capacity = newCapacity;
     *items = SHL_REALLOC(*items, (size_t)(*capacity) * itemSize);
 }
 
-static inline void shl__resizeCircularArray(void** items, int32_t* capacity, int32_t* head, int32_t* tail, int32_t count, size_t itemSize)
+static inline void shl__resizeArray(void** items, int32_t* capacity, int32_t minSize, size_t itemSize, float growthFactor)
+{
+    shl__reallocArray(items, capacity, shl__grownCapacity(*capacity, minSize, growthFactor), itemSize);
+}
+
+static inline void shl__detachArray(void** items, int32_t* capacity, int32_t count, int32_t newCapacity, size_t itemSize)
+{
+    void* newItems = SHL_MALLOC((size_t)newCapacity * itemSize);
+    memcpy(newItems, *items, (size_t)count * itemSize);
+    *items = newItems;
+    *capacity = newCapacity;
+}
+
+static inline void shl__resizeSmallArray(void** items, int32_t* capacity, int32_t newCapacity, size_t itemSize, void* inlineItems)
 {
     int32_t oldCapacity = *capacity;
-    unsigned char* oldItems = (unsigned char*)*items;
-    unsigned char* newItems;
 
-    *capacity = shl__grownCapacity(*capacity, *capacity + 1);
-    newItems = (unsigned char*)SHL_CALLOC((size_t)(*capacity), itemSize);
+    *capacity = newCapacity;
 
-    if (count > 0)
+    if (*items == inlineItems)
     {
-        if (*head >= *tail)
-        {
-            size_t firstCopySize = (size_t)(oldCapacity - *head) * itemSize;
-            size_t secondCopySize = (size_t)((*head + count) % oldCapacity) * itemSize;
+        void* newItems = SHL_MALLOC((size_t)(*capacity) * itemSize);
+        memcpy(newItems, inlineItems, (size_t)oldCapacity * itemSize);
+        *items = newItems;
+    }
+    else
+    {
+        *items = SHL_REALLOC(*items, (size_t)(*capacity) * itemSize);
+    }
+}
 
-            memcpy(newItems, oldItems + (size_t)(*head) * itemSize, firstCopySize);
-            memcpy(newItems + firstCopySize, oldItems, secondCopySize);
-        }
-        else
+#define SHL__MAX_POWER_OF_TWO_CAPACITY (1 << 30)
+
+static inline int32_t shl__nextPowerOfTwo(int32_t value)
+{
+    int32_t result = 1;
+
+    while (result < value && result < SHL__MAX_POWER_OF_TWO_CAPACITY)
+        result <<= 1;
+
+    return result;
+}
+
+static inline void shl__resizeCircularArray(void** items, int32_t* capacity, int32_t* head, int32_t* tail, int32_t count, size_t itemSize, int32_t newCapacity)
+{
+    int32_t oldCapacity = *capacity;
+    int32_t headLength = count < oldCapacity - *head ? count : oldCapacity - *head;
+    int32_t wrappedLength = count - headLength;
+    unsigned char* bytes;
+
+    if (newCapacity >= oldCapacity)
+    {
+        // grow in place and only move the shorter of the two segments so the ring is contiguous again
+        bytes = (unsigned char*)SHL_REALLOC(*items, (size_t)newCapacity * itemSize);
+
+        if (wrappedLength > 0)
         {
-            memcpy(newItems, oldItems + (size_t)(*head) * itemSize, (size_t)count * itemSize);
+            if (wrappedLength <= headLength && wrappedLength <= newCapacity - oldCapacity)
+            {
+                memcpy(bytes + (size_t)oldCapacity * itemSize, bytes, (size_t)wrappedLength * itemSize);
+            }
+            else
+            {
+                int32_t newHead = newCapacity - headLength;
+                memmove(bytes + (size_t)newHead * itemSize, bytes + (size_t)(*head) * itemSize, (size_t)headLength * itemSize);
+                *head = newHead;
+            }
         }
     }
+    else
+    {
+        bytes = (unsigned char*)SHL_MALLOC((size_t)newCapacity * itemSize);
+        memcpy(bytes, (unsigned char*)*items + (size_t)(*head) * itemSize, (size_t)headLength * itemSize);
+        memcpy(bytes + (size_t)headLength * itemSize, *items, (size_t)wrappedLength * itemSize);
+        SHL_FREE(*items);
+        *head = 0;
+    }
 
-    *head = 0;
-    *tail = count;
-    SHL_FREE(*items);
-    *items = newItems;
+    *items = bytes;
+    *capacity = newCapacity;
+    *tail = (*head + count) % newCapacity;
+}
+
+// grows a circular array to a power of two capacity that holds minSize items, the growth factor
+// rounds up to the next power of two; returns false when minSize is past the largest capacity
+static inline bool shl__growCircularArray(void** items, int32_t* capacity, int32_t* head, int32_t* tail, int32_t count, size_t itemSize, int32_t minSize, float growthFactor)
+{
+    if (minSize > SHL__MAX_POWER_OF_TWO_CAPACITY)
+        return false;
+
+    int32_t newCapacity = shl__grownCapacity(*capacity, minSize, growthFactor);
+    if (newCapacity > SHL__MAX_POWER_OF_TWO_CAPACITY)
+        newCapacity = SHL__MAX_POWER_OF_TWO_CAPACITY;
+
+    shl__resizeCircularArray(items, capacity, head, tail, count, itemSize, shl__nextPowerOfTwo(newCapacity));
+    return true;
 }
 
 static inline int32_t shl__fibHash(uint32_t hash, int32_t shift)
@@ -0,0 +1,267 @@
+/*
+    sparse_grid.h - acoto87 (acoto87@gmail.com)
+
+    MIT License
+
+    Copyright (c) 2018 Alejandro Coto Gutiérrez
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Single-header macro library to declare and define strongly typed sparse
+    2D grids, made of square chunks that are allocated on first write.
+
+    USAGE
+    Declare a grid type with shlDeclareSparseGrid(name, type), then define it
+    once with shlDefineSparseGrid(name, type) in a C source file. This also
+    declares and defines a map type from map.h for the chunk lookup.
+
+    CUSTOMISATION
+    Provide the value of the cells that were never written, the size of the
+    chunks as a power of two and the growth factor of the chunk list. Cells
+    are stored by copy and aren't freed by the grid.
+
+    NOTES
+    Cells are addressed by signed x/y coordinates, so a grid can grow in
+    every direction. A chunk covers the cells whose coordinates shifted right
+    by chunkShift are the same, and is looked up in a map keyed by those
+    chunk coordinates. The last chunk found is remembered, so runs of
+    accesses to the same chunk skip the map. Reading a cell of a missing
+    chunk returns the default value without allocating it. The allocated
+    chunks are kept in a list that ChunkCount with GetChunk walk without
+    going through the map. The list is in allocation order until a chunk is
+    removed; RemoveChunk moves the last chunk into the freed place, so after
+    that the order is unspecified.
+*/
+
+#ifndef SHL_SPARSE_GRID_H
+#define SHL_SPARSE_GRID_H
+
+#include "map.h"
+
+#ifndef SHL_SPARSE_GRID_DEFAULT_CHUNK_SHIFT
+#define SHL_SPARSE_GRID_DEFAULT_CHUNK_SHIFT 6
+#endif
+
+#define SHL__SPARSE_GRID_MAX_CHUNK_SHIFT 12
+
+static inline uint64_t shl__sparseGridKey(int32_t chunkX, int32_t chunkY)
+{
+    return ((uint64_t)(uint32_t)chunkY << 32) | (uint64_t)(uint32_t)chunkX;
+}
+
+static inline uint32_t shl__sparseGridHash(uint64_t key)
+{
+    key ^= key >> 33;
+    key *= 0xFF51AFD7ED558CCDull;
+    key ^= key >> 33;
+    return (uint32_t)key;
+}
+
+static inline bool shl__sparseGridEquals(uint64_t key1, uint64_t key2)
+{
+    return key1 == key2;
+}
+
+#define shlDeclareSparseGrid(typeName, itemType) \
+    shlDeclareMap(typeName ## __ChunkMap, uint64_t, int32_t) \
+    \
+    typedef struct \
+    { \
+        itemType defaultValue; \
+        int32_t chunkShift; \
+        float growthFactor; \
+    } typeName ## Options; \
+    \
+    typedef struct \
+    { \
+        int32_t x; \
+        int32_t y; \
+        itemType* cells; \
+    } typeName ## Chunk; \
+    \
+    typedef struct \
+    { \
+        int32_t chunkShift; \
+        int32_t chunkCount; \
+        int32_t chunkCapacity; \
+        int32_t lastChunk; \
+        uint64_t lastKey; \
+        float growthFactor; \
+        itemType defaultValue; \
+        typeName ## Chunk* chunks; \
+        typeName ## __ChunkMap lookup; \
+    } typeName; \
+    \
+    void typeName ## Init(typeName* grid, typeName ## Options options); \
+    void typeName ## Free(typeName* grid); \
+    itemType typeName ## Get(typeName* grid, int32_t x, int32_t y); \
+    void typeName ## Set(typeName* grid, int32_t x, int32_t y, itemType value); \
+    itemType* typeName ## CellPtr(typeName* grid, int32_t x, int32_t y, bool allocate); \
+    typeName ## Chunk* typeName ## ChunkAt(typeName* grid, int32_t x, int32_t y, bool allocate); \
+    bool typeName ## RemoveChunk(typeName* grid, int32_t x, int32_t y); \
+    int32_t typeName ## ChunkCount(typeName* grid); \
+    typeName ## Chunk* typeName ## GetChunk(typeName* grid, int32_t index); \
+    void typeName ## Clear(typeName* grid);
+
+#define shlDefineSparseGrid(typeName, itemType) \
+    shlDefineMap(typeName ## __ChunkMap, uint64_t, int32_t) \
+    \
+    int32_t typeName ## __findChunk(typeName* grid, int32_t x, int32_t y, bool allocate) \
+    { \
+        int32_t chunkX = x >> grid->chunkShift; \
+        int32_t chunkY = y >> grid->chunkShift; \
+        uint64_t key = shl__sparseGridKey(chunkX, chunkY); \
+        \
+        if (grid->lastChunk >= 0 && grid->lastKey == key) \
+            return grid->lastChunk; \
+        \
+        int32_t index = typeName ## __ChunkMapGet(&grid->lookup, key); \
+        if (index < 0) \
+        { \
+            if (!allocate) \
+                return -1; \
+            \
+            size_t cellCount = (size_t)1 << (2 * grid->chunkShift); \
+            itemType* cells = (itemType*)SHL_MALLOC(cellCount * sizeof(itemType)); \
+            if (!cells) \
+                return -1; \
+            \
+            for (size_t i = 0; i < cellCount; i++) \
+                cells[i] = grid->defaultValue; \
+            \
+            if (grid->chunkCount == grid->chunkCapacity) \
+                shl__resizeArray((void**)&grid->chunks, &grid->chunkCapacity, grid->chunkCount + 1, sizeof(typeName ## Chunk), grid->growthFactor); \
+            \
+            index = grid->chunkCount++; \
+            grid->chunks[index].x = (int32_t)((uint32_t)chunkX << grid->chunkShift); \
+            grid->chunks[index].y = (int32_t)((uint32_t)chunkY << grid->chunkShift); \
+            grid->chunks[index].cells = cells; \
+            typeName ## __ChunkMapSet(&grid->lookup, key, index); \
+        } \
+        \
+        grid->lastKey = key; \
+        grid->lastChunk = index; \
+        return index; \
+    } \
+    \
+    void typeName ## Init(typeName* grid, typeName ## Options options) \
+    { \
+        grid->chunkShift = options.chunkShift > 0 ? options.chunkShift : SHL_SPARSE_GRID_DEFAULT_CHUNK_SHIFT; \
+        if (grid->chunkShift > SHL__SPARSE_GRID_MAX_CHUNK_SHIFT) \
+            grid->chunkShift = SHL__SPARSE_GRID_MAX_CHUNK_SHIFT; \
+        \
+        grid->chunkCount = 0; \
+        grid->chunkCapacity = 0; \
+        grid->lastChunk = -1; \
+        grid->lastKey = 0; \
+        grid->growthFactor = options.growthFactor; \
+        grid->defaultValue = options.defaultValue; \
+        grid->chunks = NULL; \
+        typeName ## __ChunkMapInit(&grid->lookup, (typeName ## __ChunkMapOptions){ .defaultValue = -1, .hashFn = shl__sparseGridHash, .equalsFn = shl__sparseGridEquals }); \
+    } \
+    \
+    void typeName ## Free(typeName* grid) \
+    { \
+        typeName ## Clear(grid); \
+        SHL_FREE(grid->chunks); \
+        grid->chunks = NULL; \
+        grid->chunkCapacity = 0; \
+        typeName ## __ChunkMapFree(&grid->lookup); \
+    } \
+    \
+    itemType typeName ## Get(typeName* grid, int32_t x, int32_t y) \
+    { \
+        int32_t index = typeName ## __findChunk(grid, x, y, false); \
+        if (index < 0) \
+            return grid->defaultValue; \
+        \
+        int32_t mask = (1 << grid->chunkShift) - 1; \
+        return grid->chunks[index].cells[((y & mask) << grid->chunkShift) + (x & mask)]; \
+    } \
+    \
+    void typeName ## Set(typeName* grid, int32_t x, int32_t y, itemType value) \
+    { \
+        int32_t index = typeName ## __findChunk(grid, x, y, true); \
+        if (index < 0) \
+            return; \
+        \
+        int32_t mask = (1 << grid->chunkShift) - 1; \
+        grid->chunks[index].cells[((y & mask) << grid->chunkShift) + (x & mask)] = value; \
+    } \
+    \
+    itemType* typeName ## CellPtr(typeName* grid, int32_t x, int32_t y, bool allocate) \
+    { \
+        int32_t index = typeName ## __findChunk(grid, x, y, allocate); \
+        if (index < 0) \
+            return NULL; \
+        \
+        int32_t mask = (1 << grid->chunkShift) - 1; \
+        return &grid->chunks[index].cells[((y & mask) << grid->chunkShift) + (x & mask)]; \
+    } \
+    \
+    typeName ## Chunk* typeName ## ChunkAt(typeName* grid, int32_t x, int32_t y, bool allocate) \
+    { \
+        int32_t index = typeName ## __findChunk(grid, x, y, allocate); \
+        return index >= 0 ? &grid->chunks[index] : NULL; \
+    } \
+    \
+    bool typeName ## RemoveChunk(typeName* grid, int32_t x, int32_t y) \
+    { \
+        int32_t index = typeName ## __findChunk(grid, x, y, false); \
+        if (index < 0) \
+            return false; \
+        \
+        typeName ## __ChunkMapRemove(&grid->lookup, shl__sparseGridKey(x >> grid->chunkShift, y >> grid->chunkShift)); \
+        SHL_FREE(grid->chunks[index].cells); \
+        \
+        int32_t last = --grid->chunkCount; \
+        if (index != last) \
+        { \
+            grid->chunks[index] = grid->chunks[last]; \
+            typeName ## __ChunkMapSet(&grid->lookup, shl__sparseGridKey(grid->chunks[index].x >> grid->chunkShift, grid->chunks[index].y >> grid->chunkShift), index); \
+        } \
+        \
+        grid->lastChunk = -1; \
+        return true; \
+    } \
+    \
+    int32_t typeName ## ChunkCount(typeName* grid) \
+    { \
+        return grid->chunkCount; \
+    } \
+    \
+    typeName ## Chunk* typeName ## GetChunk(typeName* grid, int32_t index) \
+    { \
+        if (index < 0 || index >= grid->chunkCount) \
+            return NULL; \
+        \
+        return &grid->chunks[index]; \
+    } \
+    \
+    void typeName ## Clear(typeName* grid) \
+    { \
+        for (int32_t i = 0; i < grid->chunkCount; i++) \
+            SHL_FREE(grid->chunks[i].cells); \
+        \
+        grid->chunkCount = 0; \
+        grid->lastChunk = -1; \
+        typeName ## __ChunkMapClear(&grid->lookup); \
+    }
+
+#endif // SHL_SPARSE_GRID_H
@@ -28,7 +28,9 @@
 
     USAGE
     Declare a stack type with shlDeclareStack(name, type), then define it once
-    with shlDefineStack(name, type) in a C source file.
+    with shlDefineStack(name, type) in a C source file. For a stack that never
+    touches the heap, use shlDeclareFixedStack(name, type, capacity) and
+    shlDefineFixedStack(name, type) instead.
 
     CUSTOMISATION
     Provide a default value for empty reads, an equality function for
@@ -37,8 +39,11 @@
 
     NOTES
     Push appends to the top of the stack, Pop removes the most recent item,
-    and Peek reads without removing. Call Free when the stack is no longer
-    needed.
+    and Peek reads without removing. PushN and PopN move blocks of items with
+    a single copy. Mark returns the current depth and RestoreTo pops back to
+    it, so a scope can discard everything it pushed at once. A fixed stack
+    keeps its items inline and its Push fails instead of growing. Call Free
+    when the stack is no longer needed.
 */
 
 #ifndef SHL_STACK_H
@@ -52,12 +57,14 @@
         itemType defaultValue; \
         bool (*equalsFn)(const itemType item1, const itemType item2); \
         void (*freeFn)(itemType item); \
+        float growthFactor; \
     } typeName ## Options; \
     \
     typedef struct \
     { \
         int32_t count; \
         int32_t capacity; \
+        float growthFactor; \
         bool (*equalsFn)(const itemType item1, const itemType item2); \
         void (*freeFn)(itemType item); \
         itemType defaultValue; \
@@ -66,10 +73,16 @@
     \
     void typeName ## Init(typeName *stack, typeName ## Options options); \
     void typeName ## Free(typeName *stack); \
+    void typeName ## Reserve(typeName *stack, int32_t capacity); \
+    void typeName ## ShrinkToFit(typeName *stack); \
     void typeName ## Push(typeName *stack, itemType value); \
     bool typeName ## Contains(typeName *stack, itemType value); \
     itemType typeName ## Peek(typeName *stack); \
     itemType typeName ## Pop(typeName *stack); \
+    void typeName ## PushN(typeName *stack, int32_t count, itemType values[]); \
+    int32_t typeName ## PopN(typeName *stack, int32_t count, itemType values[]); \
+    int32_t typeName ## Mark(typeName *stack); \
+    void typeName ## RestoreTo(typeName *stack, int32_t mark); \
     void typeName ## Clear(typeName *stack);
 
 #define shlDefineStack(typeName, itemType) \
@@ -78,6 +91,7 @@
         stack->defaultValue = options.defaultValue; \
         stack->equalsFn = options.equalsFn; \
         stack->freeFn = options.freeFn; \
+        stack->growthFactor = options.growthFactor; \
         stack->capacity = SHL__INITIAL_CAPACITY; \
         stack->count = 0; \
         stack->items = (itemType *)SHL_CALLOC((size_t)stack->capacity, sizeof(itemType)); \
@@ -94,13 +108,32 @@
         stack->items = 0; \
     } \
     \
+    void typeName ## Reserve(typeName *stack, int32_t capacity) \
+    { \
+        if (!stack->items) \
+            return; \
+        \
+        if (capacity > stack->capacity) \
+            shl__reallocArray((void**)&stack->items, &stack->capacity, capacity, sizeof(itemType)); \
+    } \
+    \
+    void typeName ## ShrinkToFit(typeName *stack) \
+    { \
+        if (!stack->items) \
+            return; \
+        \
+        int32_t capacity = stack->count > 0 ? stack->count : 1; \
+        if (capacity < stack->capacity) \
+            shl__reallocArray((void**)&stack->items, &stack->capacity, capacity, sizeof(itemType)); \
+    } \
+    \
     void typeName ## Push(typeName *stack, itemType value) \
     { \
         if (!stack->items) \
             return; \
         \
         if (stack->count == stack->capacity) \
-            shl__resizeArray((void**)&stack->items, &stack->capacity, stack->count + 1, sizeof(itemType)); \
+            shl__resizeArray((void**)&stack->items, &stack->capacity, stack->count + 1, sizeof(itemType), stack->growthFactor); \
         \
         stack->items[stack->count] = value; \
         stack->count++; \
@@ -124,6 +157,67 @@
         return item; \
     } \
     \
+    void typeName ## PushN(typeName *stack, int32_t count, itemType values[]) \
+    { \
+        if (!stack->items) \
+            return; \
+        \
+        if (count <= 0) \
+            return; \
+        \
+        if (stack->count + count > stack->capacity) \
+            shl__resizeArray((void**)&stack->items, &stack->capacity, stack->count + count, sizeof(itemType), stack->growthFactor); \
+        \
+        memcpy(stack->items + stack->count, values, (size_t)count * sizeof(itemType)); \
+        stack->count += count; \
+    } \
+    \
+    int32_t typeName ## PopN(typeName *stack, int32_t count, itemType values[]) \
+    { \
+        if (!stack->items) \
+            return 0; \
+        \
+        if (count > stack->count) \
+            count = stack->count; \
+        \
+        if (count <= 0) \
+            return 0; \
+        \
+        stack->count -= count; \
+        \
+        if (values) \
+            memcpy(values, stack->items + stack->count, (size_t)count * sizeof(itemType)); \
+        else if (stack->freeFn) \
+        { \
+            for(int32_t i = 0; i < count; i++) \
+                stack->freeFn(stack->items[stack->count + i]); \
+        } \
+        \
+        return count; \
+    } \
+    \
+    int32_t typeName ## Mark(typeName *stack) \
+    { \
+        return stack->count; \
+    } \
+    \
+    void typeName ## RestoreTo(typeName *stack, int32_t mark) \
+    { \
+        if (!stack->items) \
+            return; \
+        \
+        if (mark < 0 || mark >= stack->count) \
+            return; \
+        \
+        if (stack->freeFn) \
+        { \
+            for(int32_t i = mark; i < stack->count; i++) \
+                stack->freeFn(stack->items[i]); \
+        } \
+        \
+        stack->count = mark; \
+    } \
+    \
     bool typeName ## Contains(typeName *stack, itemType value) \
     { \
         if (!stack->items) \
@@ -155,4 +249,148 @@
         stack->count = 0; \
     }
 
+#define shlDeclareFixedStack(typeName, itemType, fixedCapacity) \
+    typedef struct \
+    { \
+        itemType defaultValue; \
+        bool (*equalsFn)(const itemType item1, const itemType item2); \
+        void (*freeFn)(itemType item); \
+    } typeName ## Options; \
+    \
+    typedef struct \
+    { \
+        int32_t count; \
+        int32_t capacity; \
+        bool (*equalsFn)(const itemType item1, const itemType item2); \
+        void (*freeFn)(itemType item); \
+        itemType defaultValue; \
+        itemType items[fixedCapacity]; \
+    } typeName; \
+    \
+    void typeName ## Init(typeName *stack, typeName ## Options options); \
+    void typeName ## Free(typeName *stack); \
+    bool typeName ## Push(typeName *stack, itemType value); \
+    bool typeName ## Contains(typeName *stack, itemType value); \
+    itemType typeName ## Peek(typeName *stack); \
+    itemType typeName ## Pop(typeName *stack); \
+    int32_t typeName ## PushN(typeName *stack, int32_t count, itemType values[]); \
+    int32_t typeName ## PopN(typeName *stack, int32_t count, itemType values[]); \
+    int32_t typeName ## Mark(typeName *stack); \
+    void typeName ## RestoreTo(typeName *stack, int32_t mark); \
+    void typeName ## Clear(typeName *stack);
+
+#define shlDefineFixedStack(typeName, itemType) \
+    void typeName ## Init(typeName *stack, typeName ## Options options) \
+    { \
+        stack->defaultValue = options.defaultValue; \
+        stack->equalsFn = options.equalsFn; \
+        stack->freeFn = options.freeFn; \
+        stack->capacity = (int32_t)(sizeof(stack->items) / sizeof(stack->items[0])); \
+        stack->count = 0; \
+    } \
+    \
+    void typeName ## Free(typeName *stack) \
+    { \
+        typeName ## Clear(stack); \
+    } \
+    \
+    bool typeName ## Push(typeName *stack, itemType value) \
+    { \
+        if (stack->count == stack->capacity) \
+            return false; \
+        \
+        stack->items[stack->count] = value; \
+        stack->count++; \
+        return true; \
+    } \
+    \
+    itemType typeName ## Peek(typeName *stack) \
+    { \
+        if (stack->count == 0) \
+            return stack->defaultValue; \
+        \
+        return stack->items[stack->count - 1]; \
+    } \
+    \
+    itemType typeName ## Pop(typeName *stack) \
+    { \
+        if (stack->count == 0) \
+            return stack->defaultValue; \
+        \
+        stack->count--; \
+        return stack->items[stack->count]; \
+    } \
+    \
+    int32_t typeName ## PushN(typeName *stack, int32_t count, itemType values[]) \
+    { \
+        if (count > stack->capacity - stack->count) \
+            count = stack->capacity - stack->count; \
+        \
+        if (count <= 0) \
+            return 0; \
+        \
+        memcpy(stack->items + stack->count, values, (size_t)count * sizeof(itemType)); \
+        stack->count += count; \
+        return count; \
+    } \
+    \
+    int32_t typeName ## PopN(typeName *stack, int32_t count, itemType values[]) \
+    { \
+        if (count > stack->count) \
+            count = stack->count; \
+        \
+        if (count <= 0) \
+            return 0; \
+        \
+        stack->count -= count; \
+        \
+        if (values) \
+            memcpy(values, stack->items + stack->count, (size_t)count * sizeof(itemType)); \
+        else if (stack->freeFn) \
+        { \
+            for(int32_t i = 0; i < count; i++) \
+                stack->freeFn(stack->items[stack->count + i]); \
+        } \
+        \
+        return count; \
+    } \
+    \
+    int32_t typeName ## Mark(typeName *stack) \
+    { \
+        return stack->count; \
+    } \
+    \
+    void typeName ## RestoreTo(typeName *stack, int32_t mark) \
+    { \
+        if (mark < 0 || mark >= stack->count) \
+            return; \
+        \
+        if (stack->freeFn) \
+        { \
+            for(int32_t i = mark; i < stack->count; i++) \
+                stack->freeFn(stack->items[i]); \
+        } \
+        \
+        stack->count = mark; \
+    } \
+    \
+    bool typeName ## Contains(typeName *stack, itemType value) \
+    { \
+        if (!stack->equalsFn) \
+            return false; \
+        \
+        for(int32_t i = 0; i < stack->count; i++) \
+        { \
+            if (stack->equalsFn(stack->items[i], value)) \
+                return true; \
+        } \
+        \
+        return false; \
+    } \
+    \
+    void typeName ## Clear(typeName* stack) \
+    { \
+        typeName ## RestoreTo(stack, 0); \
+    }
+
 #endif // SHL_STACK_H
@@ -16,6 +16,54 @@ shlDefineCreateArray(float, float)
 shlDefineFreeArray(float, float)
 shlDefineCreateArray(point, Point*)
 shlDefineFreeArray(point, Point*)
+shlDefineCreateArray3D(float, float)
+shlDefineFreeArray3D(float, float)
+shlDeclareCreateArrayND(float, float)
+shlDefineCreateArrayND(float, float)
+shlDeclareFreeArrayND(float, float)
+shlDefineFreeArrayND(float, float)
+shlDeclareCreateArrayND(point, Point)
+shlDefineCreateArrayND(point, Point)
+shlDeclareFreeArrayND(point, Point)
+shlDefineFreeArrayND(point, Point)
+typedef struct
+{
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+} Rgb;
+
+shlDefineCreateArray(u8, uint8_t)
+shlDefineFreeArray(u8, uint8_t)
+shlDefineCreateArray(u16, uint16_t)
+shlDefineFreeArray(u16, uint16_t)
+shlDefineCreateArray(u64, uint64_t)
+shlDefineFreeArray(u64, uint64_t)
+shlDefineCreateArray(rgb, Rgb)
+shlDefineFreeArray(rgb, Rgb)
+shlDeclareArrayOps(float, float)
+shlDefineArrayOps(float, float)
+shlDeclareArrayOps(u8, uint8_t)
+shlDefineArrayOps(u8, uint8_t)
+shlDeclareArrayOps(u16, uint16_t)
+shlDefineArrayOps(u16, uint16_t)
+shlDeclareArrayOps(u64, uint64_t)
+shlDefineArrayOps(u64, uint64_t)
+shlDeclareArrayOps(rgb, Rgb)
+shlDefineArrayOps(rgb, Rgb)
+
+shlDeclareParallelForRows(u8, uint8_t)
+shlDefineParallelForRows(u8, uint8_t)
+
+shlDeclareTiledArray(float, float)
+shlDefineTiledArray(float, float)
+shlDeclareMortonArray(float, float)
+shlDefineMortonArray(float, float)
+
+static bool isAligned(const void* ptr)
+{
+    return ((uintptr_t)ptr & (SHL_ARRAY_ALIGNMENT - 1)) == 0;
+}
 
 void test_value_array_layout_is_contiguous(void)
 {
@@ -101,6 +149,610 @@ void test_large_array_stress_preserves_tail_value(void)
     floatFreeArray(arr);
 }
 
+void test_value_array_data_is_aligned_and_zeroed(void)
+{
+    for (int32_t cols = 1; cols < 20; cols++)
+    {
+        float** arr = floatCreateArray(3, cols);
+
+        TEST_ASSERT_NOT_NULL(arr);
+        TEST_ASSERT_TRUE(isAligned(arr[0]));
+        TEST_ASSERT_EQUAL_FLOAT(0.0f, arr[2][cols - 1]);
+
+        floatFreeArray(arr);
+    }
+}
+
+void test_array_creators_reject_overflowing_sizes(void)
+{
+    TEST_ASSERT_NULL(floatCreateArray(-1, 4));
+    TEST_ASSERT_NULL(pointCreateArray(INT32_MAX, INT32_MAX));
+    TEST_ASSERT_NULL(floatCreateArray3D(INT32_MAX, INT32_MAX, INT32_MAX));
+
+    floatArrayND arr;
+    const int32_t dims[] = { INT32_MAX, INT32_MAX, INT32_MAX };
+    TEST_ASSERT_FALSE(floatCreateArrayND(&arr, 3, dims));
+    TEST_ASSERT_NULL(arr.values);
+    TEST_ASSERT_FALSE(floatCreateArrayND(&arr, 0, dims));
+    TEST_ASSERT_FALSE(floatCreateArrayND(&arr, SHL_ARRAY_MAX_RANK + 1, dims));
+}
+
+void test_array3d_layout_is_contiguous(void)
+{
+    float*** arr = floatCreateArray3D(4, 5, 6);
+
+    TEST_ASSERT_NOT_NULL(arr);
+    TEST_ASSERT_TRUE(isAligned(arr[0][0]));
+
+    for (int32_t i = 0; i < 4; i++)
+    {
+        for (int32_t j = 0; j < 5; j++)
+        {
+            TEST_ASSERT_EQUAL_PTR(arr[0][0] + (i * 5 + j) * 6, arr[i][j]);
+
+            for (int32_t k = 0; k < 6; k++)
+            {
+                arr[i][j][k] = (float)(i * 100 + j * 10 + k);
+            }
+        }
+    }
+
+    TEST_ASSERT_EQUAL_FLOAT(345.0f, arr[3][4][5]);
+    TEST_ASSERT_EQUAL_FLOAT(345.0f, arr[0][0][4 * 5 * 6 - 1]);
+
+    floatFreeArray3D(arr);
+}
+
+void test_arraynd_rows_are_padded_and_aligned(void)
+{
+    floatArrayND arr;
+    const int32_t dims[] = { 3, 5, 7 };
+
+    TEST_ASSERT_TRUE(floatCreateArrayND(&arr, 3, dims));
+    TEST_ASSERT_EQUAL_INT(3, arr.rank);
+    TEST_ASSERT_EQUAL_size_t(1, arr.strides[2]);
+    TEST_ASSERT_EQUAL_size_t(SHL_ARRAY_ALIGNMENT / sizeof(float), arr.strides[1]);
+    TEST_ASSERT_EQUAL_size_t(5 * arr.strides[1], arr.strides[0]);
+    TEST_ASSERT_EQUAL_size_t(3 * arr.strides[0], arr.count);
+
+    for (int32_t i = 0; i < 3; i++)
+    {
+        for (int32_t j = 0; j < 5; j++)
+        {
+            const int32_t row[] = { i, j, 0 };
+            TEST_ASSERT_TRUE(isAligned(floatArrayNDAt(&arr, row)));
+
+            for (int32_t k = 0; k < 7; k++)
+            {
+                const int32_t indices[] = { i, j, k };
+                TEST_ASSERT_EQUAL_FLOAT(0.0f, *floatArrayNDAt(&arr, indices));
+                *floatArrayNDAt(&arr, indices) = (float)(i * 100 + j * 10 + k);
+            }
+        }
+    }
+
+    const int32_t last[] = { 2, 4, 6 };
+    TEST_ASSERT_EQUAL_FLOAT(246.0f, arr.values[floatArrayNDOffset(&arr, last)]);
+
+    floatFreeArrayND(&arr);
+    TEST_ASSERT_NULL(arr.values);
+    floatFreeArrayND(&arr);
+}
+
+void test_arraynd_does_not_pad_odd_sized_items(void)
+{
+    pointArrayND arr;
+    const int32_t dims[] = { 4, 3 };
+
+    TEST_ASSERT_TRUE(pointCreateArrayND(&arr, 2, dims));
+    TEST_ASSERT_TRUE(isAligned(arr.values));
+    TEST_ASSERT_EQUAL_size_t(SHL_ARRAY_ALIGNMENT / sizeof(Point) > 3 ? SHL_ARRAY_ALIGNMENT / sizeof(Point) : 3, arr.strides[0]);
+
+    const int32_t indices[] = { 3, 2 };
+    pointArrayNDAt(&arr, indices)->x = 1.5f;
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, arr.values[3 * arr.strides[0] + 2].x);
+
+    pointFreeArrayND(&arr);
+}
+
+static void fillRowMajor(float** arr, int32_t n, int32_t m)
+{
+    for (int32_t i = 0; i < n; i++)
+    {
+        for (int32_t j = 0; j < m; j++)
+        {
+            arr[i][j] = (float)(i * 1000 + j);
+        }
+    }
+}
+
+static void assertTiledRoundTrip(int32_t n, int32_t m, int32_t tileSize)
+{
+    float** source = floatCreateArray(n, m);
+    float** target = floatCreateArray(n, m);
+    fillRowMajor(source, n, m);
+
+    floatTiledArray tiled;
+    TEST_ASSERT_TRUE(floatCreateTiledArray(&tiled, n, m, tileSize));
+    TEST_ASSERT_TRUE(isAligned(tiled.values));
+    floatTiledArrayFromRowMajor(&tiled, source[0], (size_t)m);
+
+    for (int32_t i = 0; i < n; i++)
+    {
+        for (int32_t j = 0; j < m; j++)
+        {
+            TEST_ASSERT_EQUAL_FLOAT(source[i][j], shlTiledArrayAt(&tiled, i, j));
+        }
+    }
+
+    floatTiledArrayToRowMajor(&tiled, target[0], (size_t)m);
+    TEST_ASSERT_EQUAL_MEMORY(source[0], target[0], (size_t)n * (size_t)m * sizeof(float));
+
+    floatFreeTiledArray(&tiled);
+    floatFreeArray(source);
+    floatFreeArray(target);
+}
+
+void test_tiled_array_keeps_every_tile_contiguous(void)
+{
+    floatTiledArray tiled;
+    TEST_ASSERT_TRUE(floatCreateTiledArray(&tiled, 20, 30, 0));
+    TEST_ASSERT_EQUAL_INT(SHL_ARRAY_DEFAULT_TILE_SIZE, 1 << tiled.tileShift);
+
+    const size_t tileArea = SHL_ARRAY_DEFAULT_TILE_SIZE * SHL_ARRAY_DEFAULT_TILE_SIZE;
+    TEST_ASSERT_EQUAL_size_t(0, shlTiledArrayOffset(&tiled, 0, 0));
+    TEST_ASSERT_EQUAL_size_t(SHL_ARRAY_DEFAULT_TILE_SIZE, shlTiledArrayOffset(&tiled, 1, 0));
+    TEST_ASSERT_EQUAL_size_t(tileArea, shlTiledArrayOffset(&tiled, 0, SHL_ARRAY_DEFAULT_TILE_SIZE));
+    TEST_ASSERT_EQUAL_size_t(12 * tileArea, tiled.count);
+    TEST_ASSERT_EQUAL_size_t(tiled.count - 1, shlTiledArrayOffset(&tiled, 23, 31));
+
+    shlTiledArrayAt(&tiled, 19, 29) = 7.0f;
+    TEST_ASSERT_EQUAL_FLOAT(7.0f, tiled.values[shlTiledArrayOffset(&tiled, 19, 29)]);
+
+    floatFreeTiledArray(&tiled);
+    TEST_ASSERT_FALSE(floatCreateTiledArray(&tiled, 4, 4, 12));
+    TEST_ASSERT_NULL(tiled.values);
+}
+
+void test_tiled_array_round_trips_row_major_data(void)
+{
+    assertTiledRoundTrip(37, 53, 8);
+    assertTiledRoundTrip(64, 16, 16);
+    assertTiledRoundTrip(5, 3, 4);
+}
+
+void test_morton_array_interleaves_coordinates(void)
+{
+    floatMortonArray morton;
+    TEST_ASSERT_TRUE(floatCreateMortonArray(&morton, 4, 16));
+    TEST_ASSERT_EQUAL_size_t(64, morton.count);
+
+    TEST_ASSERT_EQUAL_size_t(0, shlMortonArrayOffset(&morton, 0, 0));
+    TEST_ASSERT_EQUAL_size_t(1, shlMortonArrayOffset(&morton, 0, 1));
+    TEST_ASSERT_EQUAL_size_t(2, shlMortonArrayOffset(&morton, 1, 0));
+    TEST_ASSERT_EQUAL_size_t(3, shlMortonArrayOffset(&morton, 1, 1));
+    TEST_ASSERT_EQUAL_size_t(4, shlMortonArrayOffset(&morton, 0, 2));
+    TEST_ASSERT_EQUAL_size_t(16, shlMortonArrayOffset(&morton, 0, 4));
+    TEST_ASSERT_EQUAL_size_t(63, shlMortonArrayOffset(&morton, 3, 15));
+    TEST_ASSERT_EQUAL_size_t(morton.count - 1, morton.rowMask | morton.colMask);
+    TEST_ASSERT_EQUAL_size_t(0, morton.rowMask & morton.colMask);
+
+    bool seen[64] = { false };
+    for (int32_t i = 0; i < 4; i++)
+    {
+        for (int32_t j = 0; j < 16; j++)
+        {
+            size_t offset = shlMortonArrayOffset(&morton, i, j);
+            TEST_ASSERT_TRUE(offset < morton.count);
+            TEST_ASSERT_FALSE(seen[offset]);
+            seen[offset] = true;
+        }
+    }
+
+    floatFreeMortonArray(&morton);
+}
+
+void test_morton_array_steps_to_neighbours(void)
+{
+    floatMortonArray morton;
+    TEST_ASSERT_TRUE(floatCreateMortonArray(&morton, 8, 32));
+
+    for (int32_t i = 1; i < 7; i++)
+    {
+        for (int32_t j = 1; j < 31; j++)
+        {
+            size_t offset = shlMortonArrayOffset(&morton, i, j);
+            TEST_ASSERT_EQUAL_size_t(shlMortonArrayOffset(&morton, i, j + 1), shlMortonArrayNextCol(&morton, offset));
+            TEST_ASSERT_EQUAL_size_t(shlMortonArrayOffset(&morton, i, j - 1), shlMortonArrayPrevCol(&morton, offset));
+            TEST_ASSERT_EQUAL_size_t(shlMortonArrayOffset(&morton, i + 1, j), shlMortonArrayNextRow(&morton, offset));
+            TEST_ASSERT_EQUAL_size_t(shlMortonArrayOffset(&morton, i - 1, j), shlMortonArrayPrevRow(&morton, offset));
+        }
+    }
+
+    floatFreeMortonArray(&morton);
+}
+
+void test_morton_array_round_trips_row_major_data(void)
+{
+    const int32_t sizes[][2] = { { 37, 53 }, { 64, 8 }, { 1, 9 }, { 16, 16 } };
+
+    for (int32_t s = 0; s < 4; s++)
+    {
+        int32_t n = sizes[s][0];
+        int32_t m = sizes[s][1];
+        float** source = floatCreateArray(n, m);
+        float** target = floatCreateArray(n, m);
+        fillRowMajor(source, n, m);
+
+        floatMortonArray morton;
+        TEST_ASSERT_TRUE(floatCreateMortonArray(&morton, n, m));
+        floatMortonArrayFromRowMajor(&morton, source[0], (size_t)m);
+
+        for (int32_t i = 0; i < n; i++)
+        {
+            for (int32_t j = 0; j < m; j++)
+            {
+                TEST_ASSERT_EQUAL_FLOAT(source[i][j], shlMortonArrayAt(&morton, i, j));
+            }
+        }
+
+        floatMortonArrayToRowMajor(&morton, target[0], (size_t)m);
+        TEST_ASSERT_EQUAL_MEMORY(source[0], target[0], (size_t)n * (size_t)m * sizeof(float));
+
+        floatFreeMortonArray(&morton);
+        floatFreeArray(source);
+        floatFreeArray(target);
+    }
+}
+
+static float scaleFloat(float value, void* userData)
+{
+    return value * *(float*)userData;
+}
+
+static float maxFloat(float acc, float value, void* userData)
+{
+    (void)userData;
+    return value > acc ? value : acc;
+}
+
+void test_fill_array_sets_every_cell(void)
+{
+    const int32_t n = 37;
+    const int32_t m = 29;
+
+    uint8_t** bytes = u8CreateArray(n, m);
+    u8FillArray(bytes, n, m, 0x5A);
+
+    uint16_t** shorts = u16CreateArray(n, m);
+    u16FillArray(shorts, n, m, 0xBEEF);
+
+    float** floats = floatCreateArray(n, m);
+    floatFillArray(floats, n, m, 2.5f);
+
+    uint64_t** longs = u64CreateArray(n, m);
+    u64FillArray(longs, n, m, 0x0123456789ABCDEFull);
+
+    Rgb** colors = rgbCreateArray(n, m);
+    rgbFillArray(colors, n, m, (Rgb){ 1, 2, 3 });
+
+    for (int32_t i = 0; i < n; i++)
+    {
+        for (int32_t j = 0; j < m; j++)
+        {
+            TEST_ASSERT_EQUAL_HEX8(0x5A, bytes[i][j]);
+            TEST_ASSERT_EQUAL_HEX16(0xBEEF, shorts[i][j]);
+            TEST_ASSERT_EQUAL_FLOAT(2.5f, floats[i][j]);
+            TEST_ASSERT_TRUE(longs[i][j] == 0x0123456789ABCDEFull);
+            TEST_ASSERT_EQUAL_UINT8(1, colors[i][j].r);
+            TEST_ASSERT_EQUAL_UINT8(2, colors[i][j].g);
+            TEST_ASSERT_EQUAL_UINT8(3, colors[i][j].b);
+        }
+    }
+
+    u8FreeArray(bytes);
+    u16FreeArray(shorts);
+    floatFreeArray(floats);
+    u64FreeArray(longs);
+    rgbFreeArray(colors);
+}
+
+void test_fill_array_region_only_touches_the_region(void)
+{
+    uint8_t** bytes = u8CreateArray(20, 70);
+    u8FillArrayRegion(bytes, 3, 5, 10, 50, 7);
+
+    for (int32_t i = 0; i < 20; i++)
+    {
+        for (int32_t j = 0; j < 70; j++)
+        {
+            bool inside = i >= 3 && i < 13 && j >= 5 && j < 55;
+            TEST_ASSERT_EQUAL_UINT8(inside ? 7 : 0, bytes[i][j]);
+        }
+    }
+
+    u8FreeArray(bytes);
+}
+
+void test_copy_array_region_handles_overlap(void)
+{
+    const int32_t n = 12;
+    const int32_t m = 12;
+    float** grid = floatCreateArray(n, m);
+    float** expected = floatCreateArray(n, m);
+    fillRowMajor(grid, n, m);
+    fillRowMajor(expected, n, m);
+
+    for (int32_t i = 0; i < 6; i++)
+    {
+        for (int32_t j = 0; j < 7; j++)
+        {
+            expected[i + 2][j + 3] = (float)(i * 1000 + j);
+        }
+    }
+
+    floatCopyArrayRegion(grid, 2, 3, grid, 0, 0, 6, 7);
+    TEST_ASSERT_EQUAL_MEMORY(expected[0], grid[0], (size_t)n * (size_t)m * sizeof(float));
+
+    fillRowMajor(grid, n, m);
+    floatCopyArrayRegion(expected, 0, 0, grid, 4, 2, 8, 10);
+    floatCopyArrayRegion(grid, 0, 0, grid, 4, 2, 8, 10);
+    TEST_ASSERT_EQUAL_MEMORY(expected[0], grid[0], (size_t)n * (size_t)m * sizeof(float));
+
+    floatFreeArray(grid);
+    floatFreeArray(expected);
+}
+
+void test_blit_array_skips_key_cells(void)
+{
+    const int32_t n = 9;
+    const int32_t m = 45;
+    uint8_t** bytesSrc = u8CreateArray(n, m);
+    uint8_t** bytesDst = u8CreateArray(n, m);
+    uint16_t** shortsSrc = u16CreateArray(n, m);
+    uint16_t** shortsDst = u16CreateArray(n, m);
+    uint64_t** longsSrc = u64CreateArray(n, m);
+    uint64_t** longsDst = u64CreateArray(n, m);
+    Rgb** colorsSrc = rgbCreateArray(n, m);
+    Rgb** colorsDst = rgbCreateArray(n, m);
+
+    for (int32_t i = 0; i < n; i++)
+    {
+        for (int32_t j = 0; j < m; j++)
+        {
+            bool key = (i + j) % 3 == 0;
+            bytesSrc[i][j] = key ? 0 : (uint8_t)(j + 1);
+            shortsSrc[i][j] = key ? 0xFFFF : (uint16_t)(i * 100 + j);
+            longsSrc[i][j] = key ? 0x100000000ull : (uint64_t)j;
+            colorsSrc[i][j] = key ? (Rgb){ 255, 0, 255 } : (Rgb){ (uint8_t)i, (uint8_t)j, 0 };
+        }
+    }
+
+    longsSrc[0][1] = 0x100000001ull;
+    longsSrc[0][2] = 0x000000000ull;
+
+    u8FillArray(bytesDst, n, m, 0xAA);
+    u16FillArray(shortsDst, n, m, 0xAAAA);
+    u64FillArray(longsDst, n, m, 77);
+    rgbFillArray(colorsDst, n, m, (Rgb){ 9, 9, 9 });
+
+    u8BlitArray(bytesDst, 0, 0, bytesSrc, 0, 0, n, m, 0);
+    u16BlitArray(shortsDst, 0, 0, shortsSrc, 0, 0, n, m, 0xFFFF);
+    u64BlitArray(longsDst, 0, 0, longsSrc, 0, 0, n, m, 0x100000000ull);
+    rgbBlitArray(colorsDst, 0, 0, colorsSrc, 0, 0, n, m, (Rgb){ 255, 0, 255 });
+
+    for (int32_t i = 0; i < n; i++)
+    {
+        for (int32_t j = 0; j < m; j++)
+        {
+            bool key = (i + j) % 3 == 0 && !(i == 0 && (j == 1 || j == 2));
+            TEST_ASSERT_EQUAL_UINT8(key ? 0xAA : bytesSrc[i][j], bytesDst[i][j]);
+            TEST_ASSERT_EQUAL_UINT16(key ? 0xAAAA : shortsSrc[i][j], shortsDst[i][j]);
+            TEST_ASSERT_TRUE(longsDst[i][j] == (key ? 77 : longsSrc[i][j]));
+            TEST_ASSERT_EQUAL_UINT8(key ? 9 : colorsSrc[i][j].r, colorsDst[i][j].r);
+            TEST_ASSERT_EQUAL_UINT8(key ? 9 : colorsSrc[i][j].g, colorsDst[i][j].g);
+        }
+    }
+
+    u8FreeArray(bytesSrc);
+    u8FreeArray(bytesDst);
+    u16FreeArray(shortsSrc);
+    u16FreeArray(shortsDst);
+    u64FreeArray(longsSrc);
+    u64FreeArray(longsDst);
+    rgbFreeArray(colorsSrc);
+    rgbFreeArray(colorsDst);
+}
+
+void test_map_and_reduce_array(void)
+{
+    const int32_t n = 7;
+    const int32_t m = 13;
+    float** source = floatCreateArray(n, m);
+    float** target = floatCreateArray(n, m);
+    fillRowMajor(source, n, m);
+
+    float factor = 2.0f;
+    floatMapArray(target, source, n, m, scaleFloat, &factor);
+    TEST_ASSERT_EQUAL_FLOAT(2.0f * 6012.0f, target[6][12]);
+    TEST_ASSERT_EQUAL_FLOAT(6012.0f, floatReduceArray(source, n, m, -1.0f, maxFloat, NULL));
+    TEST_ASSERT_EQUAL_FLOAT(-1.0f, floatReduceArray(source, 0, m, -1.0f, maxFloat, NULL));
+
+    shlArrayMapExpr(float, target, n, m, x, x * 0.5f + 1.0f);
+    TEST_ASSERT_EQUAL_FLOAT(6013.0f, target[6][12]);
+
+    float sum = 0;
+    shlArrayReduceExpr(float, source, n, m, sum, x, sum + (x < 1000.0f ? x : 0.0f));
+    TEST_ASSERT_EQUAL_FLOAT(78.0f, sum);
+
+    floatFreeArray(source);
+    floatFreeArray(target);
+}
+
+static uint8_t lifeCell(uint8_t** src, int32_t n, int32_t m, int32_t i, int32_t j)
+{
+    int32_t alive = 0;
+    for (int32_t di = -1; di <= 1; di++)
+    {
+        for (int32_t dj = -1; dj <= 1; dj++)
+        {
+            int32_t y = i + di;
+            int32_t x = j + dj;
+            if ((di != 0 || dj != 0) && y >= 0 && y < n && x >= 0 && x < m)
+                alive += src[y][x];
+        }
+    }
+    return (uint8_t)(alive == 3 || (alive == 2 && src[i][j]));
+}
+
+typedef struct
+{
+    int32_t n;
+    bool inPlace[16];
+    shlArrayRows bands[16];
+} RowsRecord;
+
+static void lifeRows(uint8_t** dst, uint8_t** src, shlArrayRows rows, void* userData)
+{
+    RowsRecord* record = (RowsRecord*)userData;
+    record->bands[rows.band] = rows;
+
+    for (int32_t i = rows.begin; i < rows.end; i++)
+    {
+        for (int32_t j = 0; j < rows.cols; j++)
+        {
+            dst[i][j] = lifeCell(src, record->n, rows.cols, i, j);
+        }
+    }
+}
+
+static void markBandRows(uint8_t** dst, uint8_t** src, shlArrayRows rows, void* userData)
+{
+    RowsRecord* record = (RowsRecord*)userData;
+    record->inPlace[rows.band] = dst == src;
+    record->bands[rows.band] = rows;
+
+    for (int32_t i = rows.begin; i < rows.end; i++)
+    {
+        for (int32_t j = 0; j < rows.cols; j++)
+        {
+            dst[i][j] = (uint8_t)(dst[i][j] + rows.band + 1);
+        }
+    }
+}
+
+static void assertBandsCoverRows(const RowsRecord* record, int32_t bandCount, int32_t n, int32_t halo)
+{
+    int32_t next = 0;
+    for (int32_t band = 0; band < bandCount; band++)
+    {
+        const shlArrayRows* rows = &record->bands[band];
+        TEST_ASSERT_EQUAL_INT(band, rows->band);
+        TEST_ASSERT_EQUAL_INT(next, rows->begin);
+        TEST_ASSERT_TRUE(rows->end > rows->begin);
+        TEST_ASSERT_EQUAL_INT(rows->begin - halo > 0 ? rows->begin - halo : 0, rows->readBegin);
+        TEST_ASSERT_EQUAL_INT(rows->end + halo < n ? rows->end + halo : n, rows->readEnd);
+        next = rows->end;
+    }
+    TEST_ASSERT_EQUAL_INT(n, next);
+}
+
+void test_parallel_for_rows_double_buffers_stencil_updates(void)
+{
+    const int32_t n = 37;
+    const int32_t m = 41;
+    const int32_t threadCounts[] = { 1, 3, 4, 7 };
+
+    uint8_t** expected = u8CreateArray(n, m);
+    uint8_t** expectedNext = u8CreateArray(n, m);
+
+    for (int32_t t = 0; t < 4; t++)
+    {
+        shlArrayPool pool;
+        TEST_ASSERT_TRUE(shlArrayPoolInit(&pool, threadCounts[t]));
+        TEST_ASSERT_EQUAL_INT(threadCounts[t], pool.threadCount);
+
+        uint8_t** grid = u8CreateArray(n, m);
+        uint8_t** back = u8CreateArray(n, m);
+        for (int32_t i = 0; i < n; i++)
+        {
+            for (int32_t j = 0; j < m; j++)
+            {
+                expected[i][j] = grid[i][j] = (uint8_t)(((i * 7 + j * 13) % 5) == 0 || (i == j));
+            }
+        }
+
+        for (int32_t step = 0; step < 10; step++)
+        {
+            for (int32_t i = 0; i < n; i++)
+            {
+                for (int32_t j = 0; j < m; j++)
+                {
+                    expectedNext[i][j] = lifeCell(expected, n, m, i, j);
+                }
+            }
+
+            uint8_t** swap = expected;
+            expected = expectedNext;
+            expectedNext = swap;
+
+            RowsRecord record = { .n = n };
+            uint8_t** previous = grid;
+            u8ParallelForRows(&grid, &back, n, m, lifeRows, &record, &pool, 1);
+            TEST_ASSERT_EQUAL_PTR(previous, back);
+            TEST_ASSERT_EQUAL_MEMORY(expected[0], grid[0], (size_t)n * (size_t)m);
+            assertBandsCoverRows(&record, threadCounts[t], n, 1);
+        }
+
+        u8FreeArray(grid);
+        u8FreeArray(back);
+        shlArrayPoolFree(&pool);
+    }
+
+    u8FreeArray(expected);
+    u8FreeArray(expectedNext);
+}
+
+void test_parallel_for_rows_in_place_splits_rows_into_bands(void)
+{
+    const int32_t n = 10;
+    const int32_t m = 5;
+    uint8_t** grid = u8CreateArray(n, m);
+
+    shlArrayPool pool;
+    TEST_ASSERT_TRUE(shlArrayPoolInit(&pool, 4));
+
+    RowsRecord record = { .n = n };
+    u8ParallelForRows(&grid, NULL, n, m, markBandRows, &record, &pool, 3);
+    assertBandsCoverRows(&record, 4, n, 0);
+
+    for (int32_t band = 0; band < 4; band++)
+    {
+        TEST_ASSERT_TRUE(record.inPlace[band]);
+
+        for (int32_t i = record.bands[band].begin; i < record.bands[band].end; i++)
+        {
+            TEST_ASSERT_EQUAL_UINT8(band + 1, grid[i][0]);
+            TEST_ASSERT_EQUAL_UINT8(band + 1, grid[i][m - 1]);
+        }
+    }
+
+    RowsRecord serial = { .n = n };
+    u8ParallelForRows(&grid, NULL, n, m, markBandRows, &serial, NULL, 0);
+    assertBandsCoverRows(&serial, 1, n, 0);
+    TEST_ASSERT_EQUAL_UINT8(5, grid[n - 1][0]);
+
+    shlArrayPoolFree(&pool);
+
+    TEST_ASSERT_TRUE(shlArrayPoolInit(&pool, 16));
+    RowsRecord tiny = { .n = 3 };
+    u8ParallelForRows(&grid, NULL, 3, m, markBandRows, &tiny, &pool, 0);
+    assertBandsCoverRows(&tiny, 3, 3, 0);
+    shlArrayPoolFree(&pool);
+
+    u8FreeArray(grid);
+}
+
 void setUp(void)
 {
 }
@@ -116,5 +768,22 @@ int main(void)
     RUN_TEST(test_value_array_round_trip_preserves_values);
     RUN_TEST(test_reference_array_can_store_allocated_points);
     RUN_TEST(test_large_array_stress_preserves_tail_value);
+    RUN_TEST(test_value_array_data_is_aligned_and_zeroed);
+    RUN_TEST(test_array_creators_reject_overflowing_sizes);
+    RUN_TEST(test_array3d_layout_is_contiguous);
+    RUN_TEST(test_arraynd_rows_are_padded_and_aligned);
+    RUN_TEST(test_arraynd_does_not_pad_odd_sized_items);
+    RUN_TEST(test_tiled_array_keeps_every_tile_contiguous);
+    RUN_TEST(test_tiled_array_round_trips_row_major_data);
+    RUN_TEST(test_morton_array_interleaves_coordinates);
+    RUN_TEST(test_morton_array_steps_to_neighbours);
+    RUN_TEST(test_morton_array_round_trips_row_major_data);
+    RUN_TEST(test_fill_array_sets_every_cell);
+    RUN_TEST(test_fill_array_region_only_touches_the_region);
+    RUN_TEST(test_copy_array_region_handles_overlap);
+    RUN_TEST(test_blit_array_skips_key_cells);
+    RUN_TEST(test_map_and_reduce_array);
+    RUN_TEST(test_parallel_for_rows_double_buffers_stencil_updates);
+    RUN_TEST(test_parallel_for_rows_in_place_splits_rows_into_bands);
     return UNITY_END();
 }
@@ -10,6 +10,14 @@ static int32_t compareInt(const int a, const int b)
     return a - b;
 }
 
+static int g_compareCount = 0;
+
+static int32_t countedCompareInt(const int a, const int b)
+{
+    g_compareCount++;
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
 static bool equalsInt(const int a, const int b)
 {
     return a == b;
@@ -24,6 +32,8 @@ shlDeclareBinaryHeap(IntHeap, int)
 shlDefineBinaryHeap(IntHeap, int)
 shlDeclareBinaryHeap(StringHeap, const char*)
 shlDefineBinaryHeap(StringHeap, const char*)
+shlDeclareIndexedHeap(IntIndexedHeap, int)
+shlDefineIndexedHeap(IntIndexedHeap, int)
 
 static char* makeSizedString(int length)
 {
@@ -143,6 +153,33 @@ void test_heap_stress_preserves_sorted_pop_sequence(void)
     IntHeapFree(&heap);
 }
 
+void test_heap_reserve_and_shrink_to_fit_adjust_capacity(void)
+{
+    IntHeap heap;
+    IntHeapInit(&heap, (IntHeapOptions){ .defaultValue = -1, .equalsFn = equalsInt, .compareFn = compareInt });
+
+    IntHeapReserve(&heap, 64);
+    TEST_ASSERT_EQUAL_INT(64, heap.capacity);
+
+    for (int i = 64; i > 0; i--)
+    {
+        IntHeapPush(&heap, i);
+    }
+
+    TEST_ASSERT_EQUAL_INT(64, heap.capacity);
+
+    for (int i = 1; i <= 32; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntHeapPop(&heap));
+    }
+
+    IntHeapShrinkToFit(&heap);
+    TEST_ASSERT_EQUAL_INT(32, heap.capacity);
+    TEST_ASSERT_EQUAL_INT(33, IntHeapPeek(&heap));
+
+    IntHeapFree(&heap);
+}
+
 void test_string_heap_orders_by_string_length(void)
 {
     const int lengths[] = { 8, 3, 5, 1, 6 };
@@ -171,6 +208,321 @@ void test_string_heap_orders_by_string_length(void)
     StringHeapFree(&heap);
 }
 
+static void assertHeapOrder(IntHeap* heap)
+{
+    for (int32_t i = 1; i < heap->count; i++)
+    {
+        TEST_ASSERT_TRUE(heap->items[(i - 1) / heap->arity] <= heap->items[i]);
+    }
+}
+
+void test_heap_from_array_builds_valid_heap(void)
+{
+    int values[SHL_TEST_MEDIUM_COUNT];
+    for (int i = 0; i < SHL_TEST_MEDIUM_COUNT; i++)
+    {
+        values[i] = (i * 7919) % SHL_TEST_MEDIUM_COUNT;
+    }
+
+    IntHeap heap;
+    IntHeapFromArray(&heap, (IntHeapOptions){ .defaultValue = -1, .equalsFn = equalsInt, .compareFn = compareInt }, SHL_TEST_MEDIUM_COUNT, values);
+
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_MEDIUM_COUNT, heap.count);
+    assertHeapOrder(&heap);
+
+    for (int i = 0; i < SHL_TEST_MEDIUM_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntHeapPop(&heap));
+    }
+
+    TEST_ASSERT_EQUAL_INT(-1, IntHeapPop(&heap));
+    IntHeapFree(&heap);
+
+    IntHeapFromArray(&heap, (IntHeapOptions){ .defaultValue = -1, .compareFn = compareInt }, 0, values);
+    TEST_ASSERT_EQUAL_INT(0, heap.count);
+    TEST_ASSERT_EQUAL_INT(-1, IntHeapPeek(&heap));
+    IntHeapFree(&heap);
+}
+
+void test_heap_from_array_compares_within_floyd_bound(void)
+{
+    enum { COUNT = SHL_TEST_STRESS_COUNT };
+    static int values[COUNT];
+    unsigned seed = 4242u;
+    for (int i = 0; i < COUNT; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        values[i] = (int)(seed >> 8);
+    }
+
+    for (int arity = 2; arity <= 8; arity *= 2)
+    {
+        IntHeap heap;
+        g_compareCount = 0;
+        IntHeapFromArray(&heap, (IntHeapOptions){ .defaultValue = -1, .compareFn = countedCompareInt, .arity = arity }, COUNT, values);
+
+        TEST_ASSERT_TRUE(g_compareCount <= arity * COUNT / (arity - 1) + COUNT / 64);
+        assertHeapOrder(&heap);
+        IntHeapFree(&heap);
+
+        IntHeapInit(&heap, (IntHeapOptions){ .defaultValue = -1, .compareFn = countedCompareInt, .arity = arity });
+        IntHeapPushRange(&heap, COUNT / 4, values);
+        g_compareCount = 0;
+        IntHeapPushRange(&heap, COUNT - COUNT / 4, values + COUNT / 4);
+
+        TEST_ASSERT_TRUE(g_compareCount <= arity * COUNT / (arity - 1) + COUNT / 64);
+        assertHeapOrder(&heap);
+        IntHeapFree(&heap);
+    }
+}
+
+static void assertPushRangeKeepsOrder(int arity)
+{
+    int values[64];
+    unsigned seed = 12345u;
+
+    for (int existing = 0; existing < 40; existing += 3)
+    {
+        for (int added = 1; added < 64; added += 5)
+        {
+            IntHeap heap;
+            IntHeapInit(&heap, (IntHeapOptions){ .defaultValue = -1, .compareFn = compareInt, .arity = arity });
+
+            for (int i = 0; i < existing; i++)
+            {
+                seed = seed * 1103515245u + 12345u;
+                IntHeapPush(&heap, (int)((seed >> 16) % 1000));
+            }
+
+            for (int i = 0; i < added; i++)
+            {
+                seed = seed * 1103515245u + 12345u;
+                values[i] = (int)((seed >> 16) % 1000);
+            }
+
+            IntHeapPushRange(&heap, added, values);
+            TEST_ASSERT_EQUAL_INT(existing + added, heap.count);
+            assertHeapOrder(&heap);
+
+            int previous = IntHeapPop(&heap);
+            while (heap.count > 0)
+            {
+                int current = IntHeapPop(&heap);
+                TEST_ASSERT_TRUE(previous <= current);
+                previous = current;
+            }
+
+            IntHeapFree(&heap);
+        }
+    }
+}
+
+void test_heap_push_range_into_existing_heap_keeps_order(void)
+{
+    assertPushRangeKeepsOrder(2);
+    assertPushRangeKeepsOrder(4);
+    assertPushRangeKeepsOrder(8);
+}
+
+void test_heap_arity_is_rounded_to_power_of_two(void)
+{
+    const int arities[] = { 0, 1, 2, 3, 4, 5, 8, 100 };
+    const int expected[] = { 2, 2, 2, 4, 4, 8, 8, 64 };
+
+    for (int i = 0; i < 8; i++)
+    {
+        IntHeap heap;
+        IntHeapInit(&heap, (IntHeapOptions){ .defaultValue = -1, .compareFn = compareInt, .arity = arities[i] });
+        TEST_ASSERT_EQUAL_INT(expected[i], heap.arity);
+        IntHeapFree(&heap);
+    }
+}
+
+void test_dary_heap_push_pop_update_keep_order(void)
+{
+    for (int arity = 4; arity <= 16; arity *= 2)
+    {
+        IntHeap heap;
+        IntHeapInit(&heap, (IntHeapOptions){ .defaultValue = -1, .equalsFn = equalsInt, .compareFn = compareInt, .arity = arity });
+
+        for (int i = 0; i < SHL_TEST_STRESS_COUNT; i++)
+        {
+            IntHeapPush(&heap, (i * 7919) % SHL_TEST_STRESS_COUNT);
+        }
+
+        assertHeapOrder(&heap);
+        TEST_ASSERT_EQUAL_INT(0, IntHeapPeek(&heap));
+
+        int index = IntHeapIndexOf(&heap, SHL_TEST_STRESS_COUNT - 1);
+        IntHeapUpdate(&heap, index, -5);
+        index = IntHeapIndexOf(&heap, 1);
+        IntHeapUpdate(&heap, index, SHL_TEST_STRESS_COUNT + 5);
+        assertHeapOrder(&heap);
+
+        TEST_ASSERT_EQUAL_INT(-5, IntHeapPop(&heap));
+
+        int previous = IntHeapPop(&heap);
+        TEST_ASSERT_EQUAL_INT(0, previous);
+        while (heap.count > 0)
+        {
+            int current = IntHeapPop(&heap);
+            TEST_ASSERT_TRUE(previous < current);
+            previous = current;
+        }
+
+        TEST_ASSERT_EQUAL_INT(SHL_TEST_STRESS_COUNT + 5, previous);
+        IntHeapFree(&heap);
+    }
+}
+
+static void assertIndexedHeapConsistent(IntIndexedHeap* heap)
+{
+    for (int32_t i = 0; i < heap->count; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, heap->positions[heap->handles[i]]);
+
+        if (i > 0)
+        {
+            TEST_ASSERT_TRUE(heap->items[(i - 1) / heap->arity] <= heap->items[i]);
+        }
+    }
+}
+
+void test_indexed_heap_handles_follow_items(void)
+{
+    IntIndexedHeap heap;
+    IntIndexedHeapInit(&heap, (IntIndexedHeapOptions){ .defaultValue = -1, .compareFn = compareInt });
+
+    int32_t handle = 0;
+    TEST_ASSERT_EQUAL_INT(-1, IntIndexedHeapPeek(&heap, &handle));
+    TEST_ASSERT_EQUAL_INT(-1, handle);
+    TEST_ASSERT_FALSE(IntIndexedHeapContainsHandle(&heap, 3));
+    TEST_ASSERT_FALSE(IntIndexedHeapDecreaseKey(&heap, 3, 1));
+
+    for (int i = 0; i < 20; i++)
+    {
+        IntIndexedHeapPushWithHandle(&heap, i * 3, 100 + i);
+    }
+
+    assertIndexedHeapConsistent(&heap);
+    TEST_ASSERT_TRUE(IntIndexedHeapContainsHandle(&heap, 57));
+    TEST_ASSERT_FALSE(IntIndexedHeapContainsHandle(&heap, 58));
+    TEST_ASSERT_EQUAL_INT(110, IntIndexedHeapGetByHandle(&heap, 30));
+
+    TEST_ASSERT_TRUE(IntIndexedHeapDecreaseKey(&heap, 45, 5));
+    assertIndexedHeapConsistent(&heap);
+    TEST_ASSERT_EQUAL_INT(5, IntIndexedHeapPeek(&heap, &handle));
+    TEST_ASSERT_EQUAL_INT(45, handle);
+
+    IntIndexedHeapPushWithHandle(&heap, 45, 200);
+    TEST_ASSERT_EQUAL_INT(20, heap.count);
+    TEST_ASSERT_EQUAL_INT(200, IntIndexedHeapGetByHandle(&heap, 45));
+    assertIndexedHeapConsistent(&heap);
+
+    int value = 0;
+    TEST_ASSERT_TRUE(IntIndexedHeapRemoveByHandle(&heap, 0, &value));
+    TEST_ASSERT_EQUAL_INT(100, value);
+    TEST_ASSERT_FALSE(IntIndexedHeapRemoveByHandle(&heap, 0, &value));
+    TEST_ASSERT_FALSE(IntIndexedHeapContainsHandle(&heap, 0));
+    assertIndexedHeapConsistent(&heap);
+
+    TEST_ASSERT_EQUAL_INT(101, IntIndexedHeapPop(&heap, &handle));
+    TEST_ASSERT_EQUAL_INT(3, handle);
+    TEST_ASSERT_FALSE(IntIndexedHeapContainsHandle(&heap, 3));
+
+    IntIndexedHeapClear(&heap);
+    TEST_ASSERT_EQUAL_INT(0, heap.count);
+    TEST_ASSERT_FALSE(IntIndexedHeapContainsHandle(&heap, 57));
+
+    IntIndexedHeapPushWithHandle(&heap, 57, 1);
+    TEST_ASSERT_EQUAL_INT(1, IntIndexedHeapPop(&heap, NULL));
+    IntIndexedHeapFree(&heap);
+}
+
+void test_indexed_heap_dijkstra_on_grid_matches_relaxation(void)
+{
+    enum { WIDTH = 24, HEIGHT = 24, NODES = WIDTH * HEIGHT };
+    int cost[NODES];
+    int best[NODES];
+    int expected[NODES];
+
+    for (int i = 0; i < NODES; i++)
+    {
+        cost[i] = 1 + (i * 37 + i / WIDTH * 11) % 9;
+        best[i] = INT_MAX;
+        expected[i] = INT_MAX;
+    }
+
+    expected[0] = 0;
+    for (bool changed = true; changed;)
+    {
+        changed = false;
+        for (int node = 0; node < NODES; node++)
+        {
+            if (expected[node] == INT_MAX)
+                continue;
+
+            const int dx[] = { 1, -1, 0, 0 };
+            const int dy[] = { 0, 0, 1, -1 };
+            for (int d = 0; d < 4; d++)
+            {
+                int x = node % WIDTH + dx[d];
+                int y = node / WIDTH + dy[d];
+                if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+                    continue;
+
+                int next = y * WIDTH + x;
+                if (expected[node] + cost[next] < expected[next])
+                {
+                    expected[next] = expected[node] + cost[next];
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    for (int arity = 2; arity <= 8; arity *= 2)
+    {
+        IntIndexedHeap open;
+        IntIndexedHeapInit(&open, (IntIndexedHeapOptions){ .defaultValue = -1, .compareFn = compareInt, .arity = arity });
+
+        for (int i = 0; i < NODES; i++)
+        {
+            best[i] = INT_MAX;
+        }
+
+        best[0] = 0;
+        IntIndexedHeapPushWithHandle(&open, 0, 0);
+
+        while (open.count > 0)
+        {
+            int32_t node;
+            int distance = IntIndexedHeapPop(&open, &node);
+            TEST_ASSERT_EQUAL_INT(best[node], distance);
+
+            const int dx[] = { 1, -1, 0, 0 };
+            const int dy[] = { 0, 0, 1, -1 };
+            for (int d = 0; d < 4; d++)
+            {
+                int x = node % WIDTH + dx[d];
+                int y = node / WIDTH + dy[d];
+                if (x < 0 || y < 0 || x >= WIDTH || y >= HEIGHT)
+                    continue;
+
+                int next = y * WIDTH + x;
+                if (distance + cost[next] < best[next])
+                {
+                    best[next] = distance + cost[next];
+                    IntIndexedHeapPushWithHandle(&open, next, best[next]);
+                }
+            }
+        }
+
+        TEST_ASSERT_EQUAL_INT_ARRAY(expected, best, NODES);
+        IntIndexedHeapFree(&open);
+    }
+}
+
 void setUp(void)
 {
 }
@@ -187,6 +539,14 @@ int main(void)
     RUN_TEST(test_heap_pop_returns_sorted_values);
     RUN_TEST(test_heap_update_reorders_entry_both_directions);
     RUN_TEST(test_heap_stress_preserves_sorted_pop_sequence);
+    RUN_TEST(test_heap_reserve_and_shrink_to_fit_adjust_capacity);
     RUN_TEST(test_string_heap_orders_by_string_length);
+    RUN_TEST(test_heap_from_array_builds_valid_heap);
+    RUN_TEST(test_heap_from_array_compares_within_floyd_bound);
+    RUN_TEST(test_heap_push_range_into_existing_heap_keeps_order);
+    RUN_TEST(test_heap_arity_is_rounded_to_power_of_two);
+    RUN_TEST(test_dary_heap_push_pop_update_keep_order);
+    RUN_TEST(test_indexed_heap_handles_follow_items);
+    RUN_TEST(test_indexed_heap_dijkstra_on_grid_matches_relaxation);
     return UNITY_END();
 }
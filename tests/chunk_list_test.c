@@ -0,0 +1,184 @@
+#include <stdlib.h>
+#include <string.h>
+
+#include "../chunk_list.h"
+#include "test_common.h"
+
+static bool intEquals(const int x, const int y)
+{
+    return x == y;
+}
+
+typedef struct
+{
+    int index;
+    const char* name;
+} Entry;
+
+static bool entryEquals(const Entry* left, const Entry* right)
+{
+    return left->index == right->index && strcmp(left->name, right->name) == 0;
+}
+
+shlDeclareChunkList(IntChunkList, int)
+shlDefineChunkList(IntChunkList, int)
+shlDeclareChunkList(EntryChunkList, Entry*)
+shlDefineChunkList(EntryChunkList, Entry*)
+
+static int g_entryFreeCount = 0;
+
+static void trackedEntryFree(Entry* entry)
+{
+    g_entryFreeCount++;
+    free(entry);
+}
+
+static Entry* makeEntry(int index, const char* name)
+{
+    Entry* entry = (Entry*)malloc(sizeof(Entry));
+    TEST_ASSERT_NOT_NULL(entry);
+    entry->index = index;
+    entry->name = name;
+    return entry;
+}
+
+void test_chunk_list_get_returns_default_when_out_of_range(void)
+{
+    IntChunkList list;
+    IntChunkListInit(&list, (IntChunkListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    TEST_ASSERT_EQUAL_INT(-1, IntChunkListGet(&list, 0));
+    TEST_ASSERT_NULL(IntChunkListGetPtr(&list, 0));
+    TEST_ASSERT_EQUAL_INT(10, list.chunkShift);
+
+    IntChunkListAdd(&list, 5);
+    TEST_ASSERT_EQUAL_INT(5, IntChunkListGet(&list, 0));
+    TEST_ASSERT_EQUAL_INT(-1, IntChunkListGet(&list, 1));
+    TEST_ASSERT_EQUAL_INT(-1, IntChunkListGet(&list, -1));
+
+    IntChunkListFree(&list);
+}
+
+void test_chunk_list_rounds_chunk_size_to_power_of_two(void)
+{
+    IntChunkList list;
+    IntChunkListInit(&list, (IntChunkListOptions){ .defaultValue = -1, .chunkSize = 100 });
+
+    TEST_ASSERT_EQUAL_INT(7, list.chunkShift);
+
+    for (int i = 0; i < 129; i++)
+    {
+        IntChunkListAdd(&list, i);
+    }
+
+    TEST_ASSERT_EQUAL_INT(2, list.chunkCount);
+    TEST_ASSERT_EQUAL_INT(128, IntChunkListGet(&list, 128));
+
+    IntChunkListFree(&list);
+}
+
+void test_chunk_list_item_addresses_are_stable_while_growing(void)
+{
+    IntChunkList list;
+    IntChunkListInit(&list, (IntChunkListOptions){ .defaultValue = -1, .equalsFn = intEquals, .chunkSize = 16 });
+
+    IntChunkListAdd(&list, 42);
+    int* first = IntChunkListGetPtr(&list, 0);
+
+    for (int i = 1; i < SHL_TEST_STRESS_COUNT; i++)
+    {
+        IntChunkListAdd(&list, i);
+    }
+
+    TEST_ASSERT_EQUAL_PTR(first, IntChunkListGetPtr(&list, 0));
+    TEST_ASSERT_EQUAL_INT(42, *first);
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_STRESS_COUNT, list.count);
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_STRESS_COUNT / 16, list.chunkCount);
+
+    for (int i = 1; i < list.count; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntChunkListGet(&list, i));
+    }
+
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_STRESS_COUNT - 1, IntChunkListIndexOf(&list, SHL_TEST_STRESS_COUNT - 1));
+    TEST_ASSERT_FALSE(IntChunkListContains(&list, -5));
+
+    IntChunkListFree(&list);
+}
+
+void test_chunk_list_add_range_and_copy_to_cross_chunk_boundaries(void)
+{
+    int values[100];
+    int copy[102] = {0};
+    IntChunkList list;
+    IntChunkListInit(&list, (IntChunkListOptions){ .defaultValue = -1, .chunkSize = 8 });
+
+    for (int i = 0; i < 100; i++)
+    {
+        values[i] = i * 3;
+    }
+
+    IntChunkListAdd(&list, -7);
+    IntChunkListAddRange(&list, 99, values);
+    TEST_ASSERT_EQUAL_INT(100, list.count);
+    TEST_ASSERT_EQUAL_INT(13, list.chunkCount);
+
+    IntChunkListCopyTo(&list, copy, 2);
+    TEST_ASSERT_EQUAL_INT(0, copy[1]);
+    TEST_ASSERT_EQUAL_INT(-7, copy[2]);
+    for (int i = 1; i < 100; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(values[i - 1], copy[i + 2]);
+    }
+
+    IntChunkListRemoveLast(&list);
+    TEST_ASSERT_EQUAL_INT(99, list.count);
+    TEST_ASSERT_EQUAL_INT(-1, IntChunkListGet(&list, 99));
+
+    IntChunkListClear(&list);
+    TEST_ASSERT_EQUAL_INT(0, list.count);
+    TEST_ASSERT_EQUAL_INT(13, list.chunkCount);
+
+    IntChunkListFree(&list);
+}
+
+void test_entry_chunk_list_set_remove_and_clear_call_free_function(void)
+{
+    EntryChunkList list;
+    EntryChunkListInit(&list, (EntryChunkListOptions){ .defaultValue = NULL, .equalsFn = entryEquals, .freeFn = trackedEntryFree, .chunkSize = 4 });
+
+    for (int i = 0; i < 10; i++)
+    {
+        EntryChunkListAdd(&list, makeEntry(i, "entry"));
+    }
+
+    EntryChunkListSet(&list, 5, makeEntry(50, "replaced"));
+    TEST_ASSERT_EQUAL_INT(1, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(5, EntryChunkListIndexOf(&list, &(Entry){ .index = 50, .name = "replaced" }));
+
+    EntryChunkListRemoveLast(&list);
+    TEST_ASSERT_EQUAL_INT(2, g_entryFreeCount);
+
+    EntryChunkListFree(&list);
+    TEST_ASSERT_EQUAL_INT(11, g_entryFreeCount);
+}
+
+void setUp(void)
+{
+    g_entryFreeCount = 0;
+}
+
+void tearDown(void)
+{
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_chunk_list_get_returns_default_when_out_of_range);
+    RUN_TEST(test_chunk_list_rounds_chunk_size_to_power_of_two);
+    RUN_TEST(test_chunk_list_item_addresses_are_stable_while_growing);
+    RUN_TEST(test_chunk_list_add_range_and_copy_to_cross_chunk_boundaries);
+    RUN_TEST(test_entry_chunk_list_set_remove_and_clear_call_free_function);
+    return UNITY_END();
+}
@@ -0,0 +1,338 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include "../concurrent_queue.h"
+#include "test_common.h"
+
+shlDeclareSpscQueue(IntSpscQueue, int)
+shlDefineSpscQueue(IntSpscQueue, int)
+shlDeclareMpmcQueue(IntMpmcQueue, int)
+shlDefineMpmcQueue(IntMpmcQueue, int)
+shlDeclareMpmcQueue(PtrMpmcQueue, int*)
+shlDefineMpmcQueue(PtrMpmcQueue, int*)
+
+#define PRODUCER_COUNT 4
+#define CONSUMER_COUNT 4
+
+static int g_freeCount = 0;
+
+static void trackedFree(int* value)
+{
+    g_freeCount++;
+    free(value);
+}
+
+typedef struct
+{
+    IntSpscQueue* queue;
+    int count;
+} SpscContext;
+
+static void* spscProducer(void* arg)
+{
+    SpscContext* context = (SpscContext*)arg;
+    int batch[7];
+    int next = 0;
+
+    while (next < context->count)
+    {
+        int n = 0;
+        while (n < 7 && next + n < context->count)
+        {
+            batch[n] = next + n;
+            n++;
+        }
+
+        int pushed = IntSpscQueuePushN(context->queue, n, batch);
+        if (pushed == 0)
+            sched_yield();
+
+        next += pushed;
+    }
+
+    return NULL;
+}
+
+typedef struct
+{
+    IntMpmcQueue* queue;
+    int first;
+    int count;
+    atomic_int* seen;
+    atomic_llong* sum;
+    atomic_int* popped;
+    int total;
+} MpmcContext;
+
+static void* mpmcProducer(void* arg)
+{
+    MpmcContext* context = (MpmcContext*)arg;
+    int i = 0;
+
+    while (i < context->count)
+    {
+        int value = context->first + i;
+
+        if ((i & 1) == 0)
+        {
+            if (IntMpmcQueuePush(context->queue, value))
+                i++;
+            else
+                sched_yield();
+        }
+        else
+        {
+            int batch[3];
+            int n = 0;
+            while (n < 3 && i + n < context->count)
+            {
+                batch[n] = value + n;
+                n++;
+            }
+
+            int pushed = IntMpmcQueuePushN(context->queue, n, batch);
+            if (pushed == 0)
+                sched_yield();
+
+            i += pushed;
+        }
+    }
+
+    return NULL;
+}
+
+static void* mpmcConsumer(void* arg)
+{
+    MpmcContext* context = (MpmcContext*)arg;
+    int values[5];
+
+    while (atomic_load(context->popped) < context->total)
+    {
+        int n = IntMpmcQueuePopN(context->queue, 5, values);
+        if (n == 0)
+        {
+            sched_yield();
+            continue;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            atomic_fetch_add(&context->seen[values[i]], 1);
+            atomic_fetch_add(context->sum, values[i]);
+        }
+
+        atomic_fetch_add(context->popped, n);
+    }
+
+    return NULL;
+}
+
+void test_spsc_queue_is_bounded_and_fifo(void)
+{
+    IntSpscQueue queue;
+    IntSpscQueueInit(&queue, (IntSpscQueueOptions){ .capacity = 5 });
+
+    TEST_ASSERT_EQUAL_INT(8, queue.capacity);
+
+    int value = -1;
+    TEST_ASSERT_FALSE(IntSpscQueuePop(&queue, &value));
+
+    for (int i = 0; i < 8; i++)
+    {
+        TEST_ASSERT_TRUE(IntSpscQueuePush(&queue, i));
+    }
+
+    TEST_ASSERT_FALSE(IntSpscQueuePush(&queue, 8));
+    TEST_ASSERT_EQUAL_INT(8, IntSpscQueueCount(&queue));
+
+    for (int i = 0; i < 8; i++)
+    {
+        TEST_ASSERT_TRUE(IntSpscQueuePop(&queue, &value));
+        TEST_ASSERT_EQUAL_INT(i, value);
+    }
+
+    TEST_ASSERT_FALSE(IntSpscQueuePop(&queue, &value));
+    IntSpscQueueFree(&queue);
+}
+
+void test_spsc_queue_push_n_and_pop_n_wrap_around(void)
+{
+    const int values[] = { 1, 2, 3, 4, 5, 6 };
+    int out[8] = {0};
+    IntSpscQueue queue;
+    IntSpscQueueInit(&queue, (IntSpscQueueOptions){ .capacity = 8 });
+
+    TEST_ASSERT_EQUAL_INT(6, IntSpscQueuePushN(&queue, 6, (int*)values));
+    TEST_ASSERT_EQUAL_INT(4, IntSpscQueuePopN(&queue, 4, out));
+    TEST_ASSERT_EQUAL_INT(6, IntSpscQueuePushN(&queue, 6, (int*)values));
+    TEST_ASSERT_EQUAL_INT(0, IntSpscQueuePushN(&queue, 6, (int*)values));
+
+    TEST_ASSERT_EQUAL_INT(8, IntSpscQueuePopN(&queue, 8, out));
+    TEST_ASSERT_EQUAL_INT(5, out[0]);
+    TEST_ASSERT_EQUAL_INT(6, out[1]);
+    TEST_ASSERT_EQUAL_INT(1, out[2]);
+    TEST_ASSERT_EQUAL_INT(6, out[7]);
+    TEST_ASSERT_EQUAL_INT(0, IntSpscQueuePopN(&queue, 8, out));
+
+    IntSpscQueueFree(&queue);
+}
+
+void test_spsc_queue_threaded_transfer_keeps_order(void)
+{
+    IntSpscQueue queue;
+    IntSpscQueueInit(&queue, (IntSpscQueueOptions){ .capacity = 64 });
+
+    SpscContext context = { &queue, SHL_TEST_STRESS_COUNT * 4 };
+    pthread_t producer;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&producer, NULL, spscProducer, &context));
+
+    int expected = 0;
+    int values[11];
+    while (expected < context.count)
+    {
+        int n = (expected & 1) ? IntSpscQueuePopN(&queue, 11, values) : IntSpscQueuePop(&queue, values);
+        if (n == 0)
+        {
+            sched_yield();
+            continue;
+        }
+
+        for (int i = 0; i < n; i++)
+        {
+            TEST_ASSERT_EQUAL_INT(expected++, values[i]);
+        }
+    }
+
+    pthread_join(producer, NULL);
+    IntSpscQueueFree(&queue);
+}
+
+void test_mpmc_queue_is_bounded_and_fifo(void)
+{
+    const int values[] = { 10, 11, 12 };
+    int out[4] = {0};
+    IntMpmcQueue queue;
+    IntMpmcQueueInit(&queue, (IntMpmcQueueOptions){ .capacity = 4 });
+
+    int value = -1;
+    TEST_ASSERT_FALSE(IntMpmcQueuePop(&queue, &value));
+    TEST_ASSERT_TRUE(IntMpmcQueuePush(&queue, 9));
+    TEST_ASSERT_EQUAL_INT(3, IntMpmcQueuePushN(&queue, 3, (int*)values));
+    TEST_ASSERT_FALSE(IntMpmcQueuePush(&queue, 13));
+    TEST_ASSERT_EQUAL_INT(0, IntMpmcQueuePushN(&queue, 3, (int*)values));
+    TEST_ASSERT_EQUAL_INT(4, IntMpmcQueueCount(&queue));
+
+    TEST_ASSERT_TRUE(IntMpmcQueuePop(&queue, &value));
+    TEST_ASSERT_EQUAL_INT(9, value);
+    TEST_ASSERT_EQUAL_INT(1, IntMpmcQueuePushN(&queue, 3, (int*)values));
+    TEST_ASSERT_EQUAL_INT(0, IntMpmcQueuePushN(&queue, 3, (int*)values));
+
+    TEST_ASSERT_EQUAL_INT(4, IntMpmcQueuePopN(&queue, 4, out));
+    TEST_ASSERT_EQUAL_INT(10, out[0]);
+    TEST_ASSERT_EQUAL_INT(12, out[2]);
+    TEST_ASSERT_EQUAL_INT(10, out[3]);
+    TEST_ASSERT_EQUAL_INT(0, IntMpmcQueuePopN(&queue, 4, out));
+
+    IntMpmcQueueFree(&queue);
+}
+
+void test_mpmc_queue_threaded_transfer_delivers_every_item_once(void)
+{
+    enum { PER_PRODUCER = SHL_TEST_STRESS_COUNT };
+    const int total = PRODUCER_COUNT * PER_PRODUCER;
+    IntMpmcQueue queue;
+    IntMpmcQueueInit(&queue, (IntMpmcQueueOptions){ .capacity = 128 });
+
+    atomic_int* seen = (atomic_int*)malloc((size_t)total * sizeof(atomic_int));
+    TEST_ASSERT_NOT_NULL(seen);
+    for (int i = 0; i < total; i++)
+    {
+        atomic_init(&seen[i], 0);
+    }
+
+    atomic_llong sum;
+    atomic_int popped;
+    atomic_init(&sum, 0);
+    atomic_init(&popped, 0);
+
+    MpmcContext contexts[PRODUCER_COUNT];
+    pthread_t producers[PRODUCER_COUNT];
+    pthread_t consumers[CONSUMER_COUNT];
+
+    for (int i = 0; i < PRODUCER_COUNT; i++)
+    {
+        contexts[i] = (MpmcContext){ &queue, i * PER_PRODUCER, PER_PRODUCER, seen, &sum, &popped, total };
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&producers[i], NULL, mpmcProducer, &contexts[i]));
+    }
+
+    for (int i = 0; i < CONSUMER_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&consumers[i], NULL, mpmcConsumer, &contexts[0]));
+    }
+
+    for (int i = 0; i < PRODUCER_COUNT; i++)
+    {
+        pthread_join(producers[i], NULL);
+    }
+
+    for (int i = 0; i < CONSUMER_COUNT; i++)
+    {
+        pthread_join(consumers[i], NULL);
+    }
+
+    TEST_ASSERT_EQUAL_INT(total, atomic_load(&popped));
+    TEST_ASSERT_EQUAL_INT64((long long)total * (total - 1) / 2, atomic_load(&sum));
+    for (int i = 0; i < total; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(1, atomic_load(&seen[i]));
+    }
+
+    free(seen);
+    IntMpmcQueueFree(&queue);
+}
+
+void test_mpmc_queue_free_releases_queued_items(void)
+{
+    PtrMpmcQueue queue;
+    PtrMpmcQueueInit(&queue, (PtrMpmcQueueOptions){ .capacity = 16, .freeFn = trackedFree });
+
+    for (int i = 0; i < 5; i++)
+    {
+        int* value = (int*)malloc(sizeof(int));
+        TEST_ASSERT_NOT_NULL(value);
+        *value = i;
+        TEST_ASSERT_TRUE(PtrMpmcQueuePush(&queue, value));
+    }
+
+    int* value = NULL;
+    TEST_ASSERT_TRUE(PtrMpmcQueuePop(&queue, &value));
+    TEST_ASSERT_EQUAL_INT(0, *value);
+    free(value);
+
+    PtrMpmcQueueFree(&queue);
+    TEST_ASSERT_EQUAL_INT(4, g_freeCount);
+}
+
+void setUp(void)
+{
+    g_freeCount = 0;
+}
+
+void tearDown(void)
+{
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_spsc_queue_is_bounded_and_fifo);
+    RUN_TEST(test_spsc_queue_push_n_and_pop_n_wrap_around);
+    RUN_TEST(test_spsc_queue_threaded_transfer_keeps_order);
+    RUN_TEST(test_mpmc_queue_is_bounded_and_fifo);
+    RUN_TEST(test_mpmc_queue_threaded_transfer_delivers_every_item_once);
+    RUN_TEST(test_mpmc_queue_free_releases_queued_items);
+    return UNITY_END();
+}
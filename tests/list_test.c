@@ -1,6 +1,8 @@
 #include <stdlib.h>
 #include <string.h>
 
+#define SHL_MEMORY_BUFFER_IMPLEMENTATION
+#include "../memory_buffer.h"
 #include "../list.h"
 #include "test_common.h"
 
@@ -44,6 +46,14 @@ shlDeclareList(IntList, int)
 shlDefineList(IntList, int)
 shlDeclareList(EntryList, Entry*)
 shlDefineList(EntryList, Entry*)
+shlDeclareSmallList(IntSmallList, int, 4)
+shlDefineSmallList(IntSmallList, int)
+shlDeclareListSerialization(IntList, int)
+shlDefineListSerialization(IntList, int)
+shlDeclareListSerialization(IntSmallList, int)
+shlDefineListSerialization(IntSmallList, int)
+shlDeclareSmallList(EntrySmallList, Entry*, 2)
+shlDefineSmallList(EntrySmallList, Entry*)
 
 static int g_entryFreeCount = 0;
 
@@ -53,6 +63,17 @@ static void trackedEntryFree(Entry* entry)
     free(entry);
 }
 
+static bool isOdd(const int x, void* userData)
+{
+    (void)userData;
+    return (x & 1) != 0;
+}
+
+static bool entryIndexBelow(const Entry* entry, void* userData)
+{
+    return entry->index < *(int*)userData;
+}
+
 static Entry* makeEntry(int index, const char* name)
 {
     Entry* entry = (Entry*)malloc(sizeof(Entry));
@@ -179,6 +200,408 @@ void test_int_list_stress_insert_range_and_remove_range(void)
     IntListFree(&list);
 }
 
+void test_int_list_remove_at_swap_back_moves_last_item(void)
+{
+    const int values[] = { 1, 2, 3, 4, 5 };
+    IntList list;
+    IntListInit(&list, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    IntListAddRange(&list, 5, (int*)values);
+    IntListRemoveAtSwapBack(&list, 1);
+    TEST_ASSERT_EQUAL_INT(4, list.count);
+    TEST_ASSERT_EQUAL_INT(5, IntListGet(&list, 1));
+
+    IntListRemoveAtSwapBack(&list, 3);
+    TEST_ASSERT_EQUAL_INT(3, list.count);
+    TEST_ASSERT_EQUAL_INT(1, IntListGet(&list, 0));
+    TEST_ASSERT_EQUAL_INT(5, IntListGet(&list, 1));
+    TEST_ASSERT_EQUAL_INT(3, IntListGet(&list, 2));
+
+    IntListRemoveAtSwapBack(&list, 3);
+    IntListRemoveAtSwapBack(&list, -1);
+    TEST_ASSERT_EQUAL_INT(3, list.count);
+
+    IntListFree(&list);
+}
+
+void test_int_list_remove_if_compacts_preserving_order(void)
+{
+    IntList list;
+    IntListInit(&list, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    for (int i = 0; i < SHL_TEST_STRESS_COUNT; i++)
+    {
+        IntListAdd(&list, i);
+    }
+
+    int32_t removed = IntListRemoveIf(&list, isOdd, NULL);
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_STRESS_COUNT / 2, removed);
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_STRESS_COUNT / 2, list.count);
+
+    for (int i = 0; i < list.count; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i * 2, list.items[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, IntListRemoveIf(&list, isOdd, NULL));
+    IntListFree(&list);
+}
+
+void test_entry_list_swap_back_and_remove_if_call_free_function(void)
+{
+    int threshold = 5;
+    EntryList list;
+    EntryListInit(&list, (EntryListOptions){ .defaultValue = NULL, .equalsFn = entryEquals, .freeFn = trackedEntryFree });
+
+    for (int i = 0; i < 10; i++)
+    {
+        EntryListAdd(&list, makeEntry(i, "entry"));
+    }
+
+    EntryListRemoveAtSwapBack(&list, 0);
+    TEST_ASSERT_EQUAL_INT(1, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(9, list.items[0]->index);
+
+    TEST_ASSERT_EQUAL_INT(4, EntryListRemoveIf(&list, entryIndexBelow, &threshold));
+    TEST_ASSERT_EQUAL_INT(5, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(5, list.count);
+    TEST_ASSERT_EQUAL_INT(9, list.items[0]->index);
+    TEST_ASSERT_EQUAL_INT(5, list.items[1]->index);
+
+    EntryListFree(&list);
+    TEST_ASSERT_EQUAL_INT(10, g_entryFreeCount);
+}
+
+void test_small_list_stores_items_inline_until_full(void)
+{
+    IntSmallList list;
+    IntSmallListInit(&list, (IntSmallListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    TEST_ASSERT_EQUAL_PTR(list.inlineItems, list.items);
+    TEST_ASSERT_EQUAL_INT(4, list.capacity);
+
+    for (int i = 0; i < 4; i++)
+    {
+        IntSmallListAdd(&list, i);
+    }
+
+    TEST_ASSERT_EQUAL_PTR(list.inlineItems, list.items);
+    TEST_ASSERT_EQUAL_INT(4, list.count);
+    TEST_ASSERT_TRUE(IntSmallListContains(&list, 3));
+
+    IntSmallListRemoveAt(&list, 0);
+    IntSmallListInsert(&list, 0, 10);
+    TEST_ASSERT_EQUAL_PTR(list.inlineItems, list.items);
+    TEST_ASSERT_EQUAL_INT(10, IntSmallListGet(&list, 0));
+
+    IntSmallListFree(&list);
+    TEST_ASSERT_NULL(list.items);
+}
+
+void test_small_list_spills_to_heap_and_keeps_items(void)
+{
+    IntSmallList list;
+    IntSmallListInit(&list, (IntSmallListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    for (int i = 0; i < SHL_TEST_MEDIUM_COUNT; i++)
+    {
+        IntSmallListAdd(&list, i);
+    }
+
+    TEST_ASSERT_TRUE(list.items != list.inlineItems);
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_MEDIUM_COUNT, list.count);
+
+    for (int i = 0; i < list.count; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntSmallListGet(&list, i));
+    }
+
+    IntSmallListSort(&list, intCompare);
+    IntSmallListFree(&list);
+}
+
+void test_small_entry_list_frees_items_inline_and_spilled(void)
+{
+    EntrySmallList list;
+    EntrySmallListInit(&list, (EntrySmallListOptions){ .defaultValue = NULL, .equalsFn = entryEquals, .freeFn = trackedEntryFree });
+
+    EntrySmallListAdd(&list, makeEntry(1, "one"));
+    EntrySmallListAdd(&list, makeEntry(2, "two"));
+    TEST_ASSERT_EQUAL_PTR(list.inlineItems, list.items);
+
+    EntrySmallListAdd(&list, makeEntry(3, "three"));
+    TEST_ASSERT_TRUE(list.items != list.inlineItems);
+    TEST_ASSERT_EQUAL_INT(1, list.items[0]->index);
+    TEST_ASSERT_EQUAL_INT(3, list.items[2]->index);
+
+    EntrySmallListFree(&list);
+    TEST_ASSERT_EQUAL_INT(3, g_entryFreeCount);
+}
+
+void test_int_list_reserve_and_shrink_to_fit_adjust_capacity(void)
+{
+    IntList list;
+    IntListInit(&list, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals, .growthFactor = 1.5f });
+
+    IntListReserve(&list, SHL_TEST_MEDIUM_COUNT);
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_MEDIUM_COUNT, list.capacity);
+
+    int* items = list.items;
+    for (int i = 0; i < SHL_TEST_MEDIUM_COUNT; i++)
+    {
+        IntListAdd(&list, i);
+    }
+
+    TEST_ASSERT_EQUAL_PTR(items, list.items);
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_MEDIUM_COUNT, list.capacity);
+
+    IntListAdd(&list, SHL_TEST_MEDIUM_COUNT);
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_MEDIUM_COUNT + SHL_TEST_MEDIUM_COUNT / 2, list.capacity);
+
+    IntListRemoveAtRange(&list, 10, list.count - 10);
+    IntListShrinkToFit(&list);
+    TEST_ASSERT_EQUAL_INT(10, list.capacity);
+    TEST_ASSERT_EQUAL_INT(9, IntListGet(&list, 9));
+
+    IntListClear(&list);
+    IntListShrinkToFit(&list);
+    TEST_ASSERT_EQUAL_INT(1, list.capacity);
+    IntListAdd(&list, 7);
+    IntListAdd(&list, 8);
+    TEST_ASSERT_EQUAL_INT(8, IntListGet(&list, 1));
+
+    IntListFree(&list);
+}
+
+void test_small_list_shrink_to_fit_moves_items_back_inline(void)
+{
+    IntSmallList list;
+    IntSmallListInit(&list, (IntSmallListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    IntSmallListReserve(&list, 64);
+    TEST_ASSERT_TRUE(list.items != list.inlineItems);
+    TEST_ASSERT_EQUAL_INT(64, list.capacity);
+
+    for (int i = 0; i < 6; i++)
+    {
+        IntSmallListAdd(&list, i);
+    }
+
+    IntSmallListShrinkToFit(&list);
+    TEST_ASSERT_EQUAL_INT(6, list.capacity);
+
+    IntSmallListRemoveAtRange(&list, 0, 3);
+    IntSmallListShrinkToFit(&list);
+    TEST_ASSERT_EQUAL_PTR(list.inlineItems, list.items);
+    TEST_ASSERT_EQUAL_INT(4, list.capacity);
+    TEST_ASSERT_EQUAL_INT(3, IntSmallListGet(&list, 0));
+    TEST_ASSERT_EQUAL_INT(5, IntSmallListGet(&list, 2));
+
+    IntSmallListFree(&list);
+}
+
+void test_int_list_write_to_and_read_from_round_trip(void)
+{
+    memory_buffer_t buffer;
+    IntList source;
+    IntList target;
+    mb_initEmpty(&buffer);
+    IntListInit(&source, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+    IntListInit(&target, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    for (int i = 0; i < SHL_TEST_MEDIUM_COUNT; i++)
+    {
+        IntListAdd(&source, i * 7);
+    }
+
+    TEST_ASSERT_TRUE(IntListWriteTo(&source, &buffer));
+    TEST_ASSERT_EQUAL_UINT32(8 + SHL_TEST_MEDIUM_COUNT * sizeof(int), buffer.length);
+
+    IntListAdd(&target, 99);
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+    TEST_ASSERT_TRUE(IntListReadFrom(&target, &buffer));
+    TEST_ASSERT_TRUE(mb_isEOF(&buffer));
+    TEST_ASSERT_EQUAL_INT(SHL_TEST_MEDIUM_COUNT, target.count);
+    TEST_ASSERT_EQUAL_INT_ARRAY(source.items, target.items, SHL_TEST_MEDIUM_COUNT);
+
+    TEST_ASSERT_FALSE(IntListReadFrom(&target, &buffer));
+
+    IntListFree(&source);
+    IntListFree(&target);
+    mb_free(&buffer);
+}
+
+void test_int_list_read_from_rejects_mismatched_or_truncated_data(void)
+{
+    memory_buffer_t buffer;
+    IntList list;
+    mb_initEmpty(&buffer);
+    IntListInit(&list, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    mb_writeUInt32LE(&buffer, 2);
+    mb_writeUInt32LE(&buffer, 1);
+    mb_writeUInt16LE(&buffer, 7);
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+    TEST_ASSERT_FALSE(IntListReadFrom(&list, &buffer));
+    TEST_ASSERT_EQUAL_INT(0, mb_position(&buffer));
+
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+    mb_writeUInt32LE(&buffer, sizeof(int));
+    mb_writeUInt32LE(&buffer, 3);
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+    IntListAdd(&list, 5);
+    TEST_ASSERT_FALSE(IntListReadFrom(&list, &buffer));
+    TEST_ASSERT_EQUAL_INT(0, mb_position(&buffer));
+    TEST_ASSERT_EQUAL_INT(1, list.count);
+
+    IntListFree(&list);
+    mb_free(&buffer);
+}
+
+void test_int_list_attach_view_reads_buffer_without_copying(void)
+{
+    memory_buffer_t buffer;
+    IntList source;
+    IntList view;
+    const int values[] = { 4, 8, 15, 16, 23, 42 };
+    mb_initEmpty(&buffer);
+    IntListInit(&source, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    IntListAddRange(&source, 6, (int*)values);
+    TEST_ASSERT_TRUE(IntListWriteTo(&source, &buffer));
+    IntListFree(&source);
+
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+    TEST_ASSERT_TRUE(IntListAttachView(&view, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals }, &buffer));
+    TEST_ASSERT_EQUAL_PTR(buffer.data + 8, view.items);
+    TEST_ASSERT_EQUAL_INT(6, view.count);
+    TEST_ASSERT_EQUAL_INT(0, view.capacity);
+    TEST_ASSERT_EQUAL_INT(3, IntListIndexOf(&view, 16));
+    IntListFree(&view);
+
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+    TEST_ASSERT_TRUE(IntListAttachView(&view, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals }, &buffer));
+    IntListAdd(&view, 108);
+    TEST_ASSERT_TRUE(view.items != (int*)(buffer.data + 8));
+    TEST_ASSERT_TRUE(view.capacity >= 7);
+    TEST_ASSERT_EQUAL_INT(42, IntListGet(&view, 5));
+    TEST_ASSERT_EQUAL_INT(108, IntListGet(&view, 6));
+    IntListFree(&view);
+
+    mb_free(&buffer);
+}
+
+void test_int_list_mutating_a_view_never_writes_the_buffer(void)
+{
+    enum { OPERATION_COUNT = 8 };
+    memory_buffer_t buffer;
+    IntList source;
+    IntList view;
+    const int values[] = { 42, 7, 16, 3, 23, 8 };
+    uint8_t original[64];
+    mb_initEmpty(&buffer);
+    IntListInit(&source, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    IntListAddRange(&source, 6, (int*)values);
+    TEST_ASSERT_TRUE(IntListWriteTo(&source, &buffer));
+    IntListFree(&source);
+
+    size_t length = buffer.length;
+    TEST_ASSERT_TRUE(length <= sizeof(original));
+    memcpy(original, buffer.data, length);
+
+    for (int operation = 0; operation < OPERATION_COUNT; operation++)
+    {
+        TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+        TEST_ASSERT_TRUE(IntListAttachView(&view, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals }, &buffer));
+
+        switch (operation)
+        {
+            case 0: IntListSet(&view, 0, 99); break;
+            case 1: IntListSort(&view, intCompare); break;
+            case 2: IntListRemove(&view, 16); break;
+            case 3: IntListRemoveAt(&view, 0); break;
+            case 4: IntListRemoveAtSwapBack(&view, 1); break;
+            case 5: IntListRemoveIf(&view, isOdd, NULL); break;
+            case 6: IntListReverse(&view); break;
+            default: IntListClear(&view); IntListAdd(&view, 5); break;
+        }
+
+        TEST_ASSERT_TRUE(view.items != (int*)(buffer.data + 8));
+        TEST_ASSERT_TRUE(view.capacity >= view.count);
+        TEST_ASSERT_EQUAL_MEMORY(original, buffer.data, length);
+        IntListFree(&view);
+    }
+
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+    TEST_ASSERT_TRUE(IntListAttachView(&view, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals }, &buffer));
+    IntListSort(&view, intCompare);
+    TEST_ASSERT_EQUAL_INT(3, IntListGet(&view, 0));
+    TEST_ASSERT_EQUAL_INT(42, IntListGet(&view, 5));
+    IntListFree(&view);
+
+    mb_free(&buffer);
+}
+
+void test_int_list_attach_view_failure_rewinds_to_header(void)
+{
+    memory_buffer_t buffer;
+    IntList source;
+    IntList view;
+    const int values[] = { 1, 2, 3 };
+    mb_initEmpty(&buffer);
+    IntListInit(&source, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    IntListAddRange(&source, 3, (int*)values);
+    TEST_ASSERT_TRUE(mb_write(&buffer, 0));
+    TEST_ASSERT_TRUE(IntListWriteTo(&source, &buffer));
+    IntListFree(&source);
+
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 1));
+    TEST_ASSERT_FALSE(IntListAttachView(&view, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals }, &buffer));
+    TEST_ASSERT_EQUAL_INT(1, (int)mb_position(&buffer));
+
+    IntListInit(&view, (IntListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+    buffer.length -= 4;
+    TEST_ASSERT_FALSE(IntListReadFrom(&view, &buffer));
+    TEST_ASSERT_EQUAL_INT(1, (int)mb_position(&buffer));
+    TEST_ASSERT_EQUAL_INT(0, view.count);
+
+    IntListFree(&view);
+    mb_free(&buffer);
+}
+
+void test_small_list_serialization_round_trip_and_view(void)
+{
+    memory_buffer_t buffer;
+    IntSmallList list;
+    IntSmallList view;
+    mb_initEmpty(&buffer);
+    IntSmallListInit(&list, (IntSmallListOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    IntSmallListAdd(&list, 1);
+    IntSmallListAdd(&list, 2);
+    TEST_ASSERT_TRUE(IntSmallListWriteTo(&list, &buffer));
+    IntSmallListClear(&list);
+
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+    TEST_ASSERT_TRUE(IntSmallListReadFrom(&list, &buffer));
+    TEST_ASSERT_EQUAL_PTR(list.inlineItems, list.items);
+    TEST_ASSERT_EQUAL_INT(2, IntSmallListGet(&list, 1));
+
+    TEST_ASSERT_TRUE(mb_seek(&buffer, 0));
+    TEST_ASSERT_TRUE(IntSmallListAttachView(&view, (IntSmallListOptions){ .defaultValue = -1 }, &buffer));
+    IntSmallListShrinkToFit(&view);
+    TEST_ASSERT_EQUAL_PTR(buffer.data + 8, view.items);
+    IntSmallListReserve(&view, 16);
+    TEST_ASSERT_EQUAL_INT(16, view.capacity);
+    TEST_ASSERT_EQUAL_INT(1, IntSmallListGet(&view, 0));
+
+    IntSmallListFree(&view);
+    IntSmallListFree(&list);
+    mb_free(&buffer);
+}
+
 void test_entry_list_set_releases_replaced_item(void)
 {
     EntryList list;
@@ -255,6 +678,20 @@ int main(void)
     RUN_TEST(test_int_list_range_operations_copy_and_reverse);
     RUN_TEST(test_int_list_sort_orders_values_ascending);
     RUN_TEST(test_int_list_stress_insert_range_and_remove_range);
+    RUN_TEST(test_int_list_remove_at_swap_back_moves_last_item);
+    RUN_TEST(test_int_list_remove_if_compacts_preserving_order);
+    RUN_TEST(test_entry_list_swap_back_and_remove_if_call_free_function);
+    RUN_TEST(test_small_list_stores_items_inline_until_full);
+    RUN_TEST(test_small_list_spills_to_heap_and_keeps_items);
+    RUN_TEST(test_small_entry_list_frees_items_inline_and_spilled);
+    RUN_TEST(test_int_list_reserve_and_shrink_to_fit_adjust_capacity);
+    RUN_TEST(test_small_list_shrink_to_fit_moves_items_back_inline);
+    RUN_TEST(test_int_list_write_to_and_read_from_round_trip);
+    RUN_TEST(test_int_list_read_from_rejects_mismatched_or_truncated_data);
+    RUN_TEST(test_int_list_attach_view_reads_buffer_without_copying);
+    RUN_TEST(test_int_list_mutating_a_view_never_writes_the_buffer);
+    RUN_TEST(test_int_list_attach_view_failure_rewinds_to_header);
+    RUN_TEST(test_small_list_serialization_round_trip_and_view);
     RUN_TEST(test_entry_list_set_releases_replaced_item);
     RUN_TEST(test_entry_list_remove_range_and_clear_call_free_function);
     RUN_TEST(test_entry_list_integration_sorts_remaining_entries_after_mutations);
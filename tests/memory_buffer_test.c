@@ -159,6 +159,27 @@ void mb_ScanToTest(void)
     free(data);
 }
 
+void mb_readViewTest(void)
+{
+    size_t length = 0;
+    uint8_t* data = make_test_buffer(&length);
+
+    memory_buffer_t buf = {0};
+    mb_initFromMemory(&buf, data, length);
+
+    TEST_ASSERT_TRUE(mb_seek(&buf, 91));
+
+    const uint8_t* view = NULL;
+    TEST_ASSERT_FALSE(mb_readView(&buf, &view, 10));
+    TEST_ASSERT_NULL(view);
+    TEST_ASSERT_TRUE(mb_readView(&buf, &view, 9));
+    TEST_ASSERT_EQUAL_PTR(data + 91, view);
+    TEST_ASSERT_EQUAL_MEMORY(END_BLOCK_STR, view, 9);
+    TEST_ASSERT_TRUE(mb_isEOF(&buf));
+
+    free(data);
+}
+
 /* ------------------------------------------------------------------ */
 /* Seek tests                                                           */
 /* ------------------------------------------------------------------ */
@@ -380,6 +401,7 @@ int main(void)
     RUN_TEST(mb_readInt32LETest);
     RUN_TEST(mb_readInt32BETest);
     RUN_TEST(mb_ScanToTest);
+    RUN_TEST(mb_readViewTest);
     RUN_TEST(mb_SeekAndReadTest);
     RUN_TEST(mb_SeekWriteReadBackTest);
     RUN_TEST(mb_readWriteInt24LETest);
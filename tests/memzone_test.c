@@ -302,6 +302,97 @@ static void test_mz_free_unknown_pointer_reports_without_mutating_zone(void)
     mz_destroy(zone);
 }
 
+static void test_mz_free_rejects_double_free_and_interior_pointers(void)
+{
+    memzone_t* zone = createZoneOrFail(4096);
+    ReportCapture capture = {0};
+    uint8_t* a = (uint8_t*)mz_alloc(zone, 64);
+    uint8_t* b = (uint8_t*)mz_alloc(zone, 64);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    mz_setReporter(zone, captureReport, &capture);
+
+    mz_free(zone, a + mz_alignment());
+    TEST_ASSERT_EQUAL_INT32(1, capture.count);
+    TEST_ASSERT_EQUAL_INT32(MZ_REPORT_INVALID_FREE, capture.lastReport);
+    TEST_ASSERT_EQUAL_PTR(a + mz_alignment(), capture.lastContext);
+    TEST_ASSERT_TRUE(mz_contains(zone, a));
+
+    mz_free(zone, a);
+    TEST_ASSERT_EQUAL_INT32(1, capture.count);
+    size_t usedBefore = mz_usedSize(zone);
+
+    mz_free(zone, a);
+    TEST_ASSERT_EQUAL_INT32(2, capture.count);
+    TEST_ASSERT_EQUAL_INT32(MZ_REPORT_INVALID_FREE, capture.lastReport);
+    TEST_ASSERT_EQUAL_size_t(usedBefore, mz_usedSize(zone));
+    TEST_ASSERT_TRUE(mz_contains(zone, b));
+    assertZoneInvariants(zone);
+
+    mz_free(zone, b);
+    mz_free(zone, b);
+    TEST_ASSERT_EQUAL_INT32(3, capture.count);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    assertZoneInvariants(zone);
+
+    mz_destroy(zone);
+}
+
+static void test_mz_free_rejects_pointers_from_before_reset(void)
+{
+    memzone_t* zone = createZoneOrFail(4096);
+    ReportCapture capture = {0};
+    void* a = mz_alloc(zone, 64);
+    void* b = mz_allocAligned(zone, 64, 64);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(b);
+    mz_setReporter(zone, captureReport, &capture);
+
+    mz_reset(zone);
+
+    mz_free(zone, a);
+    mz_free(zone, b);
+    TEST_ASSERT_EQUAL_INT32(2, capture.count);
+    TEST_ASSERT_EQUAL_INT32(MZ_REPORT_INVALID_FREE, capture.lastReport);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    assertZoneInvariants(zone);
+
+    mz_destroy(zone);
+}
+
+static void test_mz_lookup_finds_padded_aligned_allocations(void)
+{
+    memzone_t* zone = createZoneOrFail(8192);
+    void* allocations[16] = {0};
+
+    for (size_t i = 0; i < ARRAY_LEN(allocations); i++)
+    {
+        allocations[i] = i % 2 == 0 ? mz_alloc(zone, 8 + i * 8) : mz_allocAligned(zone, 24, 64);
+        TEST_ASSERT_NOT_NULL(allocations[i]);
+        TEST_ASSERT_TRUE(mz_contains(zone, allocations[i]));
+    }
+
+    assertZoneInvariants(zone);
+
+    for (size_t i = 1; i < ARRAY_LEN(allocations); i += 2)
+    {
+        TEST_ASSERT_EQUAL_UINT64(0, (unsigned long long)((uintptr_t)allocations[i] % 64));
+        TEST_ASSERT_TRUE(mz_allocationSize(zone, allocations[i]) >= alignUp(24));
+        mz_free(zone, allocations[i]);
+        TEST_ASSERT_FALSE(mz_contains(zone, allocations[i]));
+        assertZoneInvariants(zone);
+    }
+
+    for (size_t i = 0; i < ARRAY_LEN(allocations); i += 2)
+    {
+        mz_free(zone, allocations[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    assertZoneInvariants(zone);
+    mz_destroy(zone);
+}
+
 static void test_mz_free_coalesces_adjacent_free_blocks(void)
 {
     memzone_t* zone = createZoneOrFail(4096);
@@ -494,6 +585,110 @@ static void test_mz_validate_reports_adjacent_free_blocks(void)
     mz_destroy(zone);
 }
 
+static void test_mz_alloc_takes_free_block_of_matching_size_class(void)
+{
+    memzone_t* zone = createZoneOrFail(8192);
+    void* a = mz_alloc(zone, 64);
+    void* largeHole = mz_alloc(zone, 1024);
+    void* b = mz_alloc(zone, 64);
+    void* smallHole = mz_alloc(zone, 64);
+    void* c = mz_alloc(zone, 64);
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(largeHole);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_NOT_NULL(smallHole);
+    TEST_ASSERT_NOT_NULL(c);
+
+    mz_free(zone, largeHole);
+    mz_free(zone, smallHole);
+    assertZoneInvariants(zone);
+
+    void* p = mz_alloc(zone, 64);
+    TEST_ASSERT_EQUAL_PTR(smallHole, p);
+    assertZoneInvariants(zone);
+
+    void* q = mz_alloc(zone, 512);
+    TEST_ASSERT_EQUAL_PTR(largeHole, q);
+    TEST_ASSERT_EQUAL_INT32(7, mz_blockCount(zone));
+    assertZoneInvariants(zone);
+
+    mz_destroy(zone);
+}
+
+static void test_mz_alloc_finds_exact_fit_when_no_larger_class_is_free(void)
+{
+    memzone_t* zone = createZoneOrFail(4096);
+    void* a = mz_alloc(zone, 200);
+    void* hole = mz_alloc(zone, 200);
+    void* b = mz_alloc(zone, mz_usableFreeSize(zone) - mz_alignment());
+    TEST_ASSERT_NOT_NULL(a);
+    TEST_ASSERT_NOT_NULL(hole);
+    TEST_ASSERT_NOT_NULL(b);
+    TEST_ASSERT_EQUAL_size_t(0, mz_usableFreeSize(zone));
+
+    mz_free(zone, hole);
+
+    void* p = mz_alloc(zone, 200);
+    TEST_ASSERT_EQUAL_PTR(hole, p);
+    TEST_ASSERT_EQUAL_size_t(0, mz_usableFreeSize(zone));
+    assertZoneInvariants(zone);
+
+    mz_destroy(zone);
+}
+
+static void test_mz_validate_reports_free_block_missing_from_free_lists(void)
+{
+    memzone_t* zone = createZoneOrFail(4096);
+    ReportCapture capture = {0};
+    void* p = mz_alloc(zone, 64);
+    TEST_ASSERT_NOT_NULL(p);
+    mz_setReporter(zone, captureReport, &capture);
+
+    memblock_t* tail = zone->blockList.next;
+    TEST_ASSERT_NULL(tail->user);
+    zone->freeLists[0][0] = tail;
+    zone->freeClasses[0] |= 1;
+    zone->freeLevels |= 1;
+
+    TEST_ASSERT_FALSE(mz_validate(zone));
+    TEST_ASSERT_EQUAL_INT32(1, capture.count);
+    TEST_ASSERT_EQUAL_INT32(MZ_REPORT_VALIDATION_FAILURE, capture.lastReport);
+    TEST_ASSERT_NOT_NULL(capture.lastMessage);
+
+    mz_destroy(zone);
+}
+
+static void test_mz_validate_reports_corrupted_block_check_word(void)
+{
+    memzone_t* zone = createZoneOrFail(4096);
+    ReportCapture capture = {0};
+    void* p = mz_alloc(zone, 64);
+    TEST_ASSERT_NOT_NULL(p);
+    mz_setReporter(zone, captureReport, &capture);
+
+    uintptr_t check;
+    memcpy(&check, (uint8_t*)p - sizeof(uintptr_t), sizeof(check));
+    uintptr_t corrupted = check ^ (uintptr_t)0xFF00;
+    memcpy((uint8_t*)p - sizeof(uintptr_t), &corrupted, sizeof(corrupted));
+
+    TEST_ASSERT_FALSE(mz_contains(zone, p));
+    TEST_ASSERT_FALSE(mz_validate(zone));
+    TEST_ASSERT_EQUAL_INT32(1, capture.count);
+    TEST_ASSERT_EQUAL_INT32(MZ_REPORT_VALIDATION_FAILURE, capture.lastReport);
+    TEST_ASSERT_EQUAL_PTR(&zone->blockList, capture.lastContext);
+
+    mz_free(zone, p);
+    TEST_ASSERT_EQUAL_INT32(2, capture.count);
+    TEST_ASSERT_EQUAL_INT32(MZ_REPORT_INVALID_FREE, capture.lastReport);
+
+    memcpy((uint8_t*)p - sizeof(uintptr_t), &check, sizeof(check));
+    TEST_ASSERT_TRUE(mz_contains(zone, p));
+    mz_free(zone, p);
+    assertZoneInvariants(zone);
+
+    mz_destroy(zone);
+}
+
 static void test_mz_large_allocation_stress_path(void)
 {
     size_t zoneSize = 2 * 1024 * 1024;
@@ -1037,6 +1232,9 @@ int main(void)
     RUN_TEST(test_mz_allocationSize_and_contains_report_live_allocations_only);
     RUN_TEST(test_mz_accessors_report_zone_sizes);
     RUN_TEST(test_mz_free_unknown_pointer_reports_without_mutating_zone);
+    RUN_TEST(test_mz_free_rejects_double_free_and_interior_pointers);
+    RUN_TEST(test_mz_free_rejects_pointers_from_before_reset);
+    RUN_TEST(test_mz_lookup_finds_padded_aligned_allocations);
     RUN_TEST(test_mz_free_coalesces_adjacent_free_blocks);
     RUN_TEST(test_mz_alloc_does_not_create_undersized_tail_block);
     RUN_TEST(test_mz_alloc_returned_memory_is_zeroed);
@@ -1050,6 +1248,10 @@ int main(void)
     RUN_TEST(test_mz_validate_reports_corrupted_used_size);
     RUN_TEST(test_mz_validate_reports_gap_between_blocks);
     RUN_TEST(test_mz_validate_reports_adjacent_free_blocks);
+    RUN_TEST(test_mz_alloc_takes_free_block_of_matching_size_class);
+    RUN_TEST(test_mz_alloc_finds_exact_fit_when_no_larger_class_is_free);
+    RUN_TEST(test_mz_validate_reports_free_block_missing_from_free_lists);
+    RUN_TEST(test_mz_validate_reports_corrupted_block_check_word);
     RUN_TEST(test_mz_large_allocation_stress_path);
     RUN_TEST(test_mz_realloc_null_zone_returns_null);
     RUN_TEST(test_mz_realloc_null_pointer_behaves_like_alloc);
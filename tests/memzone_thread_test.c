@@ -0,0 +1,463 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define SHL_MZ_THREAD_SAFE
+#define SHL_MZ_IMPLEMENTATION
+#include "../memzone.h"
+#include "test_common.h"
+
+#define THREAD_COUNT 4
+#define SLOT_COUNT 256
+#define ZONE_SIZE (8 * 1024 * 1024)
+
+typedef struct
+{
+    int32_t count;
+    mz_report_t lastReport;
+    const void* lastContext;
+} ReportCapture;
+
+typedef struct
+{
+    memzone_t* zone;
+    _Atomic(uint8_t*)* slots;
+    uint32_t seed;
+    int32_t iterations;
+    atomic_int* failures;
+} StressContext;
+
+typedef struct
+{
+    memzone_t* zone;
+    void** pointers;
+    int32_t count;
+} FreeContext;
+
+static void captureReport(const memzone_t* zone, mz_report_t report, const void* context, const char* message, void* userData)
+{
+    (void)zone;
+    (void)message;
+    ReportCapture* capture = (ReportCapture*)userData;
+    capture->count++;
+    capture->lastReport = report;
+    capture->lastContext = context;
+}
+
+static void fillPattern(uint8_t* p, size_t size)
+{
+    memcpy(p, &size, sizeof(size_t));
+    memset(p + sizeof(size_t), (int)(size & 0xFF), size - sizeof(size_t));
+}
+
+static bool checkPattern(const uint8_t* p)
+{
+    size_t size;
+    memcpy(&size, p, sizeof(size_t));
+    if (size < sizeof(size_t) || size > 512)
+    {
+        return false;
+    }
+
+    for (size_t i = sizeof(size_t); i < size; i++)
+    {
+        if (p[i] != (uint8_t)(size & 0xFF))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static void* stressWorker(void* arg)
+{
+    StressContext* context = (StressContext*)arg;
+    uint32_t seed = context->seed;
+
+    for (int32_t i = 0; i < context->iterations; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int32_t slot = (int32_t)((seed >> 16) % SLOT_COUNT);
+        seed = seed * 1103515245u + 12345u;
+        size_t size = sizeof(size_t) + (seed >> 16) % 320;
+
+        uint8_t* p = (uint8_t*)mz_alloc(context->zone, size);
+        if (p == NULL)
+        {
+            atomic_fetch_add(context->failures, 1);
+            continue;
+        }
+
+        fillPattern(p, size);
+
+        uint8_t* old = atomic_exchange(&context->slots[slot], p);
+        if (old != NULL)
+        {
+            if (!checkPattern(old))
+            {
+                atomic_fetch_add(context->failures, 1);
+            }
+
+            mz_free(context->zone, old);
+        }
+    }
+
+    mz_threadFlush(context->zone);
+    return NULL;
+}
+
+static void* freeWorker(void* arg)
+{
+    FreeContext* context = (FreeContext*)arg;
+
+    for (int32_t i = 0; i < context->count; i++)
+    {
+        mz_free(context->zone, context->pointers[i]);
+    }
+
+    return NULL;
+}
+
+void test_mz_thread_cache_reuses_freed_block_zeroed(void)
+{
+    memzone_t* zone = mz_init(64 * 1024);
+    TEST_ASSERT_NOT_NULL(zone);
+
+    uint8_t* p = (uint8_t*)mz_alloc(zone, 24);
+    TEST_ASSERT_NOT_NULL(p);
+    TEST_ASSERT_TRUE(mz_contains(zone, p));
+    TEST_ASSERT_TRUE(mz_allocationSize(zone, p) >= 32);
+    memset(p, 0xAB, 32);
+
+    mz_free(zone, p);
+    TEST_ASSERT_FALSE(mz_contains(zone, p));
+    TEST_ASSERT_EQUAL_size_t(0, mz_allocationSize(zone, p));
+
+    uint8_t* q = (uint8_t*)mz_alloc(zone, 20);
+    TEST_ASSERT_EQUAL_PTR(p, q);
+    for (int32_t i = 0; i < 32; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(0, q[i]);
+    }
+
+    mz_free(zone, q);
+    TEST_ASSERT_TRUE(mz_validate(zone));
+    mz_threadFlush(zone);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    mz_destroy(zone);
+}
+
+void test_mz_thread_cache_reports_double_free(void)
+{
+    memzone_t* zone = mz_init(64 * 1024);
+    TEST_ASSERT_NOT_NULL(zone);
+
+    ReportCapture capture = {0};
+    mz_setReporter(zone, captureReport, &capture);
+
+    void* p = mz_alloc(zone, 48);
+    TEST_ASSERT_NOT_NULL(p);
+    mz_free(zone, p);
+    TEST_ASSERT_EQUAL_INT32(0, capture.count);
+
+    mz_free(zone, p);
+    TEST_ASSERT_EQUAL_INT32(1, capture.count);
+    TEST_ASSERT_EQUAL_INT32(MZ_REPORT_INVALID_FREE, capture.lastReport);
+    TEST_ASSERT_EQUAL_PTR(p, capture.lastContext);
+
+    TEST_ASSERT_NULL(mz_realloc(zone, p, 1000));
+    TEST_ASSERT_EQUAL_INT32(2, capture.count);
+
+    mz_threadFlush(zone);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    TEST_ASSERT_TRUE(mz_validate(zone));
+    mz_destroy(zone);
+}
+
+void test_mz_thread_flush_returns_cached_blocks(void)
+{
+    enum { COUNT = 100 };
+    memzone_t* zone = mz_init(64 * 1024);
+    TEST_ASSERT_NOT_NULL(zone);
+
+    size_t baseUsedSize = mz_usedSize(zone);
+    void* pointers[COUNT];
+
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        pointers[i] = mz_alloc(zone, (size_t)(8 << (i % 6)));
+        TEST_ASSERT_NOT_NULL(pointers[i]);
+    }
+
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        mz_free(zone, pointers[i]);
+    }
+
+    TEST_ASSERT_TRUE(mz_blockCount(zone) > 1);
+
+    mz_threadFlush(zone);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    TEST_ASSERT_EQUAL_size_t(baseUsedSize, mz_usedSize(zone));
+    TEST_ASSERT_TRUE(mz_validate(zone));
+    mz_destroy(zone);
+}
+
+void test_mz_thread_remote_frees_return_to_owner_cache(void)
+{
+    enum { COUNT = 16 };
+    memzone_t* zone = mz_init(64 * 1024);
+    TEST_ASSERT_NOT_NULL(zone);
+
+    void* pointers[COUNT];
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        pointers[i] = mz_alloc(zone, 64);
+        TEST_ASSERT_NOT_NULL(pointers[i]);
+    }
+
+    FreeContext context = { zone, pointers, COUNT };
+    pthread_t thread;
+    TEST_ASSERT_EQUAL_INT(0, pthread_create(&thread, NULL, freeWorker, &context));
+    pthread_join(thread, NULL);
+
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        TEST_ASSERT_FALSE(mz_contains(zone, pointers[i]));
+    }
+
+    void* p = mz_alloc(zone, 64);
+    bool reused = false;
+    for (int32_t i = 0; i < COUNT; i++)
+    {
+        reused = reused || p == pointers[i];
+    }
+
+    TEST_ASSERT_TRUE(reused);
+
+    mz_free(zone, p);
+    mz_threadFlush(zone);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    TEST_ASSERT_TRUE(mz_validate(zone));
+    mz_destroy(zone);
+}
+
+void test_mz_thread_stress_shared_slots(void)
+{
+    memzone_t* zone = mz_init(ZONE_SIZE);
+    TEST_ASSERT_NOT_NULL(zone);
+
+    _Atomic(uint8_t*) slots[SLOT_COUNT];
+    for (int32_t i = 0; i < SLOT_COUNT; i++)
+    {
+        atomic_init(&slots[i], NULL);
+    }
+
+    atomic_int failures;
+    atomic_init(&failures, 0);
+
+    StressContext contexts[THREAD_COUNT];
+    pthread_t threads[THREAD_COUNT];
+
+    for (int32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        contexts[i] = (StressContext){ zone, slots, 7919u * (uint32_t)(i + 1), SHL_TEST_STRESS_COUNT, &failures };
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, stressWorker, &contexts[i]));
+    }
+
+    for (int32_t i = 0; i < THREAD_COUNT; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, atomic_load(&failures));
+    TEST_ASSERT_TRUE(mz_validate(zone));
+
+    for (int32_t i = 0; i < SLOT_COUNT; i++)
+    {
+        uint8_t* p = atomic_load(&slots[i]);
+        if (p != NULL)
+        {
+            TEST_ASSERT_TRUE(checkPattern(p));
+            mz_free(zone, p);
+        }
+    }
+
+    mz_threadFlush(zone);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    TEST_ASSERT_TRUE(mz_validate(zone));
+    mz_destroy(zone);
+}
+
+void test_mz_thread_reset_clears_caches(void)
+{
+    memzone_t* zone = mz_init(64 * 1024);
+    TEST_ASSERT_NOT_NULL(zone);
+
+    void* p = mz_alloc(zone, 128);
+    TEST_ASSERT_NOT_NULL(p);
+    mz_free(zone, p);
+
+    mz_reset(zone);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    TEST_ASSERT_FALSE(mz_contains(zone, p));
+
+    void* q = mz_alloc(zone, 128);
+    TEST_ASSERT_NOT_NULL(q);
+    TEST_ASSERT_TRUE(mz_contains(zone, q));
+    TEST_ASSERT_TRUE(mz_validate(zone));
+
+    mz_free(zone, q);
+    mz_threadFlush(zone);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    mz_destroy(zone);
+}
+
+void test_mz_thread_realloc_moves_cached_block_past_its_class(void)
+{
+    memzone_t* zone = mz_init(64 * 1024);
+    TEST_ASSERT_NOT_NULL(zone);
+
+    uint8_t* p = (uint8_t*)mz_alloc(zone, 10);
+    TEST_ASSERT_NOT_NULL(p);
+    for (int32_t i = 0; i < 16; i++)
+    {
+        p[i] = (uint8_t)(i + 1);
+    }
+
+    TEST_ASSERT_EQUAL_PTR(p, mz_realloc(zone, p, 16));
+
+    uint8_t* q = (uint8_t*)mz_realloc(zone, p, 1000);
+    TEST_ASSERT_NOT_NULL(q);
+    TEST_ASSERT_TRUE(q != p);
+    TEST_ASSERT_FALSE(mz_contains(zone, p));
+    for (int32_t i = 0; i < 16; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(i + 1, q[i]);
+    }
+
+    for (int32_t i = 16; i < 1000; i++)
+    {
+        TEST_ASSERT_EQUAL_UINT8(0, q[i]);
+    }
+
+    mz_free(zone, q);
+    mz_threadFlush(zone);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+    mz_destroy(zone);
+}
+
+void test_mz_thread_large_and_aligned_allocations_bypass_caches(void)
+{
+    memzone_t* zone = mz_init(64 * 1024);
+    TEST_ASSERT_NOT_NULL(zone);
+
+    void* large = mz_alloc(zone, 1024);
+    TEST_ASSERT_NOT_NULL(large);
+    TEST_ASSERT_EQUAL_INT32(2, mz_blockCount(zone));
+    mz_free(zone, large);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+
+    void* aligned = mz_allocAligned(zone, 32, 32);
+    TEST_ASSERT_NOT_NULL(aligned);
+    TEST_ASSERT_EQUAL_UINT64(0, (uintptr_t)aligned % 32);
+    mz_free(zone, aligned);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zone));
+
+    TEST_ASSERT_TRUE(mz_validate(zone));
+    mz_destroy(zone);
+}
+
+void test_mz_thread_caches_more_zones_than_thread_slots(void)
+{
+    enum { ZONE_COUNT = 3 * MZ__THREAD_SLOT_COUNT / 2 };
+    memzone_t* zones[ZONE_COUNT];
+
+    for (int32_t round = 0; round < 2; round++)
+    {
+        for (int32_t i = 0; i < ZONE_COUNT; i++)
+        {
+            if (round == 0)
+            {
+                zones[i] = mz_init(64 * 1024);
+                TEST_ASSERT_NOT_NULL(zones[i]);
+            }
+
+            void* p = mz_alloc(zones[i], 64);
+            TEST_ASSERT_NOT_NULL(p);
+            mz_free(zones[i], p);
+
+            TEST_ASSERT_TRUE(mz_blockCount(zones[i]) > 1);
+            TEST_ASSERT_EQUAL_INT32(1, zones[i]->cacheCount);
+        }
+    }
+
+    for (int32_t i = 0; i < ZONE_COUNT; i++)
+    {
+        mz_threadFlush(zones[i]);
+        TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(zones[i]));
+        TEST_ASSERT_TRUE(mz_validate(zones[i]));
+        mz_destroy(zones[i]);
+    }
+}
+
+void test_mz_thread_destroy_releases_the_slot_of_the_caller(void)
+{
+    enum { ZONE_COUNT = 2 * MZ__THREAD_SLOT_COUNT };
+    memzone_t* keep = mz_init(64 * 1024);
+    TEST_ASSERT_NOT_NULL(keep);
+
+    for (int32_t i = 0; i < ZONE_COUNT; i++)
+    {
+        memzone_t* zone = mz_init(64 * 1024 + (size_t)i * 4096);
+        TEST_ASSERT_NOT_NULL(zone);
+
+        void* p = mz_alloc(zone, 32);
+        TEST_ASSERT_NOT_NULL(p);
+        mz_free(zone, p);
+        TEST_ASSERT_TRUE(mz_blockCount(zone) > 1);
+        mz_destroy(zone);
+
+        void* q = mz_alloc(keep, 32);
+        TEST_ASSERT_NOT_NULL(q);
+        mz_free(keep, q);
+    }
+
+    for (int32_t i = 0; i < MZ__THREAD_SLOT_COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(mz__threadSlots[i].zone == NULL || mz__threadSlots[i].zone == keep);
+    }
+
+    TEST_ASSERT_EQUAL_INT32(1, keep->cacheCount);
+    mz_threadFlush(keep);
+    TEST_ASSERT_EQUAL_INT32(1, mz_blockCount(keep));
+    mz_destroy(keep);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_mz_thread_cache_reuses_freed_block_zeroed);
+    RUN_TEST(test_mz_thread_cache_reports_double_free);
+    RUN_TEST(test_mz_thread_flush_returns_cached_blocks);
+    RUN_TEST(test_mz_thread_remote_frees_return_to_owner_cache);
+    RUN_TEST(test_mz_thread_stress_shared_slots);
+    RUN_TEST(test_mz_thread_reset_clears_caches);
+    RUN_TEST(test_mz_thread_realloc_moves_cached_block_past_its_class);
+    RUN_TEST(test_mz_thread_large_and_aligned_allocations_bypass_caches);
+    RUN_TEST(test_mz_thread_caches_more_zones_than_thread_slots);
+    RUN_TEST(test_mz_thread_destroy_releases_the_slot_of_the_caller);
+    return UNITY_END();
+}
@@ -0,0 +1,238 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include "../multi_queue.h"
+#include "test_common.h"
+
+static int32_t compareInt(const int a, const int b)
+{
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+shlDeclareMultiQueue(IntMultiQueue, int)
+shlDefineMultiQueue(IntMultiQueue, int)
+shlDeclareMultiQueue(PtrMultiQueue, int*)
+shlDefineMultiQueue(PtrMultiQueue, int*)
+
+#define THREAD_COUNT 4
+
+static int g_freeCount = 0;
+
+static int32_t comparePtr(const int* a, const int* b)
+{
+    return compareInt(*a, *b);
+}
+
+static void trackedFree(int* value)
+{
+    g_freeCount++;
+    free(value);
+}
+
+typedef struct
+{
+    IntMultiQueue* queue;
+    int first;
+    int count;
+    atomic_int* seen;
+    atomic_int* popped;
+    int total;
+} WorkerContext;
+
+static void* pushPopWorker(void* arg)
+{
+    WorkerContext* context = (WorkerContext*)arg;
+    int value;
+
+    for (int i = 0; i < context->count; i++)
+    {
+        IntMultiQueuePush(context->queue, context->first + i);
+
+        if ((i & 1) && IntMultiQueuePop(context->queue, &value))
+        {
+            atomic_fetch_add(&context->seen[value], 1);
+            atomic_fetch_add(context->popped, 1);
+        }
+    }
+
+    while (atomic_load(context->popped) < context->total)
+    {
+        if (IntMultiQueuePop(context->queue, &value))
+        {
+            atomic_fetch_add(&context->seen[value], 1);
+            atomic_fetch_add(context->popped, 1);
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+void test_multi_queue_with_one_heap_is_exact(void)
+{
+    IntMultiQueue queue;
+    IntMultiQueueInit(&queue, (IntMultiQueueOptions){ .defaultValue = -1, .compareFn = compareInt, .threadCount = 1, .relaxation = 1 });
+
+    TEST_ASSERT_EQUAL_INT(1, queue.queueCount);
+
+    int value = -1;
+    TEST_ASSERT_FALSE(IntMultiQueuePop(&queue, &value));
+    TEST_ASSERT_FALSE(IntMultiQueuePeek(&queue, &value));
+
+    for (int i = 0; i < 100; i++)
+    {
+        IntMultiQueuePush(&queue, (i * 37) % 100);
+    }
+
+    TEST_ASSERT_EQUAL_INT(100, IntMultiQueueCount(&queue));
+    TEST_ASSERT_TRUE(IntMultiQueuePeek(&queue, &value));
+    TEST_ASSERT_EQUAL_INT(0, value);
+
+    for (int i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_TRUE(IntMultiQueuePop(&queue, &value));
+        TEST_ASSERT_EQUAL_INT(i, value);
+    }
+
+    TEST_ASSERT_FALSE(IntMultiQueuePop(&queue, &value));
+    IntMultiQueueFree(&queue);
+}
+
+void test_multi_queue_relaxed_pops_return_every_item(void)
+{
+    IntMultiQueue queue;
+    IntMultiQueueInit(&queue, (IntMultiQueueOptions){ .defaultValue = -1, .compareFn = compareInt, .threadCount = 4, .relaxation = 2, .arity = 4 });
+
+    TEST_ASSERT_EQUAL_INT(8, queue.queueCount);
+
+    enum { COUNT = 1000 };
+    int seen[COUNT] = {0};
+    for (int i = 0; i < COUNT; i++)
+    {
+        IntMultiQueuePush(&queue, i);
+    }
+
+    int value;
+    int firstHalfSum = 0;
+    for (int i = 0; i < COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(IntMultiQueuePop(&queue, &value));
+        TEST_ASSERT_TRUE(value >= 0 && value < COUNT);
+        seen[value]++;
+
+        if (i < COUNT / 2)
+            firstHalfSum += value;
+    }
+
+    for (int i = 0; i < COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(1, seen[i]);
+    }
+
+    TEST_ASSERT_TRUE(firstHalfSum < (COUNT * COUNT) / 4);
+    TEST_ASSERT_FALSE(IntMultiQueuePop(&queue, &value));
+    TEST_ASSERT_EQUAL_INT(0, IntMultiQueueCount(&queue));
+    IntMultiQueueFree(&queue);
+}
+
+void test_multi_queue_threaded_push_pop_delivers_every_item_once(void)
+{
+    enum { PER_THREAD = SHL_TEST_STRESS_COUNT };
+    const int total = THREAD_COUNT * PER_THREAD;
+    IntMultiQueue queue;
+    IntMultiQueueInit(&queue, (IntMultiQueueOptions){ .defaultValue = -1, .compareFn = compareInt, .threadCount = THREAD_COUNT });
+
+    atomic_int* seen = (atomic_int*)malloc((size_t)total * sizeof(atomic_int));
+    TEST_ASSERT_NOT_NULL(seen);
+    for (int i = 0; i < total; i++)
+    {
+        atomic_init(&seen[i], 0);
+    }
+
+    atomic_int popped;
+    atomic_init(&popped, 0);
+
+    WorkerContext contexts[THREAD_COUNT];
+    pthread_t threads[THREAD_COUNT];
+
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        contexts[i] = (WorkerContext){ &queue, i * PER_THREAD, PER_THREAD, seen, &popped, total };
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, pushPopWorker, &contexts[i]));
+    }
+
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        pthread_join(threads[i], NULL);
+    }
+
+    TEST_ASSERT_EQUAL_INT(total, atomic_load(&popped));
+    for (int i = 0; i < total; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(1, atomic_load(&seen[i]));
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, IntMultiQueueCount(&queue));
+    free(seen);
+    IntMultiQueueFree(&queue);
+}
+
+void test_multi_queue_free_releases_queued_items(void)
+{
+    PtrMultiQueue queue;
+    PtrMultiQueueInit(&queue, (PtrMultiQueueOptions){ .defaultValue = NULL, .compareFn = comparePtr, .freeFn = trackedFree, .threadCount = 2 });
+
+    for (int i = 0; i < 9; i++)
+    {
+        int* value = (int*)malloc(sizeof(int));
+        TEST_ASSERT_NOT_NULL(value);
+        *value = i;
+        PtrMultiQueuePush(&queue, value);
+    }
+
+    int* value = NULL;
+    TEST_ASSERT_TRUE(PtrMultiQueuePop(&queue, &value));
+    free(value);
+
+    PtrMultiQueueFree(&queue);
+    TEST_ASSERT_EQUAL_INT(8, g_freeCount);
+}
+
+void test_multi_queue_slots_start_on_their_own_cache_line(void)
+{
+    IntMultiQueue queue;
+    IntMultiQueueInit(&queue, (IntMultiQueueOptions){ .defaultValue = -1, .compareFn = compareInt, .threadCount = 3, .relaxation = 3 });
+
+    TEST_ASSERT_EQUAL_INT(0, (int)(sizeof(IntMultiQueue__Slot) % SHL__CACHE_LINE_SIZE));
+
+    for (int32_t i = 0; i < queue.queueCount; i++)
+        TEST_ASSERT_EQUAL_INT(0, (int)((uintptr_t)&queue.queues[i].locked % SHL__CACHE_LINE_SIZE));
+
+    IntMultiQueueFree(&queue);
+}
+
+void setUp(void)
+{
+    g_freeCount = 0;
+}
+
+void tearDown(void)
+{
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_multi_queue_with_one_heap_is_exact);
+    RUN_TEST(test_multi_queue_relaxed_pops_return_every_item);
+    RUN_TEST(test_multi_queue_threaded_push_pop_delivers_every_item_once);
+    RUN_TEST(test_multi_queue_free_releases_queued_items);
+    RUN_TEST(test_multi_queue_slots_start_on_their_own_cache_line);
+    return UNITY_END();
+}
@@ -0,0 +1,338 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "../pairing_heap.h"
+#include "test_common.h"
+
+static int32_t compareInt(const int a, const int b)
+{
+    return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+shlDeclarePairingHeap(IntPairingHeap, int)
+shlDefinePairingHeap(IntPairingHeap, int)
+shlDeclarePairingHeap(PtrPairingHeap, int*)
+shlDefinePairingHeap(PtrPairingHeap, int*)
+
+#define THREAD_COUNT 4
+
+static int g_freeCount = 0;
+
+static int32_t comparePtr(const int* a, const int* b)
+{
+    return compareInt(*a, *b);
+}
+
+static void trackedFree(int* value)
+{
+    g_freeCount++;
+    free(value);
+}
+
+typedef struct
+{
+    IntPairingHeap* heap;
+    int first;
+    int count;
+} PushContext;
+
+static void* pushWorker(void* arg)
+{
+    PushContext* context = (PushContext*)arg;
+
+    for (int i = 0; i < context->count; i++)
+    {
+        IntPairingHeapPush(context->heap, context->first + (context->count - 1 - i) * THREAD_COUNT);
+
+        if (i % 5 == 0)
+        {
+            IntPairingHeapPush(context->heap, IntPairingHeapPop(context->heap));
+        }
+    }
+
+    return NULL;
+}
+
+void test_pairing_heap_returns_default_for_empty_heap(void)
+{
+    IntPairingHeap heap;
+    IntPairingHeapInit(&heap, (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt });
+
+    TEST_ASSERT_EQUAL_INT(-1, IntPairingHeapPeek(&heap));
+    TEST_ASSERT_EQUAL_INT(-1, IntPairingHeapPop(&heap));
+    TEST_ASSERT_EQUAL_INT(0, heap.count);
+
+    IntPairingHeapFree(&heap);
+}
+
+void test_pairing_heap_pops_in_order(void)
+{
+    IntPairingHeap heap;
+    IntPairingHeapInit(&heap, (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt });
+
+    for (int i = 0; i < 200; i++)
+    {
+        IntPairingHeapPush(&heap, (i * 67) % 200);
+    }
+
+    TEST_ASSERT_EQUAL_INT(200, heap.count);
+    TEST_ASSERT_EQUAL_INT(0, IntPairingHeapPeek(&heap));
+
+    for (int i = 0; i < 200; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntPairingHeapPop(&heap));
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, heap.count);
+    IntPairingHeapFree(&heap);
+}
+
+void test_pairing_heap_reuses_popped_nodes(void)
+{
+    IntPairingHeap heap;
+    IntPairingHeapInit(&heap, (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt });
+
+    for (int round = 0; round < 100; round++)
+    {
+        for (int i = 0; i < 10; i++)
+        {
+            IntPairingHeapPush(&heap, round * 10 + i);
+        }
+
+        for (int i = 0; i < 10; i++)
+        {
+            TEST_ASSERT_EQUAL_INT(round * 10 + i, IntPairingHeapPop(&heap));
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(10, heap.pool->count);
+    IntPairingHeapFree(&heap);
+}
+
+void test_pairing_heap_meld_heaps_sharing_a_pool(void)
+{
+    IntPairingHeapPool pool;
+    IntPairingHeapPoolInit(&pool, 16, 0);
+
+    enum { HEAP_COUNT = 50 };
+    IntPairingHeap heaps[HEAP_COUNT];
+    for (int i = 0; i < HEAP_COUNT; i++)
+    {
+        IntPairingHeapInit(&heaps[i], (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt, .pool = &pool });
+
+        for (int j = 0; j < 20; j++)
+        {
+            IntPairingHeapPush(&heaps[i], (j * HEAP_COUNT + i) * 7 % 1000);
+        }
+    }
+
+    for (int i = 1; i < HEAP_COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(IntPairingHeapMeld(&heaps[0], &heaps[i]));
+        TEST_ASSERT_EQUAL_INT(0, heaps[i].count);
+        TEST_ASSERT_EQUAL_INT(-1, IntPairingHeapPeek(&heaps[i]));
+    }
+
+    TEST_ASSERT_EQUAL_INT(1000, heaps[0].count);
+    TEST_ASSERT_EQUAL_INT(1000, pool.count);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntPairingHeapPop(&heaps[0]));
+    }
+
+    IntPairingHeapPush(&heaps[1], 5);
+    TEST_ASSERT_EQUAL_INT(1000, pool.count);
+
+    for (int i = 0; i < HEAP_COUNT; i++)
+    {
+        IntPairingHeapFree(&heaps[i]);
+    }
+
+    IntPairingHeapPoolFree(&pool);
+}
+
+void test_pairing_heap_meld_adopts_the_pool_of_the_other_heap(void)
+{
+    IntPairingHeap first;
+    IntPairingHeap second;
+    IntPairingHeapInit(&first, (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt });
+    IntPairingHeapInit(&second, (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt });
+
+    for (int i = 0; i < 100; i++)
+    {
+        IntPairingHeapPush(i % 2 == 0 ? &first : &second, i);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, IntPairingHeapPop(&second));
+    TEST_ASSERT_EQUAL_INT(3, IntPairingHeapPop(&second));
+
+    TEST_ASSERT_TRUE(IntPairingHeapMeld(&first, &second));
+    TEST_ASSERT_EQUAL_INT(98, first.count);
+    TEST_ASSERT_EQUAL_INT(0, second.count);
+    TEST_ASSERT_EQUAL_INT(100, first.pool->count);
+    TEST_ASSERT_EQUAL_INT(0, second.pool->count);
+
+    IntPairingHeapPush(&first, 1);
+    IntPairingHeapPush(&first, 3);
+    TEST_ASSERT_EQUAL_INT(100, first.pool->count);
+
+    for (int i = 0; i < 100; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntPairingHeapPop(&first));
+    }
+
+    IntPairingHeapPush(&second, 7);
+    TEST_ASSERT_EQUAL_INT(7, IntPairingHeapPop(&second));
+
+    IntPairingHeapFree(&first);
+    IntPairingHeapFree(&second);
+}
+
+void test_pairing_heap_meld_rejects_a_heap_on_another_shared_pool(void)
+{
+    IntPairingHeapPool pool;
+    IntPairingHeapPoolInit(&pool, 0, 0);
+
+    IntPairingHeap first;
+    IntPairingHeap second;
+    IntPairingHeapInit(&first, (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt });
+    IntPairingHeapInit(&second, (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt, .pool = &pool });
+
+    IntPairingHeapPush(&first, 1);
+    IntPairingHeapPush(&second, 2);
+
+    TEST_ASSERT_FALSE(IntPairingHeapMeld(&first, &second));
+    TEST_ASSERT_FALSE(IntPairingHeapMeld(&first, &first));
+    TEST_ASSERT_EQUAL_INT(1, first.count);
+    TEST_ASSERT_EQUAL_INT(1, second.count);
+
+    IntPairingHeapFree(&first);
+    IntPairingHeapFree(&second);
+    IntPairingHeapPoolFree(&pool);
+}
+
+void test_pairing_heap_melds_heaps_filled_by_several_threads(void)
+{
+    enum { COUNT_PER_THREAD = SHL_TEST_MEDIUM_COUNT };
+    IntPairingHeap heaps[THREAD_COUNT];
+    PushContext contexts[THREAD_COUNT];
+    pthread_t threads[THREAD_COUNT];
+
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        IntPairingHeapInit(&heaps[i], (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt });
+        contexts[i] = (PushContext){ &heaps[i], i, COUNT_PER_THREAD };
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&threads[i], NULL, pushWorker, &contexts[i]));
+    }
+
+    for (int i = 0; i < THREAD_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_join(threads[i], NULL));
+    }
+
+    for (int i = 1; i < THREAD_COUNT; i++)
+    {
+        TEST_ASSERT_TRUE(IntPairingHeapMeld(&heaps[0], &heaps[i]));
+        IntPairingHeapFree(&heaps[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(COUNT_PER_THREAD * THREAD_COUNT, heaps[0].count);
+
+    for (int i = 0; i < COUNT_PER_THREAD * THREAD_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntPairingHeapPop(&heaps[0]));
+    }
+
+    IntPairingHeapFree(&heaps[0]);
+}
+
+void test_pairing_heap_stress_push_pop_meld_mix(void)
+{
+    IntPairingHeapPool pool;
+    IntPairingHeapPoolInit(&pool, 0, 0);
+
+    IntPairingHeap heap;
+    IntPairingHeap other;
+    IntPairingHeapInit(&heap, (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt, .pool = &pool });
+    IntPairingHeapInit(&other, (IntPairingHeapOptions){ .defaultValue = -1, .compareFn = compareInt, .pool = &pool });
+
+    unsigned seed = 42u;
+    int last = -1;
+    for (int round = 0; round < SHL_TEST_STRESS_COUNT; round++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        IntPairingHeapPush(&other, (int)((seed >> 16) % 100000));
+
+        if (round % 7 == 0)
+        {
+            IntPairingHeapMeld(&heap, &other);
+        }
+
+        if (round % 3 == 0 && heap.count > 0)
+        {
+            int value = IntPairingHeapPeek(&heap);
+            TEST_ASSERT_EQUAL_INT(value, IntPairingHeapPop(&heap));
+        }
+    }
+
+    IntPairingHeapMeld(&heap, &other);
+    while (heap.count > 0)
+    {
+        int value = IntPairingHeapPop(&heap);
+        TEST_ASSERT_TRUE(value >= last);
+        last = value;
+    }
+
+    IntPairingHeapFree(&heap);
+    IntPairingHeapFree(&other);
+    IntPairingHeapPoolFree(&pool);
+}
+
+void test_pairing_heap_free_releases_items(void)
+{
+    PtrPairingHeap heap;
+    PtrPairingHeapInit(&heap, (PtrPairingHeapOptions){ .defaultValue = NULL, .compareFn = comparePtr, .freeFn = trackedFree });
+
+    for (int i = 0; i < 12; i++)
+    {
+        int* value = (int*)malloc(sizeof(int));
+        TEST_ASSERT_NOT_NULL(value);
+        *value = 11 - i;
+        PtrPairingHeapPush(&heap, value);
+    }
+
+    int* value = PtrPairingHeapPop(&heap);
+    TEST_ASSERT_EQUAL_INT(0, *value);
+    free(value);
+
+    PtrPairingHeapFree(&heap);
+    TEST_ASSERT_EQUAL_INT(11, g_freeCount);
+    TEST_ASSERT_EQUAL_INT(0, heap.count);
+}
+
+void setUp(void)
+{
+    g_freeCount = 0;
+}
+
+void tearDown(void)
+{
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_pairing_heap_returns_default_for_empty_heap);
+    RUN_TEST(test_pairing_heap_pops_in_order);
+    RUN_TEST(test_pairing_heap_reuses_popped_nodes);
+    RUN_TEST(test_pairing_heap_meld_heaps_sharing_a_pool);
+    RUN_TEST(test_pairing_heap_meld_adopts_the_pool_of_the_other_heap);
+    RUN_TEST(test_pairing_heap_meld_rejects_a_heap_on_another_shared_pool);
+    RUN_TEST(test_pairing_heap_melds_heaps_filled_by_several_threads);
+    RUN_TEST(test_pairing_heap_stress_push_pop_meld_mix);
+    RUN_TEST(test_pairing_heap_free_releases_items);
+    return UNITY_END();
+}
@@ -132,6 +132,271 @@ void test_int_queue_stress_push_pop_mix_keeps_consistent_front(void)
     IntQueueFree(&queue);
 }
 
+void test_int_queue_reserve_and_shrink_to_fit_keep_wrapped_order(void)
+{
+    IntQueue queue;
+    IntQueueInit(&queue, (IntQueueOptions){ .defaultValue = -1, .equalsFn = intEquals, .growthFactor = 1.5f });
+
+    for (int i = 0; i < 8; i++)
+    {
+        IntQueuePush(&queue, i);
+    }
+
+    for (int i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntQueuePop(&queue));
+    }
+
+    for (int i = 8; i < 12; i++)
+    {
+        IntQueuePush(&queue, i);
+    }
+
+    IntQueueReserve(&queue, 20);
+    TEST_ASSERT_EQUAL_INT(32, queue.capacity);
+
+    for (int i = 12; i < 30; i++)
+    {
+        IntQueuePush(&queue, i);
+    }
+
+    for (int i = 5; i < 15; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntQueuePop(&queue));
+    }
+
+    IntQueueShrinkToFit(&queue);
+    TEST_ASSERT_EQUAL_INT(16, queue.capacity);
+
+    IntQueuePush(&queue, 30);
+    IntQueuePush(&queue, 31);
+    TEST_ASSERT_EQUAL_INT(32, queue.capacity);
+
+    for (int i = 15; i <= 31; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntQueuePop(&queue));
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, queue.count);
+    IntQueueFree(&queue);
+}
+
+void test_int_queue_growth_factor_rounds_to_power_of_two_and_rejects_oversized_ranges(void)
+{
+    IntQueue queue;
+    IntQueueInit(&queue, (IntQueueOptions){ .defaultValue = -1, .growthFactor = 4.0f });
+
+    for (int i = 0; i < 33; i++)
+    {
+        TEST_ASSERT_TRUE(IntQueuePush(&queue, i));
+    }
+
+    TEST_ASSERT_EQUAL_INT(128, queue.capacity);
+
+    int value = 7;
+    TEST_ASSERT_FALSE(IntQueuePushRange(&queue, (1 << 30), &value));
+    TEST_ASSERT_FALSE(IntQueuePushRange(&queue, INT32_MAX, &value));
+    TEST_ASSERT_EQUAL_INT(33, queue.count);
+    TEST_ASSERT_EQUAL_INT(128, queue.capacity);
+
+    IntQueueReserve(&queue, (1 << 30) + 1);
+    TEST_ASSERT_EQUAL_INT(128, queue.capacity);
+
+    TEST_ASSERT_TRUE(IntQueuePushRange(&queue, 1, &value));
+    TEST_ASSERT_TRUE(IntQueuePushFront(&queue, -2));
+    TEST_ASSERT_EQUAL_INT(-2, IntQueuePop(&queue));
+    TEST_ASSERT_EQUAL_INT(7, IntQueuePopBack(&queue));
+
+    IntQueueFree(&queue);
+}
+
+void test_int_queue_growth_keeps_power_of_two_capacity_and_order(void)
+{
+    IntQueue queue;
+    IntQueueInit(&queue, (IntQueueOptions){ .defaultValue = -1, .equalsFn = intEquals, .growthFactor = 1.5f });
+
+    int next = 0;
+    int expected = 0;
+    for (int round = 0; round < 64; round++)
+    {
+        for (int i = 0; i < round + 3; i++)
+        {
+            IntQueuePush(&queue, next++);
+        }
+
+        for (int i = 0; i < 2; i++)
+        {
+            TEST_ASSERT_EQUAL_INT(expected++, IntQueuePop(&queue));
+        }
+
+        TEST_ASSERT_EQUAL_INT(0, queue.capacity & (queue.capacity - 1));
+        TEST_ASSERT_TRUE(IntQueueContains(&queue, next - 1));
+    }
+
+    while (queue.count > 0)
+    {
+        TEST_ASSERT_EQUAL_INT(expected++, IntQueuePop(&queue));
+    }
+
+    TEST_ASSERT_EQUAL_INT(next, expected);
+    IntQueueFree(&queue);
+}
+
+void test_int_queue_push_range_and_pop_range_across_wraparound(void)
+{
+    IntQueue queue;
+    IntQueueInit(&queue, (IntQueueOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    int values[20];
+    for (int i = 0; i < 20; i++)
+    {
+        values[i] = i;
+    }
+
+    IntQueuePushRange(&queue, 6, values);
+
+    int popped[20];
+    TEST_ASSERT_EQUAL_INT(5, IntQueuePopRange(&queue, 5, popped));
+    for (int i = 0; i < 5; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i, popped[i]);
+    }
+
+    IntQueuePushRange(&queue, 6, values + 6);
+    TEST_ASSERT_EQUAL_INT(8, queue.capacity);
+    TEST_ASSERT_TRUE(queue.tail < queue.head);
+    TEST_ASSERT_TRUE(IntQueueContains(&queue, 11));
+
+    IntQueuePushRange(&queue, 8, values + 12);
+    TEST_ASSERT_EQUAL_INT(15, queue.count);
+    TEST_ASSERT_EQUAL_INT(0, queue.capacity & (queue.capacity - 1));
+
+    TEST_ASSERT_EQUAL_INT(15, IntQueuePopRange(&queue, 20, popped));
+    for (int i = 0; i < 15; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i + 5, popped[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, queue.count);
+    TEST_ASSERT_EQUAL_INT(0, IntQueuePopRange(&queue, 4, popped));
+    IntQueueFree(&queue);
+}
+
+void test_int_queue_peek_spans_then_drop_with_pop_range(void)
+{
+    IntQueue queue;
+    IntQueueInit(&queue, (IntQueueOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    int* first;
+    int* second;
+    int firstCount;
+    int secondCount;
+
+    IntQueuePeekSpans(&queue, &first, &firstCount, &second, &secondCount);
+    TEST_ASSERT_EQUAL_INT(0, firstCount);
+    TEST_ASSERT_EQUAL_INT(0, secondCount);
+    TEST_ASSERT_NULL(second);
+
+    for (int i = 0; i < 6; i++)
+    {
+        IntQueuePush(&queue, i);
+    }
+
+    IntQueuePeekSpans(&queue, &first, &firstCount, &second, &secondCount);
+    TEST_ASSERT_EQUAL_INT(6, firstCount);
+    TEST_ASSERT_EQUAL_INT(0, secondCount);
+
+    TEST_ASSERT_EQUAL_INT(4, IntQueuePopRange(&queue, 4, NULL));
+    for (int i = 6; i < 12; i++)
+    {
+        IntQueuePush(&queue, i);
+    }
+
+    IntQueuePeekSpans(&queue, &first, &firstCount, &second, &secondCount);
+    TEST_ASSERT_EQUAL_INT(4, firstCount);
+    TEST_ASSERT_EQUAL_INT(4, secondCount);
+    TEST_ASSERT_EQUAL_PTR(queue.items, second);
+
+    int expected = 4;
+    for (int i = 0; i < firstCount; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(expected++, first[i]);
+    }
+    for (int i = 0; i < secondCount; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(expected++, second[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(8, IntQueuePopRange(&queue, firstCount + secondCount, NULL));
+    TEST_ASSERT_EQUAL_INT(0, queue.count);
+    TEST_ASSERT_EQUAL_INT(-1, IntQueuePeek(&queue));
+    IntQueueFree(&queue);
+}
+
+void test_int_queue_deque_operations_on_both_ends(void)
+{
+    IntQueue queue;
+    IntQueueInit(&queue, (IntQueueOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    TEST_ASSERT_EQUAL_INT(-1, IntQueuePeekBack(&queue));
+    TEST_ASSERT_EQUAL_INT(-1, IntQueuePopBack(&queue));
+    TEST_ASSERT_EQUAL_INT(-1, IntQueueAt(&queue, 0));
+
+    for (int i = 0; i < 10; i++)
+    {
+        IntQueuePush(&queue, i);
+        IntQueuePushFront(&queue, -i - 1);
+    }
+
+    TEST_ASSERT_EQUAL_INT(20, queue.count);
+    TEST_ASSERT_EQUAL_INT(-10, IntQueuePeek(&queue));
+    TEST_ASSERT_EQUAL_INT(9, IntQueuePeekBack(&queue));
+
+    for (int i = 0; i < 20; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(i - 10, IntQueueAt(&queue, i));
+    }
+    TEST_ASSERT_EQUAL_INT(-1, IntQueueAt(&queue, 20));
+    TEST_ASSERT_EQUAL_INT(-1, IntQueueAt(&queue, -1));
+
+    for (int i = 9; i >= 0; i--)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntQueuePopBack(&queue));
+    }
+    for (int i = 10; i >= 1; i--)
+    {
+        TEST_ASSERT_EQUAL_INT(-i, IntQueuePop(&queue));
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, queue.count);
+    IntQueueFree(&queue);
+}
+
+void test_int_queue_lifo_local_and_fifo_steal_pattern(void)
+{
+    IntQueue queue;
+    IntQueueInit(&queue, (IntQueueOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    int next = 0;
+    int stolen = 0;
+    for (int round = 0; round < 100; round++)
+    {
+        for (int i = 0; i < 5; i++)
+        {
+            IntQueuePush(&queue, next++);
+        }
+
+        TEST_ASSERT_EQUAL_INT(next - 1, IntQueuePopBack(&queue));
+        TEST_ASSERT_EQUAL_INT(stolen, IntQueuePop(&queue));
+        stolen += (stolen % 5 == 3) ? 2 : 1;
+        TEST_ASSERT_EQUAL_INT(stolen, IntQueueAt(&queue, 0));
+        TEST_ASSERT_EQUAL_INT(next - 2, IntQueueAt(&queue, queue.count - 1));
+    }
+
+    TEST_ASSERT_EQUAL_INT(300, queue.count);
+    IntQueueFree(&queue);
+}
+
 void test_entry_queue_contains_equivalent_value(void)
 {
     EntryQueue queue;
@@ -175,6 +440,51 @@ void test_entry_queue_clear_calls_free_function_after_wraparound(void)
     EntryQueueFree(&queue);
 }
 
+void test_entry_queue_pop_range_without_values_frees_items_across_wraparound(void)
+{
+    EntryQueue queue;
+    EntryQueueInit(&queue, (EntryQueueOptions){ .defaultValue = NULL, .equalsFn = entryEquals, .freeFn = trackedEntryFree });
+
+    for (int i = 0; i < 6; i++)
+    {
+        EntryQueuePush(&queue, makeEntry(i, "entry"));
+    }
+    for (int i = 0; i < 4; i++)
+    {
+        trackedEntryFree(EntryQueuePop(&queue));
+    }
+    for (int i = 6; i < 12; i++)
+    {
+        EntryQueuePush(&queue, makeEntry(i, "entry"));
+    }
+
+    TEST_ASSERT_EQUAL_INT(8, queue.capacity);
+    TEST_ASSERT_TRUE(queue.capacity - queue.head < 6);
+
+    int32_t head = queue.head;
+    TEST_ASSERT_EQUAL_INT(6, EntryQueuePopRange(&queue, 6, NULL));
+    TEST_ASSERT_EQUAL_INT(10, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(2, queue.count);
+
+    for (int i = 0; i < 6; i++)
+    {
+        TEST_ASSERT_NULL(queue.items[(head + i) & (queue.capacity - 1)]);
+    }
+
+    Entry* popped[2];
+    TEST_ASSERT_EQUAL_INT(2, EntryQueuePopRange(&queue, 2, popped));
+    TEST_ASSERT_EQUAL_INT(10, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(10, popped[0]->index);
+    TEST_ASSERT_EQUAL_INT(11, popped[1]->index);
+    TEST_ASSERT_NULL(queue.items[(head + 6) & (queue.capacity - 1)]);
+    TEST_ASSERT_NULL(queue.items[(head + 7) & (queue.capacity - 1)]);
+    trackedEntryFree(popped[0]);
+    trackedEntryFree(popped[1]);
+
+    EntryQueueFree(&queue);
+    TEST_ASSERT_EQUAL_INT(12, g_entryFreeCount);
+}
+
 void test_entry_queue_integration_pop_half_then_clear_releases_all_items(void)
 {
     EntryQueue queue;
@@ -214,8 +524,16 @@ int main(void)
     RUN_TEST(test_int_queue_preserves_fifo_order);
     RUN_TEST(test_int_queue_wraparound_keeps_order);
     RUN_TEST(test_int_queue_stress_push_pop_mix_keeps_consistent_front);
+    RUN_TEST(test_int_queue_reserve_and_shrink_to_fit_keep_wrapped_order);
+    RUN_TEST(test_int_queue_growth_keeps_power_of_two_capacity_and_order);
+    RUN_TEST(test_int_queue_growth_factor_rounds_to_power_of_two_and_rejects_oversized_ranges);
+    RUN_TEST(test_int_queue_push_range_and_pop_range_across_wraparound);
+    RUN_TEST(test_int_queue_peek_spans_then_drop_with_pop_range);
+    RUN_TEST(test_int_queue_deque_operations_on_both_ends);
+    RUN_TEST(test_int_queue_lifo_local_and_fifo_steal_pattern);
     RUN_TEST(test_entry_queue_contains_equivalent_value);
     RUN_TEST(test_entry_queue_clear_calls_free_function_after_wraparound);
+    RUN_TEST(test_entry_queue_pop_range_without_values_frees_items_across_wraparound);
     RUN_TEST(test_entry_queue_integration_pop_half_then_clear_releases_all_items);
     return UNITY_END();
 }
@@ -0,0 +1,200 @@
+#include <stdlib.h>
+
+#include "../radix_heap.h"
+#include "test_common.h"
+
+shlDeclareRadixHeap(IntRadixHeap, int)
+shlDefineRadixHeap(IntRadixHeap, int)
+shlDeclareRadixHeap(PtrRadixHeap, int*)
+shlDefineRadixHeap(PtrRadixHeap, int*)
+
+static int g_freeCount = 0;
+
+static void trackedFree(int* value)
+{
+    g_freeCount++;
+    free(value);
+}
+
+void test_radix_heap_returns_default_for_empty_heap(void)
+{
+    IntRadixHeap heap;
+    IntRadixHeapInit(&heap, (IntRadixHeapOptions){ .defaultValue = -1 });
+
+    uint32_t key = 7;
+    TEST_ASSERT_EQUAL_INT(-1, IntRadixHeapPeek(&heap, &key));
+    TEST_ASSERT_EQUAL_INT(-1, IntRadixHeapPop(&heap, &key));
+    TEST_ASSERT_EQUAL_UINT32(7, key);
+
+    IntRadixHeapFree(&heap);
+}
+
+void test_radix_heap_pops_in_key_order(void)
+{
+    IntRadixHeap heap;
+    IntRadixHeapInit(&heap, (IntRadixHeapOptions){ .defaultValue = -1 });
+
+    const uint32_t keys[] = { 50, 3, 1000000, 3, 0, 77, UINT32_MAX, 4096, 51 };
+    for (int i = 0; i < 9; i++)
+    {
+        TEST_ASSERT_TRUE(IntRadixHeapPush(&heap, keys[i], i));
+    }
+
+    TEST_ASSERT_EQUAL_INT(9, heap.count);
+
+    uint32_t key;
+    TEST_ASSERT_EQUAL_INT(4, IntRadixHeapPeek(&heap, &key));
+    TEST_ASSERT_EQUAL_UINT32(0, key);
+
+    const uint32_t expected[] = { 0, 3, 3, 50, 51, 77, 4096, 1000000, UINT32_MAX };
+    for (int i = 0; i < 9; i++)
+    {
+        int value = IntRadixHeapPop(&heap, &key);
+        TEST_ASSERT_EQUAL_UINT32(expected[i], key);
+        TEST_ASSERT_EQUAL_UINT32(keys[value], key);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, heap.count);
+    IntRadixHeapFree(&heap);
+}
+
+void test_radix_heap_rejects_keys_below_last_popped(void)
+{
+    IntRadixHeap heap;
+    IntRadixHeapInit(&heap, (IntRadixHeapOptions){ .defaultValue = -1 });
+
+    IntRadixHeapPush(&heap, 10, 1);
+    IntRadixHeapPush(&heap, 20, 2);
+    TEST_ASSERT_EQUAL_INT(1, IntRadixHeapPop(&heap, NULL));
+
+    TEST_ASSERT_FALSE(IntRadixHeapPush(&heap, 9, 3));
+    TEST_ASSERT_TRUE(IntRadixHeapPush(&heap, 10, 4));
+    TEST_ASSERT_EQUAL_INT(2, heap.count);
+    TEST_ASSERT_EQUAL_INT(4, IntRadixHeapPop(&heap, NULL));
+    TEST_ASSERT_EQUAL_INT(2, IntRadixHeapPop(&heap, NULL));
+
+    IntRadixHeapClear(&heap);
+    TEST_ASSERT_TRUE(IntRadixHeapPush(&heap, 0, 5));
+    TEST_ASSERT_EQUAL_INT(5, IntRadixHeapPop(&heap, NULL));
+
+    IntRadixHeapFree(&heap);
+}
+
+void test_radix_heap_peek_does_not_raise_the_push_bound(void)
+{
+    IntRadixHeap heap;
+    IntRadixHeapInit(&heap, (IntRadixHeapOptions){ .defaultValue = -1 });
+
+    uint32_t key = 0;
+    TEST_ASSERT_TRUE(IntRadixHeapPush(&heap, 10, 1));
+    TEST_ASSERT_EQUAL_INT(1, IntRadixHeapPeek(&heap, &key));
+    TEST_ASSERT_EQUAL_UINT32(10, key);
+
+    TEST_ASSERT_TRUE(IntRadixHeapPush(&heap, 5, 2));
+    TEST_ASSERT_EQUAL_INT(2, IntRadixHeapPeek(&heap, &key));
+    TEST_ASSERT_EQUAL_UINT32(5, key);
+
+    TEST_ASSERT_TRUE(IntRadixHeapPush(&heap, 7, 3));
+    TEST_ASSERT_TRUE(IntRadixHeapPush(&heap, 7, 4));
+    TEST_ASSERT_EQUAL_INT(2, IntRadixHeapPop(&heap, &key));
+    TEST_ASSERT_EQUAL_UINT32(5, key);
+
+    int peeked = IntRadixHeapPeek(&heap, &key);
+    TEST_ASSERT_EQUAL_UINT32(7, key);
+    TEST_ASSERT_EQUAL_INT(peeked, IntRadixHeapPop(&heap, &key));
+    TEST_ASSERT_EQUAL_UINT32(7, key);
+
+    TEST_ASSERT_FALSE(IntRadixHeapPush(&heap, 6, 5));
+    TEST_ASSERT_EQUAL_INT(7 - peeked, IntRadixHeapPop(&heap, &key));
+    TEST_ASSERT_EQUAL_INT(1, IntRadixHeapPop(&heap, &key));
+    TEST_ASSERT_EQUAL_UINT32(10, key);
+
+    IntRadixHeapFree(&heap);
+}
+
+void test_radix_heap_stress_monotone_push_pop_mix(void)
+{
+    IntRadixHeap heap;
+    IntRadixHeapInit(&heap, (IntRadixHeapOptions){ .defaultValue = -1 });
+
+    unsigned seed = 2024u;
+    uint32_t last = 0;
+    int pushed = 0;
+    int popped = 0;
+
+    for (int round = 0; round < SHL_TEST_STRESS_COUNT; round++)
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            seed = seed * 1103515245u + 12345u;
+            TEST_ASSERT_TRUE(IntRadixHeapPush(&heap, last + (seed >> 16) % 500, pushed++));
+        }
+
+        for (int i = 0; i < 2; i++)
+        {
+            uint32_t peekedKey;
+            uint32_t key;
+            int value = IntRadixHeapPeek(&heap, &peekedKey);
+            TEST_ASSERT_EQUAL_INT(value, IntRadixHeapPop(&heap, &key));
+            TEST_ASSERT_EQUAL_UINT32(peekedKey, key);
+            TEST_ASSERT_TRUE(key >= last);
+            last = key;
+            popped++;
+        }
+    }
+
+    while (heap.count > 0)
+    {
+        uint32_t key;
+        IntRadixHeapPop(&heap, &key);
+        TEST_ASSERT_TRUE(key >= last);
+        last = key;
+        popped++;
+    }
+
+    TEST_ASSERT_EQUAL_INT(pushed, popped);
+    IntRadixHeapFree(&heap);
+}
+
+void test_radix_heap_free_releases_items(void)
+{
+    PtrRadixHeap heap;
+    PtrRadixHeapInit(&heap, (PtrRadixHeapOptions){ .defaultValue = NULL, .freeFn = trackedFree });
+
+    for (int i = 0; i < 12; i++)
+    {
+        int* value = (int*)malloc(sizeof(int));
+        TEST_ASSERT_NOT_NULL(value);
+        *value = i;
+        PtrRadixHeapPush(&heap, (uint32_t)(i * 1000), value);
+    }
+
+    int* value = PtrRadixHeapPop(&heap, NULL);
+    TEST_ASSERT_EQUAL_INT(0, *value);
+    free(value);
+
+    PtrRadixHeapFree(&heap);
+    TEST_ASSERT_EQUAL_INT(11, g_freeCount);
+    TEST_ASSERT_EQUAL_INT(0, heap.count);
+}
+
+void setUp(void)
+{
+    g_freeCount = 0;
+}
+
+void tearDown(void)
+{
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_radix_heap_returns_default_for_empty_heap);
+    RUN_TEST(test_radix_heap_pops_in_key_order);
+    RUN_TEST(test_radix_heap_rejects_keys_below_last_popped);
+    RUN_TEST(test_radix_heap_peek_does_not_raise_the_push_bound);
+    RUN_TEST(test_radix_heap_stress_monotone_push_pop_mix);
+    RUN_TEST(test_radix_heap_free_releases_items);
+    return UNITY_END();
+}
@@ -0,0 +1,186 @@
+#include <stdlib.h>
+
+#include "../sparse_grid.h"
+#include "test_common.h"
+
+shlDeclareSparseGrid(ByteGrid, uint8_t)
+shlDefineSparseGrid(ByteGrid, uint8_t)
+shlDeclareSparseGrid(IntGrid, int)
+shlDefineSparseGrid(IntGrid, int)
+
+void test_sparse_grid_reads_default_without_allocating(void)
+{
+    IntGrid grid;
+    IntGridInit(&grid, (IntGridOptions){ .defaultValue = -1 });
+
+    TEST_ASSERT_EQUAL_INT(SHL_SPARSE_GRID_DEFAULT_CHUNK_SHIFT, grid.chunkShift);
+    TEST_ASSERT_EQUAL_INT(-1, IntGridGet(&grid, 0, 0));
+    TEST_ASSERT_EQUAL_INT(-1, IntGridGet(&grid, 65535, -65536));
+    TEST_ASSERT_NULL(IntGridCellPtr(&grid, 10, 10, false));
+    TEST_ASSERT_NULL(IntGridChunkAt(&grid, 10, 10, false));
+    TEST_ASSERT_EQUAL_INT(0, grid.chunkCount);
+
+    IntGridFree(&grid);
+}
+
+void test_sparse_grid_allocates_chunks_on_first_write(void)
+{
+    IntGrid grid;
+    IntGridInit(&grid, (IntGridOptions){ .defaultValue = 7, .chunkShift = 4 });
+
+    IntGridSet(&grid, 3, 5, 42);
+    TEST_ASSERT_EQUAL_INT(1, grid.chunkCount);
+    TEST_ASSERT_EQUAL_INT(42, IntGridGet(&grid, 3, 5));
+    TEST_ASSERT_EQUAL_INT(7, IntGridGet(&grid, 4, 5));
+    TEST_ASSERT_EQUAL_INT(7, IntGridGet(&grid, 15, 15));
+
+    IntGridSet(&grid, 15, 0, 1);
+    TEST_ASSERT_EQUAL_INT(1, grid.chunkCount);
+
+    IntGridSet(&grid, 16, 0, 2);
+    IntGridSet(&grid, -1, -1, 3);
+    IntGridSet(&grid, 65535, 65535, 4);
+    TEST_ASSERT_EQUAL_INT(4, grid.chunkCount);
+
+    TEST_ASSERT_EQUAL_INT(2, IntGridGet(&grid, 16, 0));
+    TEST_ASSERT_EQUAL_INT(3, IntGridGet(&grid, -1, -1));
+    TEST_ASSERT_EQUAL_INT(4, IntGridGet(&grid, 65535, 65535));
+    TEST_ASSERT_EQUAL_INT(42, IntGridGet(&grid, 3, 5));
+
+    IntGridChunk* chunk = IntGridChunkAt(&grid, -1, -1, false);
+    TEST_ASSERT_NOT_NULL(chunk);
+    TEST_ASSERT_EQUAL_INT(-16, chunk->x);
+    TEST_ASSERT_EQUAL_INT(-16, chunk->y);
+    TEST_ASSERT_EQUAL_INT(3, chunk->cells[15 * 16 + 15]);
+
+    int* cell = IntGridCellPtr(&grid, 100, 200, true);
+    TEST_ASSERT_NOT_NULL(cell);
+    TEST_ASSERT_EQUAL_INT(7, *cell);
+    *cell = 9;
+    TEST_ASSERT_EQUAL_INT(9, IntGridGet(&grid, 100, 200));
+    TEST_ASSERT_EQUAL_INT(5, grid.chunkCount);
+
+    IntGridFree(&grid);
+}
+
+void test_sparse_grid_iterates_allocated_chunks_only(void)
+{
+    ByteGrid grid;
+    ByteGridInit(&grid, (ByteGridOptions){ .defaultValue = 0, .chunkShift = 5 });
+
+    for (int32_t i = 0; i < 100; i++)
+    {
+        ByteGridSet(&grid, i * 1000, i * 700, 1);
+        ByteGridSet(&grid, i * 1000 + 1, i * 700, 1);
+    }
+
+    TEST_ASSERT_EQUAL_INT(100, ByteGridChunkCount(&grid));
+    TEST_ASSERT_NULL(ByteGridGetChunk(&grid, -1));
+    TEST_ASSERT_NULL(ByteGridGetChunk(&grid, 100));
+
+    int32_t total = 0;
+    for (int32_t c = 0; c < ByteGridChunkCount(&grid); c++)
+    {
+        ByteGridChunk* chunk = ByteGridGetChunk(&grid, c);
+        TEST_ASSERT_NOT_NULL(chunk);
+        TEST_ASSERT_EQUAL_INT(0, chunk->x & 31);
+        TEST_ASSERT_EQUAL_INT(0, chunk->y & 31);
+
+        for (int32_t i = 0; i < 32 * 32; i++)
+        {
+            total += chunk->cells[i];
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(200, total);
+    ByteGridFree(&grid);
+}
+
+void test_sparse_grid_remove_chunk_keeps_other_chunks_reachable(void)
+{
+    IntGrid grid;
+    IntGridInit(&grid, (IntGridOptions){ .defaultValue = 0, .chunkShift = 3 });
+
+    for (int32_t i = 0; i < 10; i++)
+    {
+        IntGridSet(&grid, i * 8, 0, i + 1);
+    }
+
+    TEST_ASSERT_EQUAL_INT(10, IntGridGet(&grid, 72, 0));
+    TEST_ASSERT_TRUE(IntGridRemoveChunk(&grid, 20, 3));
+    TEST_ASSERT_FALSE(IntGridRemoveChunk(&grid, 20, 3));
+    TEST_ASSERT_EQUAL_INT(9, grid.chunkCount);
+    TEST_ASSERT_EQUAL_INT(0, IntGridGet(&grid, 16, 0));
+
+    for (int32_t i = 0; i < 10; i++)
+    {
+        if (i != 2)
+            TEST_ASSERT_EQUAL_INT(i + 1, IntGridGet(&grid, i * 8, 0));
+    }
+
+    IntGridClear(&grid);
+    TEST_ASSERT_EQUAL_INT(0, grid.chunkCount);
+    TEST_ASSERT_EQUAL_INT(0, IntGridGet(&grid, 72, 0));
+
+    IntGridSet(&grid, 1, 1, 5);
+    TEST_ASSERT_EQUAL_INT(5, IntGridGet(&grid, 1, 1));
+    IntGridFree(&grid);
+}
+
+void test_sparse_grid_stress_matches_dense_reference(void)
+{
+    enum { SIZE = 512 };
+    static int dense[SIZE][SIZE];
+    IntGrid grid;
+    IntGridInit(&grid, (IntGridOptions){ .defaultValue = 0, .chunkShift = 4 });
+
+    for (int32_t i = 0; i < SIZE; i++)
+    {
+        for (int32_t j = 0; j < SIZE; j++)
+        {
+            dense[i][j] = 0;
+        }
+    }
+
+    unsigned seed = 99u;
+    for (int32_t i = 0; i < SHL_TEST_STRESS_COUNT; i++)
+    {
+        seed = seed * 1103515245u + 12345u;
+        int32_t x = (int32_t)((seed >> 8) % SIZE);
+        seed = seed * 1103515245u + 12345u;
+        int32_t y = (int32_t)((seed >> 8) % SIZE);
+
+        dense[y][x] = i;
+        IntGridSet(&grid, x - SIZE / 2, y - SIZE / 2, i);
+        TEST_ASSERT_EQUAL_INT(dense[(y + 1) % SIZE][x], IntGridGet(&grid, x - SIZE / 2, (y + 1) % SIZE - SIZE / 2));
+    }
+
+    for (int32_t y = 0; y < SIZE; y++)
+    {
+        for (int32_t x = 0; x < SIZE; x++)
+        {
+            TEST_ASSERT_EQUAL_INT(dense[y][x], IntGridGet(&grid, x - SIZE / 2, y - SIZE / 2));
+        }
+    }
+
+    IntGridFree(&grid);
+}
+
+void setUp(void)
+{
+}
+
+void tearDown(void)
+{
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sparse_grid_reads_default_without_allocating);
+    RUN_TEST(test_sparse_grid_allocates_chunks_on_first_write);
+    RUN_TEST(test_sparse_grid_iterates_allocated_chunks_only);
+    RUN_TEST(test_sparse_grid_remove_chunk_keeps_other_chunks_reachable);
+    RUN_TEST(test_sparse_grid_stress_matches_dense_reference);
+    return UNITY_END();
+}
@@ -29,6 +29,10 @@ shlDeclareStack(IntStack, int)
 shlDefineStack(IntStack, int)
 shlDeclareStack(EntryStack, Entry*)
 shlDefineStack(EntryStack, Entry*)
+shlDeclareFixedStack(IntFixedStack, int, 16)
+shlDefineFixedStack(IntFixedStack, int)
+shlDeclareFixedStack(EntryFixedStack, Entry*, 8)
+shlDefineFixedStack(EntryFixedStack, Entry*)
 
 static int g_entryFreeCount = 0;
 
@@ -121,6 +125,29 @@ void test_int_stack_stress_push_pop_cycle(void)
     IntStackFree(&stack);
 }
 
+void test_int_stack_reserve_and_shrink_to_fit_adjust_capacity(void)
+{
+    IntStack stack;
+    IntStackInit(&stack, (IntStackOptions){ .defaultValue = -1, .equalsFn = intEquals, .growthFactor = 1.5f });
+
+    IntStackReserve(&stack, 100);
+    TEST_ASSERT_EQUAL_INT(100, stack.capacity);
+
+    for (int i = 0; i < 101; i++)
+    {
+        IntStackPush(&stack, i);
+    }
+
+    TEST_ASSERT_EQUAL_INT(150, stack.capacity);
+
+    IntStackShrinkToFit(&stack);
+    TEST_ASSERT_EQUAL_INT(101, stack.capacity);
+    TEST_ASSERT_EQUAL_INT(100, IntStackPop(&stack));
+    TEST_ASSERT_EQUAL_INT(99, IntStackPeek(&stack));
+
+    IntStackFree(&stack);
+}
+
 void test_entry_stack_contains_equivalent_value(void)
 {
     EntryStack stack;
@@ -180,6 +207,171 @@ void test_entry_stack_integration_pop_then_clear_releases_remaining_items(void)
     EntryStackFree(&stack);
 }
 
+void test_int_stack_push_n_and_pop_n_keep_order(void)
+{
+    IntStack stack;
+    IntStackInit(&stack, (IntStackOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    int values[40];
+    for (int i = 0; i < 40; i++)
+    {
+        values[i] = i;
+    }
+
+    IntStackPush(&stack, -5);
+    IntStackPushN(&stack, 40, values);
+    TEST_ASSERT_EQUAL_INT(41, stack.count);
+    TEST_ASSERT_TRUE(stack.capacity >= 41);
+    TEST_ASSERT_EQUAL_INT(39, IntStackPeek(&stack));
+
+    int popped[40] = {0};
+    TEST_ASSERT_EQUAL_INT(10, IntStackPopN(&stack, 10, popped));
+    for (int i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(30 + i, popped[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(20, IntStackPopN(&stack, 20, NULL));
+    TEST_ASSERT_EQUAL_INT(11, IntStackPopN(&stack, 40, popped));
+    TEST_ASSERT_EQUAL_INT(-5, popped[0]);
+    TEST_ASSERT_EQUAL_INT(9, popped[10]);
+    TEST_ASSERT_EQUAL_INT(0, IntStackPopN(&stack, 1, popped));
+
+    IntStackFree(&stack);
+}
+
+void test_entry_stack_restore_to_mark_frees_scope_items(void)
+{
+    EntryStack stack;
+    EntryStackInit(&stack, (EntryStackOptions){ .defaultValue = NULL, .equalsFn = entryEquals, .freeFn = trackedEntryFree });
+
+    for (int i = 0; i < 3; i++)
+    {
+        EntryStackPush(&stack, makeEntry(i, "outer"));
+    }
+
+    int32_t outer = EntryStackMark(&stack);
+    for (int i = 0; i < 5; i++)
+    {
+        EntryStackPush(&stack, makeEntry(i, "inner"));
+    }
+
+    int32_t inner = EntryStackMark(&stack);
+    EntryStackPush(&stack, makeEntry(0, "innermost"));
+
+    EntryStackRestoreTo(&stack, inner);
+    TEST_ASSERT_EQUAL_INT(1, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(8, stack.count);
+
+    EntryStackRestoreTo(&stack, outer);
+    TEST_ASSERT_EQUAL_INT(6, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(3, stack.count);
+    TEST_ASSERT_EQUAL_STRING("outer", EntryStackPeek(&stack)->name);
+
+    EntryStackRestoreTo(&stack, inner);
+    TEST_ASSERT_EQUAL_INT(3, stack.count);
+
+    EntryStackFree(&stack);
+    TEST_ASSERT_EQUAL_INT(9, g_entryFreeCount);
+}
+
+void test_entry_stacks_pop_n_without_values_frees_dropped_items(void)
+{
+    EntryStack stack;
+    EntryStackInit(&stack, (EntryStackOptions){ .defaultValue = NULL, .equalsFn = entryEquals, .freeFn = trackedEntryFree });
+
+    for (int i = 0; i < 6; i++)
+    {
+        EntryStackPush(&stack, makeEntry(i, "dropped"));
+    }
+
+    Entry* popped[2];
+    TEST_ASSERT_EQUAL_INT(2, EntryStackPopN(&stack, 2, popped));
+    TEST_ASSERT_EQUAL_INT(0, g_entryFreeCount);
+    free(popped[0]);
+    free(popped[1]);
+
+    TEST_ASSERT_EQUAL_INT(3, EntryStackPopN(&stack, 3, NULL));
+    TEST_ASSERT_EQUAL_INT(3, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(0, EntryStackPeek(&stack)->index);
+
+    EntryStackFree(&stack);
+    TEST_ASSERT_EQUAL_INT(4, g_entryFreeCount);
+
+    EntryFixedStack fixed;
+    EntryFixedStackInit(&fixed, (EntryFixedStackOptions){ .defaultValue = NULL, .equalsFn = entryEquals, .freeFn = trackedEntryFree });
+
+    for (int i = 0; i < 4; i++)
+    {
+        TEST_ASSERT_TRUE(EntryFixedStackPush(&fixed, makeEntry(i, "dropped")));
+    }
+
+    TEST_ASSERT_EQUAL_INT(4, EntryFixedStackPopN(&fixed, 10, NULL));
+    TEST_ASSERT_EQUAL_INT(8, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(0, fixed.count);
+    EntryFixedStackFree(&fixed);
+}
+
+void test_int_fixed_stack_stays_inline_and_rejects_overflow(void)
+{
+    IntFixedStack stack;
+    IntFixedStackInit(&stack, (IntFixedStackOptions){ .defaultValue = -1, .equalsFn = intEquals });
+
+    TEST_ASSERT_EQUAL_INT(16, stack.capacity);
+    TEST_ASSERT_EQUAL_INT(-1, IntFixedStackPop(&stack));
+
+    for (int i = 0; i < 10; i++)
+    {
+        TEST_ASSERT_TRUE(IntFixedStackPush(&stack, i));
+    }
+
+    int values[] = { 10, 11, 12, 13, 14, 15, 16, 17 };
+    TEST_ASSERT_EQUAL_INT(6, IntFixedStackPushN(&stack, 8, values));
+    TEST_ASSERT_FALSE(IntFixedStackPush(&stack, 99));
+    TEST_ASSERT_EQUAL_INT(15, IntFixedStackPeek(&stack));
+    TEST_ASSERT_TRUE(IntFixedStackContains(&stack, 12));
+    TEST_ASSERT_FALSE(IntFixedStackContains(&stack, 16));
+
+    int32_t mark = IntFixedStackMark(&stack) - 6;
+    IntFixedStackRestoreTo(&stack, mark);
+    TEST_ASSERT_EQUAL_INT(10, stack.count);
+
+    int popped[4];
+    TEST_ASSERT_EQUAL_INT(4, IntFixedStackPopN(&stack, 4, popped));
+    TEST_ASSERT_EQUAL_INT(6, popped[0]);
+    TEST_ASSERT_EQUAL_INT(9, popped[3]);
+
+    for (int i = 5; i >= 0; i--)
+    {
+        TEST_ASSERT_EQUAL_INT(i, IntFixedStackPop(&stack));
+    }
+
+    TEST_ASSERT_EQUAL_INT(-1, IntFixedStackPeek(&stack));
+    IntFixedStackFree(&stack);
+}
+
+void test_entry_fixed_stack_free_releases_items(void)
+{
+    EntryFixedStack stack;
+    EntryFixedStackInit(&stack, (EntryFixedStackOptions){ .defaultValue = NULL, .equalsFn = entryEquals, .freeFn = trackedEntryFree });
+
+    for (int i = 0; i < 8; i++)
+    {
+        TEST_ASSERT_TRUE(EntryFixedStackPush(&stack, makeEntry(i, "fixed")));
+    }
+
+    Entry* overflow = makeEntry(8, "fixed");
+    TEST_ASSERT_FALSE(EntryFixedStackPush(&stack, overflow));
+    free(overflow);
+
+    Entry probe = { .index = 3, .name = "fixed" };
+    TEST_ASSERT_TRUE(EntryFixedStackContains(&stack, &probe));
+
+    EntryFixedStackFree(&stack);
+    TEST_ASSERT_EQUAL_INT(8, g_entryFreeCount);
+    TEST_ASSERT_EQUAL_INT(0, stack.count);
+}
+
 void setUp(void)
 {
     g_entryFreeCount = 0;
@@ -196,8 +388,14 @@ int main(void)
     RUN_TEST(test_int_stack_push_pop_is_lifo);
     RUN_TEST(test_int_stack_clear_resets_count);
     RUN_TEST(test_int_stack_stress_push_pop_cycle);
+    RUN_TEST(test_int_stack_reserve_and_shrink_to_fit_adjust_capacity);
     RUN_TEST(test_entry_stack_contains_equivalent_value);
     RUN_TEST(test_entry_stack_clear_calls_free_function);
     RUN_TEST(test_entry_stack_integration_pop_then_clear_releases_remaining_items);
+    RUN_TEST(test_int_stack_push_n_and_pop_n_keep_order);
+    RUN_TEST(test_entry_stack_restore_to_mark_frees_scope_items);
+    RUN_TEST(test_entry_stacks_pop_n_without_values_frees_dropped_items);
+    RUN_TEST(test_int_fixed_stack_stays_inline_and_rejects_overflow);
+    RUN_TEST(test_entry_fixed_stack_free_releases_items);
     return UNITY_END();
 }
@@ -0,0 +1,233 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+
+#include "../work_stealing_deque.h"
+#include "test_common.h"
+
+shlDeclareWorkStealingDeque(IntDeque, int)
+shlDefineWorkStealingDeque(IntDeque, int)
+shlDeclareWorkStealingDeque(PtrDeque, int*)
+shlDefineWorkStealingDeque(PtrDeque, int*)
+
+#define THIEF_COUNT 4
+
+static int g_freeCount = 0;
+
+static void trackedFree(int* value)
+{
+    g_freeCount++;
+    free(value);
+}
+
+typedef struct
+{
+    IntDeque* deque;
+    atomic_int* seen;
+    atomic_llong* sum;
+    atomic_int* taken;
+    int total;
+} StealContext;
+
+static void takeValue(StealContext* context, int value)
+{
+    atomic_fetch_add(&context->seen[value], 1);
+    atomic_fetch_add(context->sum, value);
+    atomic_fetch_add(context->taken, 1);
+}
+
+static void* thief(void* arg)
+{
+    StealContext* context = (StealContext*)arg;
+    int value;
+
+    while (atomic_load(context->taken) < context->total)
+    {
+        if (IntDequeSteal(context->deque, &value))
+            takeValue(context, value);
+        else
+            sched_yield();
+    }
+
+    return NULL;
+}
+
+void test_work_stealing_deque_pop_is_lifo_and_steal_is_fifo(void)
+{
+    IntDeque deque;
+    IntDequeInit(&deque, (IntDequeOptions){ .capacity = 8 });
+
+    int value = -1;
+    TEST_ASSERT_FALSE(IntDequePop(&deque, &value));
+    TEST_ASSERT_FALSE(IntDequeSteal(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(-1, value);
+
+    for (int i = 0; i < 6; i++)
+    {
+        IntDequePush(&deque, i);
+    }
+
+    TEST_ASSERT_EQUAL_INT(6, IntDequeCount(&deque));
+
+    TEST_ASSERT_TRUE(IntDequePop(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(5, value);
+    TEST_ASSERT_TRUE(IntDequeSteal(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(0, value);
+    TEST_ASSERT_TRUE(IntDequeSteal(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(1, value);
+    TEST_ASSERT_TRUE(IntDequePop(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(4, value);
+    TEST_ASSERT_TRUE(IntDequePop(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(3, value);
+    TEST_ASSERT_TRUE(IntDequeSteal(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(2, value);
+
+    TEST_ASSERT_FALSE(IntDequePop(&deque, &value));
+    TEST_ASSERT_FALSE(IntDequeSteal(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(0, IntDequeCount(&deque));
+
+    IntDequeFree(&deque);
+}
+
+void test_work_stealing_deque_grows_while_wrapped(void)
+{
+    IntDeque deque;
+    IntDequeInit(&deque, (IntDequeOptions){ .capacity = 4 });
+
+    int value;
+    int stolen = 0;
+    for (int i = 0; i < 3; i++)
+    {
+        IntDequePush(&deque, i);
+    }
+    for (int round = 0; round < 10; round++)
+    {
+        IntDequePush(&deque, 3 + round);
+        TEST_ASSERT_TRUE(IntDequeSteal(&deque, &value));
+        TEST_ASSERT_EQUAL_INT(stolen++, value);
+    }
+
+    for (int i = 13; i < 100; i++)
+    {
+        IntDequePush(&deque, i);
+    }
+
+    TEST_ASSERT_EQUAL_INT(90, IntDequeCount(&deque));
+    TEST_ASSERT_TRUE(IntDequeSteal(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(stolen, value);
+
+    for (int i = 99; i > stolen; i--)
+    {
+        TEST_ASSERT_TRUE(IntDequePop(&deque, &value));
+        TEST_ASSERT_EQUAL_INT(i, value);
+    }
+
+    TEST_ASSERT_FALSE(IntDequePop(&deque, &value));
+    IntDequeFree(&deque);
+}
+
+void test_work_stealing_deque_free_releases_queued_items(void)
+{
+    PtrDeque deque;
+    PtrDequeInit(&deque, (PtrDequeOptions){ .capacity = 2, .freeFn = trackedFree });
+
+    for (int i = 0; i < 7; i++)
+    {
+        int* value = (int*)malloc(sizeof(int));
+        TEST_ASSERT_NOT_NULL(value);
+        *value = i;
+        PtrDequePush(&deque, value);
+    }
+
+    int* value = NULL;
+    TEST_ASSERT_TRUE(PtrDequeSteal(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(0, *value);
+    free(value);
+    TEST_ASSERT_TRUE(PtrDequePop(&deque, &value));
+    TEST_ASSERT_EQUAL_INT(6, *value);
+    free(value);
+
+    PtrDequeFree(&deque);
+    TEST_ASSERT_EQUAL_INT(5, g_freeCount);
+}
+
+void test_work_stealing_deque_stress_takes_every_item_once(void)
+{
+    const int total = SHL_TEST_STRESS_COUNT * 4;
+    IntDeque deque;
+    IntDequeInit(&deque, (IntDequeOptions){ .capacity = 2 });
+
+    atomic_int* seen = (atomic_int*)malloc((size_t)total * sizeof(atomic_int));
+    TEST_ASSERT_NOT_NULL(seen);
+    for (int i = 0; i < total; i++)
+    {
+        atomic_init(&seen[i], 0);
+    }
+
+    atomic_llong sum;
+    atomic_int taken;
+    atomic_init(&sum, 0);
+    atomic_init(&taken, 0);
+
+    StealContext context = { &deque, seen, &sum, &taken, total };
+    pthread_t thieves[THIEF_COUNT];
+
+    for (int i = 0; i < THIEF_COUNT; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(0, pthread_create(&thieves[i], NULL, thief, &context));
+    }
+
+    int value;
+    for (int i = 0; i < total; i++)
+    {
+        IntDequePush(&deque, i);
+
+        if (i % 3 == 0 && IntDequePop(&deque, &value))
+            takeValue(&context, value);
+    }
+
+    while (atomic_load(&taken) < total)
+    {
+        if (IntDequePop(&deque, &value))
+            takeValue(&context, value);
+        else
+            sched_yield();
+    }
+
+    for (int i = 0; i < THIEF_COUNT; i++)
+    {
+        pthread_join(thieves[i], NULL);
+    }
+
+    TEST_ASSERT_EQUAL_INT(total, atomic_load(&taken));
+    TEST_ASSERT_EQUAL_INT64((long long)total * (total - 1) / 2, atomic_load(&sum));
+    for (int i = 0; i < total; i++)
+    {
+        TEST_ASSERT_EQUAL_INT(1, atomic_load(&seen[i]));
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, IntDequeCount(&deque));
+    free(seen);
+    IntDequeFree(&deque);
+}
+
+void setUp(void)
+{
+    g_freeCount = 0;
+}
+
+void tearDown(void)
+{
+}
+
+int main(void)
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_work_stealing_deque_pop_is_lifo_and_steal_is_fifo);
+    RUN_TEST(test_work_stealing_deque_grows_while_wrapped);
+    RUN_TEST(test_work_stealing_deque_free_releases_queued_items);
+    RUN_TEST(test_work_stealing_deque_stress_takes_every_item_once);
+    return UNITY_END();
+}
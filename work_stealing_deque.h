@@ -0,0 +1,221 @@
+/*
+    work_stealing_deque.h - acoto87 (acoto87@gmail.com)
+
+    MIT License
+
+    Copyright (c) 2018 Alejandro Coto Gutiérrez
+
+    Permission is hereby granted, free of charge, to any person obtaining a copy
+    of this software and associated documentation files (the "Software"), to deal
+    in the Software without restriction, including without limitation the rights
+    to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+    copies of the Software, and to permit persons to whom the Software is
+    furnished to do so, subject to the following conditions:
+
+    The above copyright notice and this permission notice shall be included in all
+    copies or substantial portions of the Software.
+
+    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+    SOFTWARE.
+
+    Single-header macro library to declare and define strongly typed,
+    lock-free work-stealing deques for job systems.
+
+    USAGE
+    Declare a deque type with shlDeclareWorkStealingDeque(name, type), then
+    define it once with shlDefineWorkStealingDeque(name, type) in a C source
+    file. Requires C11 atomics.
+
+    CUSTOMISATION
+    Provide the initial capacity, which is rounded up to a power of two, and
+    an optional free function used by Free to release items still queued.
+    Values are stored by copy, so small types such as pointers or indices
+    work best.
+
+    NOTES
+    This is the Chase-Lev deque in the C11 formulation of Le, Pop, Cohen and
+    Zappa Nardelli. The owner thread calls Push and Pop on the bottom end in
+    LIFO order, and any other thread calls Steal on the top end in FIFO
+    order, claiming the item with a compare-and-swap on top. When the
+    circular storage is full the owner copies the items to a buffer twice as
+    large, keeping their logical indices. Thieves may still be reading the
+    old buffer, so it is retired instead of freed and released by Free.
+    Steal returns false both when the deque is empty and when it loses a
+    race with another thread. Items are copied with plain loads so any item
+    type works; a thief that read a slot the owner was reusing always loses
+    its compare-and-swap and discards the copy, although race detectors will
+    still report that read. Init and Free are not thread-safe.
+*/
+
+#ifndef SHL_WORK_STEALING_DEQUE_H
+#define SHL_WORK_STEALING_DEQUE_H
+
+#include <stdatomic.h>
+
+#include "shl_internal.h"
+
+#define SHL__WORK_STEALING_DEQUE_DEFAULT_CAPACITY 256
+
+#define shlDeclareWorkStealingDeque(typeName, itemType) \
+    typedef struct \
+    { \
+        int32_t capacity; \
+        void (*freeFn)(itemType item); \
+    } typeName ## Options; \
+    \
+    typedef struct typeName ## __Buffer \
+    { \
+        int64_t capacity; \
+        int64_t mask; \
+        struct typeName ## __Buffer* retired; \
+        itemType items[]; \
+    } typeName ## __Buffer; \
+    \
+    typedef struct \
+    { \
+        _Alignas(SHL__CACHE_LINE_SIZE) _Atomic int64_t top; \
+        _Alignas(SHL__CACHE_LINE_SIZE) _Atomic int64_t bottom; \
+        _Atomic(typeName ## __Buffer*) buffer; \
+        void (*freeFn)(itemType item); \
+    } typeName; \
+    \
+    void typeName ## Init(typeName* deque, typeName ## Options options); \
+    void typeName ## Free(typeName* deque); \
+    void typeName ## Push(typeName* deque, itemType value); \
+    bool typeName ## Pop(typeName* deque, itemType* value); \
+    bool typeName ## Steal(typeName* deque, itemType* value); \
+    int32_t typeName ## Count(typeName* deque);
+
+#define shlDefineWorkStealingDeque(typeName, itemType) \
+    typeName ## __Buffer* typeName ## __newBuffer(int64_t capacity) \
+    { \
+        typeName ## __Buffer* buffer = (typeName ## __Buffer *)SHL_MALLOC(sizeof(typeName ## __Buffer) + (size_t)capacity * sizeof(itemType)); \
+        buffer->capacity = capacity; \
+        buffer->mask = capacity - 1; \
+        buffer->retired = 0; \
+        return buffer; \
+    } \
+    \
+    typeName ## __Buffer* typeName ## __grow(typeName* deque, typeName ## __Buffer* buffer, int64_t top, int64_t bottom) \
+    { \
+        typeName ## __Buffer* newBuffer = typeName ## __newBuffer(buffer->capacity * 2); \
+        \
+        for(int64_t i = top; i < bottom; i++) \
+            newBuffer->items[i & newBuffer->mask] = buffer->items[i & buffer->mask]; \
+        \
+        newBuffer->retired = buffer; \
+        atomic_store_explicit(&deque->buffer, newBuffer, memory_order_release); \
+        return newBuffer; \
+    } \
+    \
+    void typeName ## Init(typeName* deque, typeName ## Options options) \
+    { \
+        int32_t capacity = options.capacity > 0 ? options.capacity : SHL__WORK_STEALING_DEQUE_DEFAULT_CAPACITY; \
+        \
+        deque->freeFn = options.freeFn; \
+        atomic_init(&deque->top, 0); \
+        atomic_init(&deque->bottom, 0); \
+        atomic_init(&deque->buffer, typeName ## __newBuffer(shl__nextPowerOfTwo(capacity))); \
+    } \
+    \
+    void typeName ## Free(typeName* deque) \
+    { \
+        typeName ## __Buffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed); \
+        \
+        if (!buffer) \
+            return; \
+        \
+        if (deque->freeFn) \
+        { \
+            int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed); \
+            int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed); \
+            \
+            for(int64_t i = top; i < bottom; i++) \
+                deque->freeFn(buffer->items[i & buffer->mask]); \
+        } \
+        \
+        while (buffer) \
+        { \
+            typeName ## __Buffer* retired = buffer->retired; \
+            SHL_FREE(buffer); \
+            buffer = retired; \
+        } \
+        \
+        atomic_store_explicit(&deque->buffer, 0, memory_order_relaxed); \
+        atomic_store_explicit(&deque->top, 0, memory_order_relaxed); \
+        atomic_store_explicit(&deque->bottom, 0, memory_order_relaxed); \
+    } \
+    \
+    void typeName ## Push(typeName* deque, itemType value) \
+    { \
+        int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed); \
+        int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire); \
+        typeName ## __Buffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed); \
+        \
+        if (bottom - top > buffer->mask) \
+            buffer = typeName ## __grow(deque, buffer, top, bottom); \
+        \
+        buffer->items[bottom & buffer->mask] = value; \
+        atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_release); \
+    } \
+    \
+    bool typeName ## Pop(typeName* deque, itemType* value) \
+    { \
+        int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_relaxed) - 1; \
+        typeName ## __Buffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_relaxed); \
+        atomic_store_explicit(&deque->bottom, bottom, memory_order_relaxed); \
+        atomic_thread_fence(memory_order_seq_cst); \
+        int64_t top = atomic_load_explicit(&deque->top, memory_order_relaxed); \
+        \
+        if (top > bottom) \
+        { \
+            atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed); \
+            return false; \
+        } \
+        \
+        itemType item = buffer->items[bottom & buffer->mask]; \
+        \
+        if (top == bottom) \
+        { \
+            bool won = atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed); \
+            atomic_store_explicit(&deque->bottom, bottom + 1, memory_order_relaxed); \
+            if (!won) \
+                return false; \
+        } \
+        \
+        *value = item; \
+        return true; \
+    } \
+    \
+    bool typeName ## Steal(typeName* deque, itemType* value) \
+    { \
+        int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire); \
+        atomic_thread_fence(memory_order_seq_cst); \
+        int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire); \
+        \
+        if (top >= bottom) \
+            return false; \
+        \
+        typeName ## __Buffer* buffer = atomic_load_explicit(&deque->buffer, memory_order_acquire); \
+        itemType item = buffer->items[top & buffer->mask]; \
+        \
+        if (!atomic_compare_exchange_strong_explicit(&deque->top, &top, top + 1, memory_order_seq_cst, memory_order_relaxed)) \
+            return false; \
+        \
+        *value = item; \
+        return true; \
+    } \
+    \
+    int32_t typeName ## Count(typeName* deque) \
+    { \
+        int64_t top = atomic_load_explicit(&deque->top, memory_order_acquire); \
+        int64_t bottom = atomic_load_explicit(&deque->bottom, memory_order_acquire); \
+        return bottom > top ? (int32_t)(bottom - top) : 0; \
+    }
+
+#endif // SHL_WORK_STEALING_DEQUE_H